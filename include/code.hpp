@@ -28,12 +28,36 @@
 #ifndef _CODE_HPP
 #define _CODE_HPP
 
+#include "code/alphabetic_tree.hpp"
 #include "code/binary.hpp"
+#include "code/bit_feed.hpp"
+#include "code/checkpoint.hpp"
+#include "code/bwt_compressor.hpp"
+#include "code/dense_vocabulary.hpp"
 #include "code/elias_gamma.hpp"
 #include "code/elias_delta.hpp"
+#include "code/elias_fano.hpp"
+#include "code/enumerative.hpp"
+#include "code/file_bit_sink.hpp"
+#include "code/file_bit_source.hpp"
+#include "code/front_coded_dictionary.hpp"
+#include "code/gap_bit_vector.hpp"
+#include "code/golomb_coded_set.hpp"
+#include "code/gorilla.hpp"
+#include "code/group_varint.hpp"
 #include "code/huffman.hpp"
+#include "code/inflate.hpp"
+#include "code/lz77.hpp"
+#include "code/move_to_front.hpp"
+#include "code/posting_list.hpp"
+#include "code/prefix_varint.hpp"
 #include "code/rice.hpp"
+#include "code/rrr_vector.hpp"
+#include "code/tunstall.hpp"
 #include "code/unary.hpp"
 #include "code/vbyte.hpp"
+#include "code/webgraph.hpp"
+#include "code/zero_run_length.hpp"
+#include "code/zeta.hpp"
 
 #endif
@@ -0,0 +1,215 @@
+/**
+ * code/alphabetic_tree.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_ALPHABETIC_TREE_HPP
+#define _CODE_ALPHABETIC_TREE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "huffman_tree.hpp"
+
+namespace code {
+
+/**
+ * \brief An optimal alphabetic code tree
+ * 
+ * In an alphabetic code tree, the leaves represent the characters in ascending order from left to right.
+ * Consequently, the lexicographic order of the codewords, read as bit strings starting with the first bit
+ * (i.e., the lowest bit of \ref code::HuffmanCode::word "HuffmanCode::word"), matches the order of the characters.
+ * This makes it possible to compare encoded characters without decoding them.
+ * 
+ * The tree is constructed using the Garsia-Wachs algorithm, which yields a tree of minimum cost among all alphabetic trees.
+ * The cost is never less than that of a Huffman tree, but it exceeds it by at most two bits per character.
+ * Note that the construction takes quadratic time in the worst case with respect to the alphabet size.
+ * 
+ * Apart from the construction, an alphabetic tree behaves exactly like a \ref code::HuffmanTree "HuffmanTree", i.e.,
+ * it provides the same table and navigation interfaces and uses the same encoding.
+ * 
+ * \tparam Char the character type
+ */
+template<std::integral Char>
+class AlphabeticTree : public HuffmanTree<Char> {
+private:
+    using Node = typename HuffmanTree<Char>::Node;
+
+    using HuffmanTree<Char>::nodes_;
+    using HuffmanTree<Char>::root_;
+    using HuffmanTree<Char>::leaves_;
+
+    template<Histogram<Char> H>
+    void build_from_histogram(H const& histogram) {
+        // gather characters in ascending order
+        std::vector<std::pair<Char, size_t>> chars;
+        chars.reserve(histogram.size() + 1);
+        for(auto e : histogram) chars.emplace_back(e.first, e.second);
+        std::sort(chars.begin(), chars.end());
+
+        if(chars.empty()) {
+            root_ = nullptr;
+            return;
+        }
+
+        // if the alphabet has exactly one character, we introduce a new character of zero frequency so we actually get a tree
+        if(chars.size() == 1) {
+            auto const c = chars[0].first;
+            if(c < std::numeric_limits<Char>::max()) {
+                chars.emplace_back(c + 1, 0);
+            } else {
+                chars.emplace(chars.begin(), c - 1, 0);
+            }
+        }
+
+        auto const n = chars.size();
+        auto const depths = garsia_wachs_depths(chars);
+
+        // construct the alphabetic tree with the computed leaf depths from left to right
+        nodes_.reserve(2 * n - 1);
+        leaves_.reserve(n);
+
+        std::vector<std::pair<Node*, size_t>> stack;
+        for(size_t i = 0; i < n; i++) {
+            nodes_.emplace_back(chars[i].first, chars[i].second);
+            auto* pnode = &nodes_.back();
+            leaves_.emplace(chars[i].first, pnode);
+            stack.emplace_back(pnode, depths[i]);
+
+            // merge siblings
+            while(stack.size() >= 2 && stack[stack.size() - 1].second == stack[stack.size() - 2].second) {
+                auto const [r, depth] = stack.back();
+                stack.pop_back();
+                auto* l = stack.back().first;
+                stack.pop_back();
+
+                nodes_.emplace_back(*l, *r);
+                stack.emplace_back(&nodes_.back(), depth - 1);
+            }
+        }
+
+        assert(stack.size() == 1 && stack.back().second == 0);
+        root_ = stack.back().first;
+    }
+
+    static std::vector<size_t> garsia_wachs_depths(std::vector<std::pair<Char, size_t>> const& chars) {
+        // phase 1: combine nodes according to Garsia and Wachs
+        // the resulting tree is not alphabetic, but its leaf depths are those of an optimal alphabetic tree
+        auto const n = chars.size();
+
+        std::vector<size_t> parent(2 * n - 1);
+        std::vector<std::pair<size_t, size_t>> work; // (weight, node)
+        work.reserve(n);
+        for(size_t i = 0; i < n; i++) work.emplace_back(chars[i].second, i);
+
+        size_t next = n;
+        size_t k = 1;
+        while(work.size() > 1) {
+            // find the leftmost pair (k-1, k) such that the weight of k-1 does not exceed the weight of k+1
+            while(k + 1 < work.size() && work[k - 1].first > work[k + 1].first) ++k;
+
+            // combine k-1 and k
+            auto const x = next++;
+            auto const w = work[k - 1].first + work[k].first;
+            parent[work[k - 1].second] = x;
+            parent[work[k].second] = x;
+            work.erase(work.begin() + (k - 1), work.begin() + (k + 1));
+
+            // move the new node to the left, behind the nearest node with a greater or equal weight
+            size_t j = k - 1;
+            while(j > 0 && work[j - 1].first < w) --j;
+            work.emplace(work.begin() + j, w, x);
+
+            // nb: the condition cannot be satisfied left of the new node's predecessor, so we continue scanning there
+            k = std::max(j, size_t(2)) - 1;
+        }
+
+        // phase 2: compute leaf depths
+        auto const root = work[0].second;
+        std::vector<size_t> depth(2 * n - 1, 0);
+        for(size_t v = root; v-- > 0;) {
+            depth[v] = depth[parent[v]] + 1; // nb: parents always have larger indices than their children
+        }
+        return std::vector<size_t>(depth.begin(), depth.begin() + n);
+    }
+
+public:
+    /**
+     * \brief Constructs an empty tree
+     */
+    AlphabeticTree() : HuffmanTree<Char>() {
+    }
+
+    AlphabeticTree(AlphabeticTree&&) = default;
+    AlphabeticTree& operator=(AlphabeticTree&&) = default;
+
+    AlphabeticTree(AlphabeticTree const&) = delete;
+    AlphabeticTree& operator=(AlphabeticTree const&) = delete;
+
+    /**
+     * \brief Constructs the optimal alphabetic tree for the given input
+     * 
+     * The input is scanned once and a histogram is built mapping input characters to their observed frequencies.
+     * 
+     * \tparam It the input iterator
+     * \param it the input
+     * \param end the end of the input
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, Char>
+    AlphabeticTree(It it, It const end) : HuffmanTree<Char>() {
+        build_from_histogram(Counter<Char>(it, end));
+    }
+
+    /**
+     * \brief Constructs the optimal alphabetic tree for the given input histogram
+     * 
+     * \tparam H the histogram type
+     * \param histogram the input histogram
+     */
+    template<Histogram<Char> H>
+    AlphabeticTree(H const& histogram) : HuffmanTree<Char>() {
+        build_from_histogram(histogram);
+    }
+
+    /**
+     * \brief Decodes an alphabetic tree from the given bit source
+     * 
+     * The tree must have been encoded using \ref encode in order for this function to be able to decode it.
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     */
+    template<BitSource Source>
+    AlphabeticTree(Source& src) : HuffmanTree<Char>(src) {
+    }
+};
+
+}
+
+#endif
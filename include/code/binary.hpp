@@ -28,7 +28,13 @@
 #ifndef _CODE_BINARY_HPP
 #define _CODE_BINARY_HPP
 
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+
+#include "bit_feed.hpp"
 #include "concepts.hpp"
+#include "internal/bits.hpp"
 
 namespace code {
 
@@ -42,14 +48,21 @@ public:
     /**
      * \brief Encodes an integer using binary code and the specified number of bits
      * 
+     * Integers wider than 64 bits are written in 64-bit words.
+     * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type
      * \param sink the bit sink
      * \param x the integer to encode
      * \param bits the number of bits
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, size_t bits) {
-        sink.write(x, bits);
+    template<BitSink Sink, internal::EncodableInteger Int>
+    inline static void encode(Sink& sink, Int const x, size_t bits) {
+        if constexpr(internal::WideUnsigned<Int>) {
+            internal::write_wide(sink, x, bits);
+        } else {
+            sink.write(uintmax_t(x), bits);
+        }
     }
 
     /**
@@ -59,26 +72,32 @@ public:
      * i.e., this function actually encodes the value of the integer relative to the universe's minimum.
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type of the universe
      * \param sink the bit sink
      * \param x the integer to encode
      * \param u the universe of \c x
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, Universe u) {
+    template<BitSink Sink, std::unsigned_integral Int>
+    inline static void encode(Sink& sink, std::type_identity_t<Int> x, BasicUniverse<Int> u) {
         encode(sink, u.rel(x), u.entropy());
     }
 
     /**
      * \brief Decodes an integer using binary code and the specified number of bits
      * 
+     * \tparam Int the integer type
      * \tparam Source the bit source type
      * \param src the bit sink
      * \param bits the number of bits
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, size_t bits) {
-        return src.read(bits);
+    template<std::unsigned_integral Int = uintmax_t, BitSource Source>
+    inline static Int decode(Source& src, size_t bits) {
+        if constexpr(internal::WideUnsigned<Int>) {
+            return internal::read_wide<Int>(src, bits);
+        } else {
+            return Int(src.read(bits));
+        }
     }
 
     /**
@@ -88,14 +107,73 @@ public:
      * i.e., this function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
      * 
      * \tparam Source the bit source type
+     * \tparam Int the integer type of the universe
      * \param src the bit source
      * \param u the universe of the integer to decode
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, Universe u) {
-        return u.abs(decode(src, u.entropy()));
+    template<BitSource Source, std::unsigned_integral Int>
+    inline static Int decode(Source& src, BasicUniverse<Int> u) {
+        return u.abs(decode<Int>(src, u.entropy()));
     }
+
+    /**
+     * \brief Resumable decoding of binary codes from input that arrives in chunks
+     * 
+     * The bits read so far are kept across calls.
+     */
+    class ResumableDecoder {
+    private:
+        size_t bits_;
+        size_t have_;
+        uintmax_t x_;
+
+    public:
+        /**
+         * \brief Constructs a decoder for the specified number of bits
+         * 
+         * \param bits the number of bits per codeword, at most 64
+         */
+        ResumableDecoder(size_t bits = 0) : bits_(bits), have_(0), x_(0) {
+        }
+
+        /**
+         * \brief Decodes an integer using binary code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed) {
+            auto const num = std::min(feed.available(), bits_ - have_);
+            if(num > 0) {
+                x_ |= feed.read(num) << have_;
+                have_ += num;
+            }
+            if(have_ < bits_) return std::nullopt;
+
+            auto const x = x_;
+            reset();
+            return x;
+        }
+
+        /**
+         * \brief Discards the partially decoded codeword
+         */
+        void reset() {
+            have_ = 0;
+            x_ = 0;
+        }
+
+        /**
+         * \brief Discards the partially decoded codeword and changes the number of bits per codeword
+         * 
+         * \param bits the number of bits per codeword, at most 64
+         */
+        void reset(size_t const bits) {
+            bits_ = bits;
+            reset();
+        }
+    };
 };
 
 }
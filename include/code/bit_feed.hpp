@@ -0,0 +1,187 @@
+/**
+ * code/bit_feed.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_BIT_FEED_HPP
+#define _CODE_BIT_FEED_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace code {
+
+/**
+ * \brief A queue of bits for decoding input that arrives in chunks
+ * 
+ * Chunks of input are appended using \ref push and consumed in LSBF order, i.e., the lowest bit of each byte is read first,
+ * which matches the bit order of sinks that write the lowest bit first.
+ * 
+ * Pull-based decoders, such as \ref code::EliasGamma::decode "EliasGamma::decode", may read from a feed directly if it is known
+ * that it holds enough bits for the next codeword. Otherwise, the resumable decoders of the individual codes
+ * (e.g., \ref code::EliasGamma::ResumableDecoder "EliasGamma::ResumableDecoder") consume as many bits as are available
+ * and keep the partially decoded codeword until more input is pushed.
+ * 
+ * This satisfies the \ref code::PeekableBitSource "PeekableBitSource" concept as long as no bits are read beyond \ref available.
+ */
+class BitFeed {
+private:
+    std::vector<uint64_t> words_;
+    size_t begin_; // the position of the next bit to read
+    size_t end_;   // the position after the last bit pushed
+
+    // discards the words that have been read entirely
+    void compact() {
+        auto const num = begin_ / 64;
+        if(num > 0 && 2 * num >= words_.size()) {
+            words_.erase(words_.begin(), words_.begin() + num);
+            begin_ -= 64 * num;
+            end_ -= 64 * num;
+        }
+    }
+
+    inline void append(uint64_t const bits, size_t const num) {
+        auto const w = end_ / 64;
+        auto const o = end_ % 64;
+        if(w + 1 >= words_.size()) words_.resize(w + 2, 0); // nb: keep a spare word so that peeking never reads out of bounds
+        words_[w] |= bits << o;
+        if(o + num > 64) words_[w + 1] |= bits >> (64 - o);
+        end_ += num;
+    }
+
+public:
+    /**
+     * \brief Constructs an empty feed
+     */
+    inline BitFeed() : begin_(0), end_(0) {
+    }
+
+    /**
+     * \brief Appends a chunk of input bytes
+     * 
+     * \param data the bytes
+     * \param num the number of bytes
+     */
+    void push(uint8_t const* data, size_t num) {
+        compact();
+        words_.reserve((end_ + 8 * num) / 64 + 2);
+        while(num >= 8) {
+            uint64_t w;
+            std::memcpy(&w, data, 8); // nb: assuming little endian
+            append(w, 64);
+            data += 8;
+            num -= 8;
+        }
+        while(num--) append(*data++, 8);
+    }
+
+    /**
+     * \brief Appends bits
+     * 
+     * \param bits the bits, where the lowest bit is appended first
+     * \param num the number of bits, at most 64
+     */
+    inline void push_bits(uint64_t bits, size_t const num) {
+        assert(num <= 64);
+        if(num == 0) return;
+        if(num < 64) bits &= (uint64_t(1) << num) - 1;
+        compact();
+        append(bits, num);
+    }
+
+    /**
+     * \brief Reports the number of bits that have been pushed but not yet read
+     * 
+     * \return the number of available bits
+     */
+    inline size_t available() const { return end_ - begin_; }
+
+    /**
+     * \brief Reads a single bit
+     * 
+     * \return the bit read
+     */
+    inline bool read() {
+        assert(available() > 0);
+        bool const b = (words_[begin_ / 64] >> (begin_ % 64)) & 1;
+        ++begin_;
+        return b;
+    }
+
+    /**
+     * \brief Reads the given number of bits without advancing
+     * 
+     * \param num the number of bits to read, at most 64 and at most \ref available
+     * \return the bits, where the first bit is the lowest bit
+     */
+    inline uint64_t peek(size_t const num) const {
+        assert(num <= 64 && num <= available());
+        if(num == 0) return 0;
+
+        auto const w = begin_ / 64;
+        auto const o = begin_ % 64;
+        uint64_t bits = words_[w] >> o;
+        if(o + num > 64) bits |= words_[w + 1] << (64 - o);
+        return num < 64 ? (bits & ((uint64_t(1) << num) - 1)) : bits;
+    }
+
+    /**
+     * \brief Advances by the given number of bits
+     * 
+     * \param num the number of bits to skip, at most \ref available
+     */
+    inline void skip(size_t const num) {
+        assert(num <= available());
+        begin_ += num;
+    }
+
+    /**
+     * \brief Reads the given number of bits
+     * 
+     * \param num the number of bits to read, at most 64 and at most \ref available
+     * \return the bits, where the first bit is the lowest bit
+     */
+    inline uint64_t read(size_t const num) {
+        auto const bits = peek(num);
+        skip(num);
+        return bits;
+    }
+
+    /**
+     * \brief Discards all bits
+     */
+    inline void clear() {
+        words_.clear();
+        begin_ = 0;
+        end_ = 0;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * code/bwt.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_BWT_HPP
+#define _CODE_BWT_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "internal/sais.hpp"
+
+namespace code {
+
+/**
+ * \brief The Burrows-Wheeler transform (BWT) of byte strings
+ * 
+ * The BWT of a string is defined via its suffix array, i.e., the input is implicitly terminated by a unique sentinel that is smaller than all bytes.
+ * The output contains the byte preceding each suffix in lexicographic order of the suffixes, omitting the sentinel.
+ * The position of the sentinel, the \e primary index, must be passed to the inverse transform.
+ * 
+ * The suffix array is computed in linear time using the SA-IS algorithm.
+ * The inverse transform computes the successor of each row in a single pass of counting sort and then follows these successors,
+ * storing each row's first character along with its successor so that each step takes only one random memory access.
+ */
+class BWT {
+private:
+    template<typename Entry>
+    static void inverse(uint8_t const* in, size_t const n, size_t const primary, uint8_t* out) {
+        // compute the starting row of each character in the sorted rows (nb: row zero starts with the sentinel)
+        size_t start[256] = {};
+        for(size_t i = 0; i < n; i++) ++start[in[i]];
+
+        size_t sum = 1;
+        for(size_t c = 0; c < 256; c++) {
+            auto const count = start[c];
+            start[c] = sum;
+            sum += count;
+        }
+
+        // compute successor rows, storing the first character of each row in the low byte
+        // nb: row i + 1 of the virtual sentinel-including BWT corresponds to position i of the input if i >= primary
+        std::vector<Entry> next(n + 1);
+        next[0] = Entry(primary) << 8;
+        for(size_t i = 0; i < n; i++) {
+            auto const c = in[i];
+            auto const row = i < primary ? i : i + 1;
+            next[start[c]++] = (Entry(row) << 8) | c;
+        }
+
+        // follow successors starting from the row of the entire input
+        size_t row = primary;
+        for(size_t i = 0; i < n; i++) {
+            auto const e = next[row];
+            out[i] = uint8_t(e);
+            row = size_t(e >> 8);
+        }
+    }
+
+public:
+    /**
+     * \brief Computes the BWT of the given input
+     * 
+     * \param in the input
+     * \param n the length of the input, which must be less than \c 2^31
+     * \param out the output, which must have space for \c n bytes and must not overlap with the input
+     * \return the primary index
+     */
+    static size_t forward(uint8_t const* in, size_t const n, uint8_t* out) {
+        if(n == 0) return 0;
+
+        auto const sa = internal::sais(in, n, 256);
+
+        // nb: the sentinel-including BWT has n + 1 rows, the first of which is the sentinel suffix preceded by the last byte
+        *out++ = in[n - 1];
+        size_t primary = 0;
+        for(size_t k = 0; k < n; k++) {
+            if(sa[k] == 0) {
+                primary = k + 1;
+            } else {
+                *out++ = in[sa[k] - 1];
+            }
+        }
+        return primary;
+    }
+
+    /**
+     * \brief Computes the inverse BWT
+     * 
+     * \param in the BWT
+     * \param n the length of the BWT
+     * \param primary the primary index reported by \ref forward
+     * \param out the output, which must have space for \c n bytes and must not overlap with the input
+     */
+    static void inverse(uint8_t const* in, size_t const n, size_t const primary, uint8_t* out) {
+        if(n == 0) return;
+        assert(primary >= 1 && primary <= n);
+
+        // nb: we pack row numbers together with characters, so we use 32-bit entries if possible
+        if(n < (size_t(1) << 24)) {
+            inverse<uint32_t>(in, n, primary, out);
+        } else {
+            inverse<uint64_t>(in, n, primary, out);
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * code/bwt_compressor.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_BWT_COMPRESSOR_HPP
+#define _CODE_BWT_COMPRESSOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "binary.hpp"
+#include "bwt.hpp"
+#include "concepts.hpp"
+#include "elias_delta.hpp"
+#include "huffman.hpp"
+#include "move_to_front.hpp"
+#include "zero_run_length.hpp"
+
+namespace code {
+
+/**
+ * \brief Parameters of the BWT compressor
+ */
+struct BWTOptions {
+    /**
+     * \brief The size of the blocks that are transformed independently
+     * 
+     * Larger blocks generally improve compression, but require more memory per thread (about five times the block size for the transform).
+     */
+    size_t block_size = 1 << 20;
+
+    /**
+     * \brief The maximum number of blocks that are transformed in parallel
+     * 
+     * If zero, the number of hardware threads is used.
+     */
+    size_t threads = 0;
+};
+
+/**
+ * \brief Block-sorting compression using the Burrows-Wheeler transform
+ * 
+ * The input is divided into blocks, each of which is transformed using the \ref code::BWT "BWT", followed by the
+ * \ref code::MoveToFront "MoveToFront" transform and \ref code::ZeroRunLength "ZeroRunLength" coding.
+ * The resulting symbols are encoded using a \ref code::HuffmanTree "HuffmanTree" per block.
+ * 
+ * The transforms of multiple blocks are computed in parallel, while the entropy coding into the bit sink is done sequentially.
+ * Similarly, the decoder reads multiple blocks sequentially and then inverts their transforms in parallel.
+ * 
+ * Each block is preceded by a 1-bit, followed by its length, its BWT primary index, the number of symbols, the Huffman tree and the symbols.
+ * The end of the compressed data is marked by a 0-bit.
+ */
+class BWTCompressor {
+private:
+    struct Block {
+        size_t length;
+        size_t primary;
+        std::vector<uint16_t> symbols;
+    };
+
+    static size_t num_threads(BWTOptions const& options) {
+        return options.threads ? options.threads : std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // runs the given function for the given number of tasks, using at most the given number of threads
+    template<typename F>
+    static void parallel(size_t const num_tasks, F f) {
+        if(num_tasks == 1) {
+            f(0);
+        } else {
+            std::vector<std::thread> threads;
+            threads.reserve(num_tasks);
+            for(size_t i = 0; i < num_tasks; i++) threads.emplace_back(f, i);
+            for(auto& t : threads) t.join();
+        }
+    }
+
+    static void transform(uint8_t const* in, size_t const n, Block& block) {
+        std::vector<uint8_t> buffer(n);
+        block.length = n;
+        block.primary = BWT::forward(in, n, buffer.data());
+
+        MoveToFront().encode(buffer.data(), n, buffer.data());
+
+        block.symbols.clear();
+        ZeroRunLength::encode(buffer.data(), n, std::back_inserter(block.symbols));
+    }
+
+    static void inverse(Block const& block, uint8_t* out) {
+        std::vector<uint8_t> buffer;
+        buffer.reserve(block.length);
+        ZeroRunLength::decode(block.symbols.data(), block.symbols.size(), std::back_inserter(buffer));
+        assert(buffer.size() == block.length);
+
+        MoveToFront().decode(buffer.data(), buffer.size(), buffer.data());
+        BWT::inverse(buffer.data(), buffer.size(), block.primary, out);
+    }
+
+public:
+    /**
+     * \brief Compresses the given input
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param in the input
+     * \param num the length of the input
+     * \param options the compression parameters
+     */
+    template<BitSink Sink>
+    static void encode(Sink& sink, uint8_t const* in, size_t const num, BWTOptions const& options = BWTOptions()) {
+        assert(options.block_size > 0 && options.block_size < (size_t(1) << 31));
+
+        auto const threads = num_threads(options);
+        std::vector<Block> blocks(threads);
+
+        for(size_t offset = 0; offset < num;) {
+            // transform a batch of blocks in parallel
+            auto const batch = std::min(threads, (num - offset + options.block_size - 1) / options.block_size);
+            parallel(batch, [&](size_t const i){
+                auto const begin = offset + i * options.block_size;
+                transform(in + begin, std::min(options.block_size, num - begin), blocks[i]);
+            });
+            offset = std::min(num, offset + batch * options.block_size);
+
+            // entropy code sequentially
+            for(size_t i = 0; i < batch; i++) {
+                auto const& block = blocks[i];
+                sink.write(1);
+                EliasDelta::encode(sink, block.length, Universe::umax());
+                Binary::encode(sink, block.primary, Universe(0, block.length));
+                EliasDelta::encode(sink, block.symbols.size(), Universe::umax());
+
+                HuffmanTree<uint16_t> tree(block.symbols.begin(), block.symbols.end());
+                tree.encode(sink);
+                Huffman::encode_bulk(sink, block.symbols.data(), block.symbols.size(), tree.packed_table());
+            }
+        }
+        sink.write(0);
+    }
+
+    /**
+     * \brief Decompresses data that has been compressed using \ref encode
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param out the output vector, to which the decompressed data is appended
+     * \param options the decompression parameters; only the number of threads is considered
+     */
+    template<BitSource Source>
+    static void decode(Source& src, std::vector<uint8_t>& out, BWTOptions const& options = BWTOptions()) {
+        auto const threads = num_threads(options);
+        std::vector<Block> blocks(threads);
+
+        bool more = src.read();
+        while(more) {
+            // entropy decode a batch of blocks sequentially
+            size_t batch = 0;
+            size_t total = 0;
+            while(more && batch < threads) {
+                auto& block = blocks[batch++];
+                block.length = EliasDelta::decode(src, Universe::umax());
+                block.primary = Binary::decode(src, Universe(0, block.length));
+
+                auto const num_symbols = EliasDelta::decode(src, Universe::umax());
+                HuffmanTree<uint16_t> tree(src);
+                block.symbols.resize(num_symbols);
+                for(auto& x : block.symbols) x = uint16_t(Huffman::decode(src, tree.root()));
+
+                total += block.length;
+                more = src.read();
+            }
+
+            // invert transforms in parallel
+            auto const offset = out.size();
+            out.resize(offset + total);
+            parallel(batch, [&](size_t const i){
+                size_t begin = offset;
+                for(size_t j = 0; j < i; j++) begin += blocks[j].length;
+                inverse(blocks[i], out.data() + begin);
+            });
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,287 @@
+/**
+ * code/canonical_huffman.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_CANONICAL_HUFFMAN_HPP
+#define _CODE_CANONICAL_HUFFMAN_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "concepts.hpp"
+#include "huffman_code.hpp"
+
+namespace code {
+
+/**
+ * \brief Construction of canonical Huffman codes from codeword lengths
+ * 
+ * In a canonical Huffman code, the codewords are fully determined by their lengths: codewords of the same length are
+ * consecutive integers assigned in order of the symbols, and shorter codewords numerically precede longer ones.
+ * This is the representation used, e.g., by DEFLATE, where only the codeword lengths are transmitted.
+ * 
+ * Canonical codewords are defined with the first bit being the most significant one.
+ * The codes returned by this class are bit-reversed so that they follow the LSBF convention of \ref code::HuffmanCode "HuffmanCode",
+ * i.e., the first bit of a codeword is its lowest bit.
+ */
+class CanonicalHuffman {
+public:
+    /**
+     * \brief Reverses the order of the lowest bits of an integer
+     * 
+     * \param x the integer
+     * \param num the number of low bits to reverse
+     * \return the lowest \c num bits of \c x in reverse order
+     */
+    inline static constexpr uintmax_t reverse(uintmax_t x, size_t const num) {
+        uintmax_t r = 0;
+        for(size_t i = 0; i < num; i++) {
+            r = (r << 1) | (x & 1);
+            x >>= 1;
+        }
+        return r;
+    }
+
+    /**
+     * \brief Computes the canonical Huffman codes for the given codeword lengths
+     * 
+     * Symbols with a codeword length of zero are not represented and receive an empty code.
+     * The lengths must satisfy the Kraft inequality.
+     * 
+     * \tparam It the length iterator type
+     * \param begin the codeword length of symbol zero
+     * \param end the end of the codeword lengths
+     * \return the codes in LSBF order, indexed by symbol
+     */
+    template<std::forward_iterator It>
+    static std::vector<HuffmanCode> codes(It const begin, It const end) {
+        // count the number of codewords of each length
+        std::vector<uintmax_t> count;
+        for(auto it = begin; it != end; ++it) {
+            size_t const len = *it;
+            if(len >= count.size()) count.resize(len + 1, 0);
+            ++count[len];
+        }
+        if(count.empty()) return {};
+
+        // compute the first codeword of each length
+        std::vector<uintmax_t> next(count.size(), 0);
+        uintmax_t code = 0;
+        for(size_t len = 1; len < count.size(); len++) {
+            code = (code + count[len - 1] * (len > 1)) << 1;
+            next[len] = code;
+        }
+
+        // assign codewords
+        std::vector<HuffmanCode> codes;
+        for(auto it = begin; it != end; ++it) {
+            size_t const len = *it;
+            codes.push_back(len ? HuffmanCode { reverse(next[len]++, len), len } : HuffmanCode { 0, 0 });
+        }
+        return codes;
+    }
+};
+
+/**
+ * \brief A table-driven decoder for canonical Huffman codes
+ * 
+ * The decoder consists of a primary table indexed by the next few bits of the input, which immediately yields
+ * the symbol and codeword length for short codewords.
+ * For longer codewords, the primary table entry links to a secondary table indexed by the subsequent bits.
+ * Hence, every symbol is decoded using at most two table lookups.
+ * 
+ * The code may be incomplete, in which case bit sequences that do not correspond to a codeword are reported as invalid.
+ * 
+ * \see code::CanonicalHuffman
+ */
+class CanonicalHuffmanDecoder {
+public:
+    /**
+     * \brief The symbol reported for invalid bit sequences
+     */
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+private:
+    struct Entry {
+        uint32_t value;   // the symbol, or the offset of the secondary table
+        uint8_t length;   // the codeword length, or zero
+        uint8_t sub_bits; // the number of bits indexing the secondary table, or zero for symbols
+    };
+
+    std::vector<Entry> table_;
+    size_t primary_bits_;
+    size_t max_length_;
+    bool valid_;
+    bool complete_;
+
+public:
+    /**
+     * \brief Constructs an empty decoder, which reports any input as invalid
+     */
+    CanonicalHuffmanDecoder() : table_(1, Entry { 0, 0, 0 }), primary_bits_(0), max_length_(0), valid_(true), complete_(false) {
+    }
+
+    /**
+     * \brief Constructs a decoder for the canonical Huffman code with the given codeword lengths
+     * 
+     * If the lengths violate the Kraft inequality, the decoder is \ref valid "invalid" and reports any input as invalid.
+     * 
+     * \tparam It the length iterator type
+     * \param begin the codeword length of symbol zero
+     * \param end the end of the codeword lengths
+     * \param primary_bits the number of bits indexing the primary table
+     */
+    template<std::forward_iterator It>
+    CanonicalHuffmanDecoder(It const begin, It const end, size_t const primary_bits = 9) : CanonicalHuffmanDecoder() {
+        // verify Kraft inequality
+        std::vector<uintmax_t> count;
+        for(auto it = begin; it != end; ++it) {
+            size_t const len = *it;
+            if(len >= count.size()) count.resize(len + 1, 0);
+            ++count[len];
+        }
+
+        max_length_ = count.empty() ? 0 : count.size() - 1;
+        assert(max_length_ < 64);
+
+        intmax_t left = 1;
+        for(size_t len = 1; len <= max_length_; len++) {
+            left = 2 * left - intmax_t(count[len]);
+            if(left < 0) {
+                valid_ = false;
+                max_length_ = 0;
+                return;
+            }
+        }
+        complete_ = max_length_ > 0 && left == 0;
+        if(max_length_ == 0) return;
+
+        // fill primary table
+        auto const codes = CanonicalHuffman::codes(begin, end);
+        primary_bits_ = std::min(primary_bits, max_length_);
+        uintmax_t const primary_mask = (uintmax_t(1) << primary_bits_) - 1;
+        table_.assign(size_t(1) << primary_bits_, Entry { 0, 0, 0 });
+
+        for(uint32_t c = 0; c < codes.size(); c++) {
+            auto const len = codes[c].length;
+            if(len > 0 && len <= primary_bits_) {
+                for(auto i = codes[c].word; i < table_.size(); i += uintmax_t(1) << len) {
+                    table_[i] = Entry { c, uint8_t(len), 0 };
+                }
+            }
+        }
+
+        if(max_length_ > primary_bits_) {
+            // determine the sizes of the secondary tables
+            std::vector<uint8_t> sub_bits(table_.size(), 0);
+            for(auto const& code : codes) {
+                if(code.length > primary_bits_) {
+                    auto& b = sub_bits[code.word & primary_mask];
+                    b = std::max(b, uint8_t(code.length - primary_bits_));
+                }
+            }
+
+            // allocate secondary tables
+            for(size_t i = 0; i < sub_bits.size(); i++) {
+                if(sub_bits[i]) {
+                    auto const offset = table_.size();
+                    table_.resize(offset + (size_t(1) << sub_bits[i]), Entry { 0, 0, 0 });
+                    table_[i] = Entry { uint32_t(offset), 0, sub_bits[i] };
+                }
+            }
+
+            // fill secondary tables
+            for(uint32_t c = 0; c < codes.size(); c++) {
+                auto const len = codes[c].length;
+                if(len > primary_bits_) {
+                    auto const link = table_[codes[c].word & primary_mask];
+                    for(auto i = codes[c].word >> primary_bits_; i < (uintmax_t(1) << link.sub_bits); i += uintmax_t(1) << (len - primary_bits_)) {
+                        table_[link.value + i] = Entry { c, uint8_t(len), 0 };
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Reports whether the codeword lengths satisfy the Kraft inequality
+     * 
+     * \return true if the code is valid, false if it is over-subscribed
+     */
+    bool valid() const { return valid_; }
+
+    /**
+     * \brief Reports whether every sufficiently long bit sequence starts with a codeword
+     * 
+     * \return true if the code is complete, false otherwise
+     */
+    bool complete() const { return complete_; }
+
+    /**
+     * \brief Reports the maximum codeword length
+     * 
+     * \return the maximum codeword length, which is also the number of bits needed to decode any symbol
+     */
+    size_t max_length() const { return max_length_; }
+
+    /**
+     * \brief Looks up the symbol encoded at the beginning of the given bits
+     * 
+     * \param bits the upcoming input bits in LSBF order, containing at least \ref max_length bits
+     * \return the decoded symbol and the length of its codeword, which is zero if the bits do not start with a valid codeword
+     */
+    inline std::pair<uint32_t, size_t> lookup(uintmax_t const bits) const {
+        auto e = table_[bits & ((uintmax_t(1) << primary_bits_) - 1)];
+        if(e.sub_bits) {
+            e = table_[e.value + ((bits >> primary_bits_) & ((uintmax_t(1) << e.sub_bits) - 1))];
+        }
+        return { e.value, e.length };
+    }
+
+    /**
+     * \brief Decodes a symbol from the given bit source
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \return the decoded symbol, or \ref INVALID if the input does not start with a valid codeword
+     */
+    template<PeekableBitSource Source>
+    inline uint32_t decode(Source& src) const {
+        auto const [c, len] = lookup(src.peek(max_length_));
+        if(!len) return INVALID;
+        src.skip(len);
+        return c;
+    }
+};
+
+}
+
+#endif
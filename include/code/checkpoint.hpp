@@ -0,0 +1,148 @@
+/**
+ * code/checkpoint.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_CHECKPOINT_HPP
+#define _CODE_CHECKPOINT_HPP
+
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <vector>
+
+#include "binary.hpp"
+#include "concepts.hpp"
+#include "elias_delta.hpp"
+
+namespace code {
+
+/**
+ * \brief Concept for decoders whose state can be saved and restored
+ * 
+ * In order to satisfy this concept, the type must provide
+ * * a function `save_state` that appends the decoder's state to a vector of 64-bit words, and
+ * * a function `load_state` that restores the decoder's state from a pointer to such words and advances the pointer past them.
+ * 
+ * \tparam T the type
+ */
+template<typename T>
+concept Checkpointable =
+    requires(T const subject, std::vector<uint64_t>& state) {
+        { subject.save_state(state) };
+    } && requires(T subject, uint64_t const*& state) {
+        { subject.load_state(state) };
+    };
+
+/**
+ * \brief A snapshot of a decoding process, consisting of the position in the bit source and the state of the involved decoders
+ * 
+ * A checkpoint is taken using \ref make_checkpoint and restored using \ref restore_checkpoint, which repositions a
+ * \ref code::SeekableBitSource "SeekableBitSource" and restores the state of the given \ref code::Checkpointable "Checkpointable" decoders.
+ * For stateless codes, such as \ref code::EliasGamma "EliasGamma", the position suffices.
+ * 
+ * Checkpoints can be serialized using \ref encode and \ref decode, e.g., so that a consumer can resume decoding an append-only stream after a restart.
+ */
+struct Checkpoint {
+    /// \brief The position in the bit source
+    uint64_t pos = 0;
+
+    /// \brief The state of the decoders in the order they were passed to \ref make_checkpoint
+    std::vector<uint64_t> state;
+
+    /**
+     * \brief Encodes the checkpoint to the given bit sink
+     * 
+     * The position and the number of state words are encoded using \ref code::EliasDelta "EliasDelta" codes, followed by the state words in binary.
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     */
+    template<BitSink Sink>
+    void encode(Sink& sink) const {
+        EliasDelta::encode(sink, pos, Universe::umax());
+        EliasDelta::encode(sink, state.size(), Universe::umax());
+        for(auto const w : state) Binary::encode(sink, w, 64);
+    }
+
+    /**
+     * \brief Decodes a checkpoint from the given bit source
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \return the decoded checkpoint
+     */
+    template<BitSource Source>
+    static Checkpoint decode(Source& src) {
+        Checkpoint cp;
+        cp.pos = (uint64_t)EliasDelta::decode(src, Universe::umax());
+        auto const num = (size_t)EliasDelta::decode(src, Universe::umax());
+        cp.state.reserve(num);
+        for(size_t i = 0; i < num; i++) cp.state.push_back((uint64_t)Binary::decode(src, 64));
+        return cp;
+    }
+
+    bool operator==(Checkpoint const&) const = default;
+};
+
+/**
+ * \brief Takes a checkpoint of a decoding process
+ * 
+ * \tparam Source the bit source type
+ * \tparam Decoders the decoder types
+ * \param src the bit source
+ * \param decoders the decoders whose state to save
+ * \return the checkpoint
+ */
+template<SeekableBitSource Source, Checkpointable... Decoders>
+Checkpoint make_checkpoint(Source const& src, Decoders const&... decoders) {
+    Checkpoint cp;
+    cp.pos = (uint64_t)src.pos();
+    (decoders.save_state(cp.state), ...);
+    return cp;
+}
+
+/**
+ * \brief Restores a decoding process from a checkpoint
+ * 
+ * The decoders must be given in the same order as to \ref make_checkpoint.
+ * 
+ * \tparam Source the bit source type
+ * \tparam Decoders the decoder types
+ * \param cp the checkpoint
+ * \param src the bit source, which is repositioned to the checkpoint's position
+ * \param decoders the decoders whose state to restore
+ */
+template<SeekableBitSource Source, Checkpointable... Decoders>
+void restore_checkpoint(Checkpoint const& cp, Source& src, Decoders&... decoders) {
+    src.seek(cp.pos);
+    auto const* state = cp.state.data();
+    (decoders.load_state(state), ...);
+    assert(state == cp.state.data() + cp.state.size());
+}
+
+}
+
+#endif
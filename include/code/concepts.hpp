@@ -83,6 +83,46 @@ concept BitSource =
         { subject.read(num) } -> std::unsigned_integral;
     };
 
+/**
+ * \brief Concept for bit sources that allow looking ahead
+ * 
+ * In addition to the requirements of a \ref code::BitSource "BitSource", the type must provide two functions:
+ * * `peek` to retrieve a given number of upcoming bits without extracting them, and
+ * * `skip` to extract and discard a given number of bits
+ * 
+ * Bits are peeked in the same order as they would be read, i.e., the next bit is the lowest bit of the result.
+ * Peeking beyond the end of the source yields zero bits.
+ * 
+ * \tparam T the type
+ */
+template<typename T>
+concept PeekableBitSource =
+    BitSource<T> &&
+    requires(T subject, size_t num) {
+        { subject.peek(num) } -> std::unsigned_integral;
+        { subject.skip(num) };
+    };
+
+/**
+ * \brief Concept for bit sources that allow repositioning
+ * 
+ * In addition to the requirements of a \ref code::BitSource "BitSource", the type must provide two functions:
+ * * `pos` to retrieve the current position, i.e., the number of bits from the beginning of the source, and
+ * * `seek` to continue reading at a given position
+ * 
+ * This makes it possible to resume decoding at a previously recorded position, e.g., using a \ref code::Checkpoint "Checkpoint".
+ * 
+ * \tparam T the type
+ */
+template<typename T>
+concept SeekableBitSource =
+    BitSource<T> &&
+    requires(T const subject) {
+        { subject.pos() } -> std::unsigned_integral;
+    } && requires(T subject, uint64_t pos) {
+        { subject.seek(pos) };
+    };
+
 /// \cond INTERNAL
 struct SomeBitSink {
     inline void flush() { }
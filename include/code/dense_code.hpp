@@ -0,0 +1,244 @@
+/**
+ * code/dense_code.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_DENSE_CODE_HPP
+#define _CODE_DENSE_CODE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace code {
+
+/**
+ * \brief (s,c)-Dense Code encoding and decoding of ranks over byte buffers
+ * 
+ * (s,c)-Dense Codes are byte-oriented codes, where the byte values are partitioned into \c s \e stoppers (values less than \c s)
+ * and \c c=256-s \e continuers (the remaining values).
+ * A codeword consists of zero or more continuers followed by exactly one stopper, i.e., the end of a codeword is recognized by looking at a single byte.
+ * The \c s smallest ranks are encoded using a single byte, the next <tt>s*c</tt> ranks are encoded using two bytes, and so on.
+ * Ranks should thus be assigned to symbols in order of decreasing frequency (see \ref code::DenseVocabulary "DenseVocabulary").
+ * 
+ * The End-Tagged Dense Code (ETDC) is the special case where <tt>s=c=128</tt>, in which the highest bit of each byte tells whether it ends a codeword.
+ * 
+ * Since codeword boundaries are marked by stoppers, a codeword can be searched directly in an encoded byte sequence:
+ * a match is valid if and only if it starts at the beginning of the sequence or is preceded by a stopper.
+ */
+class DenseCode {
+private:
+    uint16_t s_, c_;
+
+public:
+    /**
+     * \brief Constructs the End-Tagged Dense Code, which uses 128 stoppers and 128 continuers
+     * 
+     * \return the End-Tagged Dense Code
+     */
+    inline static constexpr DenseCode end_tagged() { return DenseCode(128); }
+
+    /**
+     * \brief Computes the (s,c)-Dense Code that minimizes the encoding size for the given symbol frequencies
+     * 
+     * Every possible choice of \c s is tested, each in time logarithmic in the number of symbols.
+     * 
+     * \tparam It the frequency iterator type
+     * \param begin the frequency of the symbol of rank zero
+     * \param end the end of the frequencies
+     * \return the optimal (s,c)-Dense Code for the given frequencies, which must be sorted in non-increasing order
+     */
+    template<std::input_iterator It>
+    static DenseCode optimal(It begin, It const end) {
+        // compute prefix sums of frequencies
+        std::vector<uintmax_t> prefix;
+        prefix.push_back(0);
+        while(begin != end) {
+            prefix.push_back(prefix.back() + *begin++);
+        }
+
+        auto const n = prefix.size() - 1;
+        if(n <= 255) return DenseCode(255); // nb: any number of stoppers that allows encoding all symbols using one byte is optimal
+
+        // test all possible numbers of stoppers
+        uint16_t best_s = 128;
+        uintmax_t best_cost = UINTMAX_MAX;
+        for(uint16_t s = 1; s < 256; s++) {
+            uintmax_t const c = 256 - s;
+
+            // sum up the frequencies of the symbols with codewords of length 1, 2, ...
+            uintmax_t cost = 0;
+            size_t lo = 0;
+            uintmax_t num = s; // the number of codewords of the current length
+            for(size_t len = 1; lo < n && cost < best_cost; len++) {
+                auto const hi = num < n - lo ? lo + num : n;
+                cost += len * (prefix[hi] - prefix[lo]);
+                lo = hi;
+                num = num < n ? num * c : num; // nb: avoid overflow
+            }
+
+            if(cost < best_cost) {
+                best_s = s;
+                best_cost = cost;
+            }
+        }
+        return DenseCode(best_s);
+    }
+
+    /**
+     * \brief Constructs an (s,c)-Dense Code
+     * 
+     * \param s the number of stoppers, which must be between 1 and 255
+     */
+    inline constexpr DenseCode(uint16_t const s) : s_(s), c_(256 - s) {
+        assert(s >= 1 && s <= 255);
+    }
+
+    /**
+     * \brief Reports the number of stoppers
+     * 
+     * \return the number of stoppers \c s
+     */
+    inline constexpr uint16_t stoppers() const { return s_; }
+
+    /**
+     * \brief Reports the number of continuers
+     * 
+     * \return the number of continuers \c c
+     */
+    inline constexpr uint16_t continuers() const { return c_; }
+
+    /**
+     * \brief Tests whether the given byte ends a codeword
+     * 
+     * \param b the byte in question
+     * \return true if the byte is a stopper, false if it is a continuer
+     */
+    inline constexpr bool is_stopper(uint8_t const b) const { return b < s_; }
+
+    /**
+     * \brief Computes the length of the codeword for the given rank
+     * 
+     * \param rank the rank
+     * \return the length of the codeword in bytes
+     */
+    inline constexpr size_t length(uintmax_t const rank) const {
+        size_t len = 1;
+        for(auto q = rank / s_; q; q = (q - 1) / c_) ++len;
+        return len;
+    }
+
+    /**
+     * \brief Encodes a rank
+     * 
+     * \param out the output buffer, which must have space for \ref length "length(rank)" bytes
+     * \param rank the rank to encode
+     * \return a pointer to the first byte following the codeword
+     */
+    inline uint8_t* encode(uint8_t* const out, uintmax_t const rank) const {
+        if(rank < s_) {
+            *out = (uint8_t)rank;
+            return out + 1;
+        }
+
+        // the codeword is written from back to front
+        auto* const end = out + length(rank);
+        auto* p = end;
+        *--p = (uint8_t)(rank % s_);
+        for(auto q = rank / s_; q; q /= c_) {
+            --q;
+            *--p = (uint8_t)(s_ + q % c_);
+        }
+        assert(p == out);
+        return end;
+    }
+
+    /**
+     * \brief Decodes a rank
+     * 
+     * \param in the input buffer, which is advanced to the first byte following the codeword
+     * \return the decoded rank
+     */
+    inline uintmax_t decode(uint8_t const*& in) const {
+        uintmax_t q = 0;
+        uint8_t b;
+        while((b = *in++) >= s_) {
+            q = q * c_ + (b - s_) + 1;
+        }
+        return q * s_ + b;
+    }
+
+    /**
+     * \brief Encodes a sequence of ranks
+     * 
+     * \tparam It the input iterator type
+     * \param out the output buffer, which must have sufficient space
+     * \param begin the first rank to encode
+     * \param end the end of the ranks to encode
+     * \return a pointer to the first byte following the encoded ranks
+     */
+    template<std::input_iterator It>
+    uint8_t* encode_bulk(uint8_t* out, It begin, It const end) const {
+        while(begin != end) {
+            uintmax_t const rank = *begin++;
+            if(rank < s_) {
+                *out++ = (uint8_t)rank;
+            } else {
+                out = encode(out, rank);
+            }
+        }
+        return out;
+    }
+
+    /**
+     * \brief Decodes a sequence of ranks
+     * 
+     * \tparam OutputIt the output iterator type
+     * \param in the input buffer
+     * \param out the output
+     * \param num the number of ranks to decode
+     * \return a pointer to the first byte following the decoded codewords
+     */
+    template<std::output_iterator<uintmax_t> OutputIt>
+    uint8_t const* decode_bulk(uint8_t const* in, OutputIt out, size_t num) const {
+        while(num--) {
+            // single-byte codewords are by far the most common
+            uint8_t const b = *in;
+            if(b < s_) {
+                *out++ = b;
+                ++in;
+            } else {
+                *out++ = decode(in);
+            }
+        }
+        return in;
+    }
+};
+
+}
+
+#endif
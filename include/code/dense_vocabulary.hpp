@@ -0,0 +1,311 @@
+/**
+ * code/dense_vocabulary.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_DENSE_VOCABULARY_HPP
+#define _CODE_DENSE_VOCABULARY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "binary.hpp"
+#include "concepts.hpp"
+#include "counter.hpp"
+#include "dense_code.hpp"
+#include "elias_delta.hpp"
+#include "range.hpp"
+
+namespace code {
+
+/**
+ * \brief A vocabulary for encoding symbols using (s,c)-Dense Codes
+ * 
+ * The vocabulary ranks the symbols by decreasing frequency and assigns them codewords of a \ref code::DenseCode "DenseCode" accordingly.
+ * Unless the End-Tagged Dense Code is requested, the number of stoppers is chosen such that the encoding size is minimized.
+ * 
+ * Encoding and decoding works on byte buffers only. This makes it particularly suitable for word-based text compression,
+ * where the symbols are word IDs: decoding is much faster than for bitwise codes like Huffman codes, and words can be
+ * searched directly in the encoded text (see \ref find).
+ * 
+ * \tparam Char the symbol type
+ */
+template<std::integral Char>
+class DenseVocabulary {
+private:
+    using UChar = std::make_unsigned_t<Char>;
+
+    DenseCode code_;
+    std::vector<Char> symbols_;
+    std::unordered_map<Char, uintmax_t> ranks_;
+
+    void assign_ranks() {
+        ranks_.clear();
+        ranks_.reserve(symbols_.size());
+        for(size_t i = 0; i < symbols_.size(); i++) {
+            ranks_.emplace(symbols_[i], i);
+        }
+    }
+
+    template<Histogram<Char> H>
+    void build_from_histogram(H const& histogram, bool const end_tagged) {
+        // rank symbols by decreasing frequency, breaking ties by the symbols themselves
+        std::vector<std::pair<Char, size_t>> entries;
+        entries.reserve(histogram.size());
+        for(auto e : histogram) entries.emplace_back(e.first, e.second);
+        std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b){
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        });
+
+        symbols_.reserve(entries.size());
+        for(auto const& e : entries) symbols_.push_back(e.first);
+        assign_ranks();
+
+        // determine code
+        if(!end_tagged) {
+            auto freqs = entries | std::views::transform([](auto const& e){ return e.second; });
+            code_ = DenseCode::optimal(freqs.begin(), freqs.end());
+        }
+    }
+
+public:
+    /**
+     * \brief Constructs an empty vocabulary using the End-Tagged Dense Code
+     */
+    DenseVocabulary() : code_(DenseCode::end_tagged()) {
+    }
+
+    DenseVocabulary(DenseVocabulary&&) = default;
+    DenseVocabulary& operator=(DenseVocabulary&&) = default;
+
+    DenseVocabulary(DenseVocabulary const&) = default;
+    DenseVocabulary& operator=(DenseVocabulary const&) = default;
+
+    /**
+     * \brief Constructs the vocabulary for the given input
+     * 
+     * The input is scanned once and a histogram is built mapping input symbols to their observed frequencies.
+     * 
+     * \tparam It the input iterator
+     * \param it the input
+     * \param end the end of the input
+     * \param end_tagged if true, the End-Tagged Dense Code is used instead of the optimal (s,c)-Dense Code
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, Char>
+    DenseVocabulary(It it, It const end, bool const end_tagged = false) : code_(DenseCode::end_tagged()) {
+        build_from_histogram(Counter<Char>(it, end), end_tagged);
+    }
+
+    /**
+     * \brief Constructs the vocabulary for the given histogram
+     * 
+     * \tparam H the histogram type
+     * \param histogram the input histogram
+     * \param end_tagged if true, the End-Tagged Dense Code is used instead of the optimal (s,c)-Dense Code
+     */
+    template<Histogram<Char> H>
+    DenseVocabulary(H const& histogram, bool const end_tagged = false) : code_(DenseCode::end_tagged()) {
+        build_from_histogram(histogram, end_tagged);
+    }
+
+    /**
+     * \brief Decodes a vocabulary from the given bit source
+     * 
+     * The vocabulary must have been encoded using \ref encode in order for this function to be able to decode it.
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     */
+    template<BitSource Source>
+    DenseVocabulary(Source& src) : code_(uint16_t(Binary::decode(src, Universe::with_entropy(8)) + 1)) {
+        auto const n = EliasDelta::decode(src, Universe::umax());
+        if(n) {
+            auto const min = EliasDelta::decode(src, Universe::umax());
+            auto const max = EliasDelta::decode(src, Universe::at_least(min));
+            Universe u(min, max);
+
+            symbols_.reserve(n);
+            for(size_t i = 0; i < n; i++) {
+                symbols_.push_back((Char)(UChar)Binary::decode(src, u));
+            }
+            assign_ranks();
+        }
+    }
+
+    /**
+     * \brief Encodes the vocabulary to the given bit sink
+     * 
+     * The encoding starts with the number of stoppers, followed by the number of symbols and the symbols in rank order,
+     * which are binary encoded relative to the universe they span.
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     */
+    template<BitSink Sink>
+    void encode(Sink& sink) const {
+        Binary::encode(sink, code_.stoppers() - 1, Universe::with_entropy(8));
+        EliasDelta::encode(sink, symbols_.size(), Universe::umax());
+        if(!symbols_.empty()) {
+            Range range;
+            for(auto const c : symbols_) range.contain((UChar)c);
+            Universe u(range);
+
+            EliasDelta::encode(sink, u.min(), Universe::umax());
+            EliasDelta::encode(sink, u.max(), Universe::at_least(u.min()));
+            for(auto const c : symbols_) {
+                Binary::encode(sink, (UChar)c, u);
+            }
+        }
+    }
+
+    /**
+     * \brief Reports the dense code used by the vocabulary
+     * 
+     * \return the dense code
+     */
+    DenseCode const& code() const { return code_; }
+
+    /**
+     * \brief Reports the number of symbols in the vocabulary
+     * 
+     * \return the number of symbols
+     */
+    size_t size() const { return symbols_.size(); }
+
+    /**
+     * \brief Reports the rank of the given symbol
+     * 
+     * \param c the symbol in question, which must be contained in the vocabulary
+     * \return the rank of the symbol
+     */
+    uintmax_t rank(Char const c) const {
+        auto it = ranks_.find(c);
+        assert(it != ranks_.end());
+        return it->second;
+    }
+
+    /**
+     * \brief Reports the symbol with the given rank
+     * 
+     * \param rank the rank in question
+     * \return the symbol with the given rank
+     */
+    Char symbol(uintmax_t const rank) const { return symbols_[rank]; }
+
+    /**
+     * \brief Encodes a symbol
+     * 
+     * \param out the output buffer, which must have sufficient space
+     * \param c the symbol to encode, which must be contained in the vocabulary
+     * \return a pointer to the first byte following the codeword
+     */
+    uint8_t* encode(uint8_t* const out, Char const c) const {
+        return code_.encode(out, rank(c));
+    }
+
+    /**
+     * \brief Decodes a symbol
+     * 
+     * \param in the input buffer, which is advanced to the first byte following the codeword
+     * \return the decoded symbol
+     */
+    Char decode(uint8_t const*& in) const {
+        return symbols_[code_.decode(in)];
+    }
+
+    /**
+     * \brief Encodes a sequence of symbols
+     * 
+     * \tparam It the input iterator type
+     * \param out the output buffer, which must have sufficient space
+     * \param begin the first symbol to encode
+     * \param end the end of the symbols to encode
+     * \return a pointer to the first byte following the encoded symbols
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, Char>
+    uint8_t* encode_bulk(uint8_t* out, It begin, It const end) const {
+        auto ranks = std::ranges::subrange(begin, end) | std::views::transform([this](Char const c){ return rank(c); });
+        return code_.encode_bulk(out, ranks.begin(), ranks.end());
+    }
+
+    /**
+     * \brief Decodes a sequence of symbols
+     * 
+     * \param in the input buffer
+     * \param out the output, which must have space for \c num symbols
+     * \param num the number of symbols to decode
+     * \return a pointer to the first byte following the decoded codewords
+     */
+    uint8_t const* decode_bulk(uint8_t const* in, Char* out, size_t num) const {
+        auto const s = code_.stoppers();
+        auto const* symbols = symbols_.data();
+        while(num--) {
+            // single-byte codewords are by far the most common
+            uint8_t const b = *in;
+            if(b < s) {
+                *out++ = symbols[b];
+                ++in;
+            } else {
+                *out++ = symbols[code_.decode(in)];
+            }
+        }
+        return in;
+    }
+
+    /**
+     * \brief Searches a symbol directly in an encoded byte sequence
+     * 
+     * The sequence is not decoded. Instead, the symbol's codeword is searched, and a match is only reported if it starts
+     * at the beginning of the sequence or is preceded by a stopper.
+     * 
+     * \param begin the beginning of the encoded sequence
+     * \param end the end of the encoded sequence
+     * \param c the symbol to search, which must be contained in the vocabulary
+     * \return a pointer to the first occurrence of the symbol's codeword, or \c end if there is none
+     */
+    uint8_t const* find(uint8_t const* const begin, uint8_t const* const end, Char const c) const {
+        std::vector<uint8_t> pattern(code_.length(rank(c)));
+        code_.encode(pattern.data(), rank(c));
+
+        auto it = begin;
+        while(true) {
+            it = std::search(it, end, pattern.begin(), pattern.end());
+            if(it == end || it == begin || code_.is_stopper(*(it - 1))) return it;
+            ++it;
+        }
+    }
+};
+
+}
+
+#endif
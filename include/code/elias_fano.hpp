@@ -0,0 +1,225 @@
+/**
+ * code/elias_fano.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_ELIAS_FANO_HPP
+#define _CODE_ELIAS_FANO_HPP
+
+#include <bit>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "binary.hpp"
+
+#include "internal/bit_buffer.hpp"
+
+namespace code {
+
+/**
+ * \brief The Elias-Fano representation of a non-decreasing sequence of integers
+ * 
+ * For a sequence of \c n integers from the universe <tt>[0, u]</tt>, each integer is split into its lowest <tt>l = floor(log2(u / n))</tt> bits,
+ * which are stored using \ref code::Binary "Binary" codes, and its remaining high bits, which are stored in unary as a bit vector with \c n set bits.
+ * The high bits are kept in a plain bit vector, which is about half full and would not benefit from compression.
+ * The positions of every \ref SELECT_SAMPLE -th set and unset bit are sampled, so that a select query scans only a few words from the nearest sample.
+ * In total, the representation takes less than <tt>2 + log2(u / n)</tt> bits per integer plus the overhead of the samples.
+ */
+class EliasFano {
+public:
+    /**
+     * \brief The number of set or unset bits between two samples used for select queries
+     */
+    static constexpr size_t SELECT_SAMPLE = 256;
+
+private:
+    size_t size_;
+    uint64_t universe_;
+    uint8_t low_bits_;
+    std::vector<uint64_t> low_;
+    std::vector<uint64_t> high_;
+    size_t high_size_;
+    std::vector<uint64_t> select1_;
+    std::vector<uint64_t> select0_;
+
+    inline uint64_t low(size_t const i) const {
+        return internal::BitBufferSource(low_.data(), i * low_bits_).read(low_bits_);
+    }
+
+    inline bool high(size_t const pos) const {
+        return (high_[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    // finds the position of the k-th set bit in the given word, counting from zero
+    inline static size_t select_in_word(uint64_t x, size_t const k) {
+        #ifdef __BMI2__
+        return (size_t)std::countr_zero(_pdep_u64(uint64_t(1) << k, x));
+        #else
+        for(size_t j = 0; j < k; j++) x &= x - 1;
+        return (size_t)std::countr_zero(x);
+        #endif
+    }
+
+    // finds the position of the k-th set (or unset) bit in the high bits, counting from zero
+    template<bool Bit>
+    size_t select(size_t const k) const {
+        auto const& samples = Bit ? select1_ : select0_;
+        auto const pos = samples[k / SELECT_SAMPLE];
+        auto r = k % SELECT_SAMPLE;
+
+        // scan words starting from the sample
+        auto w = pos / 64;
+        uint64_t x = (Bit ? high_[w] : ~high_[w]) & (UINT64_MAX << (pos % 64));
+        while(true) {
+            auto const c = (size_t)std::popcount(x);
+            if(r < c) return 64 * w + select_in_word(x, r);
+            r -= c;
+            ++w;
+            x = Bit ? high_[w] : ~high_[w];
+        }
+    }
+
+public:
+    /**
+     * \brief Constructs an empty sequence
+     */
+    EliasFano() : size_(0), universe_(0), low_bits_(0), high_size_(0) {
+    }
+
+    /**
+     * \brief Constructs the Elias-Fano representation of the given sequence
+     * 
+     * \tparam It the forward iterator type
+     * \param begin the first integer
+     * \param end the end of the integers, which must be non-decreasing
+     * \param universe the maximum integer, which must not be less than the last integer
+     */
+    template<std::forward_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, uint64_t>
+    EliasFano(It const begin, It const end, uint64_t const universe) : size_((size_t)std::distance(begin, end)), universe_(universe) {
+        low_bits_ = (size_ > 0 && universe / size_ > 0) ? (uint8_t)(std::bit_width(universe / size_) - 1) : 0;
+
+        auto const num_buckets = (universe >> low_bits_) + 1;
+        high_size_ = size_ + num_buckets;
+        high_.resize((high_size_ + 63) / 64, 0);
+
+        internal::BitBufferSink low(low_);
+        size_t i = 0;
+        [[maybe_unused]] uint64_t prev = 0; // nb: only used for asserting monotonicity
+        for(auto it = begin; it != end; ++it) {
+            uint64_t const x = *it;
+            assert(x >= prev && x <= universe);
+            Binary::encode(low, x, low_bits_);
+            prev = x;
+
+            auto const pos = (x >> low_bits_) + i;
+            high_[pos / 64] |= uint64_t(1) << (pos % 64);
+            if(i % SELECT_SAMPLE == 0) select1_.push_back(pos);
+            ++i;
+        }
+
+        // sample unset bits
+        size_t zeros = 0;
+        for(size_t w = 0; w < high_.size(); w++) {
+            auto x = ~high_[w];
+            if(w + 1 == high_.size() && high_size_ % 64) x &= (uint64_t(1) << (high_size_ % 64)) - 1;
+
+            auto const c = (size_t)std::popcount(x);
+            for(auto k = (SELECT_SAMPLE - zeros % SELECT_SAMPLE) % SELECT_SAMPLE; k < c; k += SELECT_SAMPLE) {
+                select0_.push_back(64 * w + select_in_word(x, k));
+            }
+            zeros += c;
+        }
+    }
+
+    /**
+     * \brief Reports the number of integers
+     * 
+     * \return the number of integers
+     */
+    inline size_t size() const { return size_; }
+
+    /**
+     * \brief Reports the maximum integer that can be represented
+     * 
+     * \return the universe's maximum
+     */
+    inline uint64_t universe() const { return universe_; }
+
+    /**
+     * \brief Reports the integer at the given position
+     * 
+     * \param i the position, less than \ref size
+     * \return the integer at position \c i
+     */
+    inline uint64_t operator[](size_t const i) const {
+        assert(i < size_);
+        return (uint64_t(select<true>(i) - i) << low_bits_) | low(i);
+    }
+
+    /**
+     * \brief Finds the first integer that is greater than or equal to the given value
+     * 
+     * The bucket of the value's high bits is located using a select query on the unset bits,
+     * and only the low bits of the integers within that bucket are scanned.
+     * 
+     * \param x the value, at most \ref universe
+     * \return the position of the first integer greater than or equal to \c x, or \ref size if there is none
+     */
+    size_t lower_bound(uint64_t const x) const {
+        assert(x <= universe_);
+        auto const h = x >> low_bits_;
+        auto const l = x & ((uint64_t(1) << low_bits_) - 1);
+
+        // the bucket h starts after the h-th unset bit, and the number of integers in preceding buckets equals the number of set bits before it
+        size_t pos = h ? select<false>(h - 1) + 1 : 0;
+        size_t i = pos - h;
+
+        // nb: integers in subsequent buckets are greater than x
+        while(pos < high_size_ && high(pos) && low(i) < l) {
+            ++pos;
+            ++i;
+        }
+        return i;
+    }
+
+    /**
+     * \brief Reports the total size of the representation in bits
+     * 
+     * \return the size in bits
+     */
+    inline size_t size_in_bits() const {
+        return 64 * (low_.size() + high_.size() + select1_.size() + select0_.size());
+    }
+};
+
+}
+
+#endif
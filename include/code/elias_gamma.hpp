@@ -30,11 +30,17 @@
 
 #include <cassert>
 #include <bit>
+#include <limits>
+#include <optional>
+#include <type_traits>
 
 #include "unary.hpp"
 #include "binary.hpp"
+#include "bit_feed.hpp"
 
 #include "internal/bits.hpp"
+#include "internal/universal_bulk.hpp"
+#include "internal/word_packer.hpp"
 
 namespace code {
 
@@ -54,45 +60,90 @@ public:
      * Beware that the gamma code for zero is not defined, and trying to encode zero using this function causes undefined behaviour!
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type
      * \param sink the bit sink
      * \param x the integer to encode
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x) {
-        assert(x > 0);
-        auto const m = std::bit_width(x) - 1;
+    template<BitSink Sink, internal::EncodableInteger Int>
+    inline static void encode(Sink& sink, Int const x) {
+        internal::encoded_t<Int> const v = x;
+        assert(v > 0);
+        auto const m = (size_t)std::bit_width(v) - 1;
         Unary::encode(sink, m);
-        if(m) Binary::encode(sink, x, m); // cut off leading 1-bit
+        if(m) Binary::encode(sink, v, m); // cut off leading 1-bit
     }
 
     /**
      * \brief Encodes an integer from the given universe using gamma code
      * 
      * This function actually encodes one plus the value of the integer relative to the universe's minimum.
-     * Note that therefore, trying to encode \c UINTMAX_MAX is undefined.
+     * Note that therefore, trying to encode the maximum value of the universe's integer type is undefined.
+     * However, a universe of 128-bit integers can be used to encode any 64-bit integer.
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type of the universe
      * \param sink the bit sink
      * \param x the integer to encode
      * \param u the universe of \c x
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, Universe u) {
-        assert(u.rel(x) < UINTMAX_MAX); // nb: we CANNOT encode/decode the value UINTMAX_MAX -- shame on you if you were to do this using Elias codes anyway
-        encode(sink, u.rel(x) + 1);
+    template<BitSink Sink, std::unsigned_integral Int>
+    inline static void encode(Sink& sink, std::type_identity_t<Int> x, BasicUniverse<Int> u) {
+        assert(u.rel(x) < std::numeric_limits<Int>::max()); // nb: we CANNOT encode/decode the maximum value -- shame on you if you were to do this using Elias codes anyway
+        encode(sink, Int(u.rel(x) + 1));
+    }
+
+    /**
+     * \brief Encodes a sequence of integers using gamma code
+     * 
+     * Each codeword is formed as a whole in a register, and the codewords are merged into 64-bit words before being written to the sink.
+     * If AVX-512 (including the conflict detection instructions) is available, the bit widths and codewords of multiple integers
+     * are computed at once using vectorized leading zero counts; blocks containing codewords longer than 64 bits are encoded using scalar code.
+     * 
+     * The output is identical to that of calling \ref encode for each integer, provided that the sink's
+     * \c write(bits, num) writes the lowest bit first (as in iopp).
+     * Beware that zero cannot be encoded.
+     * 
+     * \tparam Sink the bit sink type
+     * \tparam Int the integer type
+     * \param sink the bit sink
+     * \param input the integers to encode
+     * \param num the number of integers to encode
+     */
+    template<BitSink Sink, std::unsigned_integral Int>
+    static void encode_bulk(Sink& sink, Int const* input, size_t const num) {
+        if constexpr(internal::WideUnsigned<Int>) {
+            // nb: codewords of wide integers may not fit into a register
+            for(size_t i = 0; i < num; i++) encode(sink, input[i]);
+            return;
+        }
+
+        internal::WordPacker<Sink> packer(sink);
+
+        size_t i = 0;
+        #if defined(__AVX512F__) && defined(__AVX512CD__)
+        if constexpr(sizeof(Int) == 4 || sizeof(Int) == 8) {
+            for(; i + internal::UNIVERSAL_AVX512_BLOCK <= num; i += internal::UNIVERSAL_AVX512_BLOCK) {
+                if(!internal::gamma_encode_avx512(packer, input + i)) {
+                    for(size_t j = i; j < i + internal::UNIVERSAL_AVX512_BLOCK; j++) internal::append_gamma(packer, input[j]);
+                }
+            }
+        }
+        #endif
+        for(; i < num; i++) internal::append_gamma(packer, input[i]);
     }
 
     /**
      * \brief Decodes an integer using gamma code
      * 
+     * \tparam Int the integer type
      * \tparam Source the bit source type
      * \param src the bit sink
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src) {
+    template<std::unsigned_integral Int = uintmax_t, BitSource Source>
+    inline static Int decode(Source& src) {
         auto const m = Unary::decode(src);
-        return m ? (internal::set_bit(m) | Binary::decode(src, m)) : 1;
+        return m ? ((Int(1) << m) | Binary::decode<Int>(src, m)) : Int(1);
     }
 
     /**
@@ -101,14 +152,79 @@ public:
      * This function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
      * 
      * \tparam Source the bit source type
+     * \tparam Int the integer type of the universe
      * \param src the bit source
      * \param u the universe of the integer to decode
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, Universe u) {
-        return u.abs(decode(src)) - 1;
+    template<BitSource Source, std::unsigned_integral Int>
+    inline static Int decode(Source& src, BasicUniverse<Int> u) {
+        return u.abs(decode<Int>(src)) - 1;
     }
+
+    /**
+     * \brief Resumable decoding of gamma codes from input that arrives in chunks
+     * 
+     * The unary prefix and the binary suffix are decoded by resumable decoders, so partial codewords are kept across calls.
+     */
+    class ResumableDecoder {
+    private:
+        Unary::ResumableDecoder unary_;
+        Binary::ResumableDecoder binary_;
+        uintmax_t m_;
+        bool suffix_;
+
+    public:
+        /**
+         * \brief Constructs a decoder in the initial state
+         */
+        ResumableDecoder() : m_(0), suffix_(false) {
+        }
+
+        /**
+         * \brief Decodes an integer using gamma code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed) {
+            if(!suffix_) {
+                auto const m = unary_.decode(feed);
+                if(!m) return std::nullopt;
+                if(*m == 0) return 1;
+
+                m_ = *m;
+                binary_.reset(m_);
+                suffix_ = true;
+            }
+
+            auto const low = binary_.decode(feed);
+            if(!low) return std::nullopt;
+
+            suffix_ = false;
+            return internal::set_bit(m_) | *low;
+        }
+
+        /**
+         * \brief Decodes an integer from the given universe using gamma code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \param u the universe of the integer to decode
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed, Universe u) {
+            auto const x = decode(feed);
+            return x ? std::optional<uintmax_t>(u.abs(*x) - 1) : std::nullopt;
+        }
+
+        /**
+         * \brief Discards the partially decoded codeword
+         */
+        void reset() {
+            unary_.reset();
+            suffix_ = false;
+        }
+    };
 };
 
 }
@@ -0,0 +1,339 @@
+/**
+ * code/enumerative.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_ENUMERATIVE_HPP
+#define _CODE_ENUMERATIVE_HPP
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "binary.hpp"
+#include "concepts.hpp"
+#include "universe.hpp"
+#include "internal/binomial.hpp"
+
+namespace code {
+
+/**
+ * \brief Enumerative encoding and decoding of fixed-weight bit patterns
+ * 
+ * A pattern of \c n bits with \c k set bits (its \em class) is represented by its \em offset, i.e., its rank among all such patterns
+ * in the combinatorial number system: if the j-th lowest set bit is at position \c p_j, the offset is the sum of <tt>binomial(p_j, j)</tt>.
+ * The offset is encoded using \ref code::Binary "Binary" code over the universe <tt>[0, binomial(n, k))</tt>, i.e., using <tt>ceil(log2(binomial(n, k)))</tt> bits,
+ * and if the class is not known to the decoder, it is encoded beforehand using \ref code::Binary "Binary" code over the universe <tt>[0, n]</tt>.
+ * Equivalently, a pattern represents a \c k -subset of a universe of \c n integers.
+ * 
+ * Offsets are computed using a precomputed table of binomial coefficients, so patterns must not have more than \ref MAX_BITS bits.
+ * Decoding an offset takes <tt>O(min(k, n-k) log n)</tt> time in general. For patterns of at most \ref MAX_TABLE_BITS bits, e.g., the blocks of an
+ * \ref code::RRRVector "RRRVector", a table of all patterns is used instead, which is computed on first use.
+ */
+class Enumerative {
+public:
+    /// \brief The maximum number of bits in a pattern
+    static constexpr size_t MAX_BITS = internal::BINOMIAL_MAX_N - 1;
+
+    /// \brief The maximum number of bits in a pattern for which offsets are decoded using a table
+    static constexpr size_t MAX_TABLE_BITS = 16;
+
+private:
+    template<size_t N>
+    class Table {
+    private:
+        std::array<size_t, N + 1> start_;
+        std::vector<uint16_t> patterns_;
+
+        Table() : patterns_(size_t(1) << N) {
+            size_t s = 0;
+            for(size_t k = 0; k <= N; k++) {
+                start_[k] = s;
+                s += internal::binomial(N, k);
+            }
+            for(uint64_t x = 0; x < (uint64_t(1) << N); x++) {
+                patterns_[start_[std::popcount(x)] + rank(x)] = uint16_t(x);
+            }
+        }
+
+    public:
+        static Table const& instance() {
+            static Table table;
+            return table;
+        }
+
+        inline uint64_t unrank(uint64_t const offset, size_t const k) const {
+            return patterns_[start_[k] + offset];
+        }
+    };
+
+    // the largest p less than n such that binomial(p, k) does not exceed the offset
+    static size_t find_position(uint64_t const offset, size_t n, size_t const k) {
+        size_t lo = k - 1; // nb: binomial(k - 1, k) is zero
+        while(lo + 1 < n) {
+            auto const mid = (lo + n) / 2;
+            if(internal::binomial(mid, k) <= offset) lo = mid; else n = mid;
+        }
+        return lo;
+    }
+
+    static uint64_t unrank_search(uint64_t offset, size_t n, size_t k) {
+        uint64_t bits = 0;
+        for(; k; k--) {
+            auto const p = find_position(offset, n, k);
+            bits |= uint64_t(1) << p;
+            offset -= internal::binomial(p, k);
+            n = p;
+        }
+        return bits;
+    }
+
+public:
+    /**
+     * \brief Reports the number of patterns of \c n bits with \c k set bits
+     * 
+     * \param n the number of bits
+     * \param k the number of set bits
+     * \return the binomial coefficient of \c n and \c k
+     */
+    static constexpr uint64_t num_patterns(size_t const n, size_t const k) {
+        assert(n <= MAX_BITS);
+        return internal::binomial(n, k);
+    }
+
+    /**
+     * \brief Reports the number of bits used to encode the offset of a pattern of \c n bits with \c k set bits
+     * 
+     * The patterns without any set bits and without any unset bits are unique and therefore have no encoded offset.
+     * 
+     * \param n the number of bits
+     * \param k the number of set bits
+     * \return the number of bits used to encode the offset
+     */
+    static constexpr uint8_t offset_bits(size_t const n, size_t const k) {
+        auto const num = num_patterns(n, k);
+        return num > 1 ? (uint8_t)std::bit_width(num - 1) : 0;
+    }
+
+    /**
+     * \brief Computes the offset of a bit pattern among all patterns of the same length and class
+     * 
+     * The offset does not depend on the length of the pattern.
+     * 
+     * \param bits the bit pattern
+     * \return the offset of the pattern
+     */
+    static constexpr uint64_t rank(uint64_t bits) {
+        uint64_t offset = 0;
+        for(size_t j = 1; bits; j++) {
+            offset += internal::binomial(std::countr_zero(bits), j);
+            bits &= bits - 1;
+        }
+        return offset;
+    }
+
+    /**
+     * \brief Computes the bit pattern with the given offset
+     * 
+     * \param offset the offset of the pattern, less than <tt>binomial(n, k)</tt>
+     * \param n the number of bits
+     * \param k the number of set bits
+     * \return the bit pattern
+     */
+    static uint64_t unrank(uint64_t const offset, size_t const n, size_t const k) {
+        assert(n <= MAX_BITS && k <= n);
+        assert(offset < num_patterns(n, k));
+
+        // nb: complementing the patterns reverses their order, so we can search for the fewer of the set or unset bits
+        if(2 * k <= n) {
+            return unrank_search(offset, n, k);
+        } else {
+            auto const mask = (uint64_t(1) << n) - 1;
+            return ~unrank_search(num_patterns(n, k) - 1 - offset, n, n - k) & mask;
+        }
+    }
+
+    /**
+     * \brief Computes the bit pattern with the given offset for a pattern length known at compile time
+     * 
+     * If the length does not exceed \ref MAX_TABLE_BITS, the pattern is looked up in a table.
+     * 
+     * \tparam N the number of bits
+     * \param offset the offset of the pattern, less than <tt>binomial(N, k)</tt>
+     * \param k the number of set bits
+     * \return the bit pattern
+     */
+    template<size_t N>
+    static uint64_t unrank(uint64_t const offset, size_t const k) {
+        static_assert(N <= MAX_BITS);
+        if constexpr(N <= MAX_TABLE_BITS) {
+            assert(k <= N && offset < num_patterns(N, k));
+            return Table<N>::instance().unrank(offset, k);
+        } else {
+            return unrank(offset, N, k);
+        }
+    }
+
+    /**
+     * \brief Encodes the offset of a bit pattern whose class is known to the decoder
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param bits the bit pattern
+     * \param n the number of bits
+     * \param k the number of set bits
+     */
+    template<BitSink Sink>
+    inline static void encode(Sink& sink, uint64_t const bits, size_t const n, size_t const k) {
+        assert(std::popcount(bits) == (int)k);
+        Binary::encode(sink, rank(bits), offset_bits(n, k));
+    }
+
+    /**
+     * \brief Encodes a bit pattern, consisting of its class and its offset
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param bits the bit pattern
+     * \param n the number of bits
+     */
+    template<BitSink Sink>
+    inline static void encode(Sink& sink, uint64_t const bits, size_t const n) {
+        assert(n <= MAX_BITS && (bits >> n) == 0);
+        auto const k = (size_t)std::popcount(bits);
+        Binary::encode(sink, k, Universe(0, n));
+        encode(sink, bits, n, k);
+    }
+
+    /**
+     * \brief Decodes a bit pattern whose class is known
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param n the number of bits
+     * \param k the number of set bits
+     * \return the bit pattern
+     */
+    template<BitSource Source>
+    inline static uint64_t decode(Source& src, size_t const n, size_t const k) {
+        return unrank((uint64_t)Binary::decode(src, offset_bits(n, k)), n, k);
+    }
+
+    /**
+     * \brief Decodes a bit pattern, consisting of its class and its offset
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param n the number of bits
+     * \return the bit pattern
+     */
+    template<BitSource Source>
+    inline static uint64_t decode(Source& src, size_t const n) {
+        auto const k = (size_t)Binary::decode(src, Universe(0, n));
+        return decode(src, n, k);
+    }
+
+    /**
+     * \brief Decodes a sequence of bit patterns of the same length, each consisting of its class and its offset
+     * 
+     * This is equivalent to decoding each pattern using \ref decode, but the length is known at compile time,
+     * so that patterns of at most \ref MAX_TABLE_BITS bits are looked up in a table.
+     * 
+     * \tparam N the number of bits per pattern
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param out the output, which must have space for \c num patterns
+     * \param num the number of patterns to decode
+     */
+    template<size_t N, BitSource Source>
+    static void decode_bulk(Source& src, uint64_t* out, size_t num) {
+        static_assert(N > 0 && N <= MAX_BITS);
+        constexpr size_t CLASS_BITS = Universe(0, N).entropy();
+        static constexpr auto OFFSET_BITS = [](){
+            std::array<uint8_t, N + 1> bits {};
+            for(size_t k = 0; k <= N; k++) bits[k] = offset_bits(N, k);
+            return bits;
+        }();
+
+        while(num--) {
+            auto const k = (size_t)src.read(CLASS_BITS);
+            auto const w = OFFSET_BITS[k];
+            *out++ = w ? unrank<N>(src.read(w), k) : (k ? (uint64_t(1) << N) - 1 : 0);
+        }
+    }
+
+    /**
+     * \brief Encodes a subset of a universe of at most \ref MAX_BITS integers
+     * 
+     * The subset is encoded as the bit pattern in which the bits of the contained integers, relative to the universe's minimum, are set.
+     * 
+     * \tparam Sink the bit sink type
+     * \tparam It the input iterator type
+     * \param sink the bit sink
+     * \param begin the beginning of the subset, which must not contain duplicates
+     * \param end the end of the subset
+     * \param u the universe
+     */
+    template<BitSink Sink, std::input_iterator It>
+    static void encode_subset(Sink& sink, It begin, It const end, Universe const u) {
+        assert(u.delta() < MAX_BITS);
+        uint64_t bits = 0;
+        while(begin != end) {
+            auto const x = u.rel(*begin++);
+            assert(x <= u.delta() && !(bits & (uint64_t(1) << x)));
+            bits |= uint64_t(1) << x;
+        }
+        encode(sink, bits, u.delta() + 1);
+    }
+
+    /**
+     * \brief Decodes a subset of a universe of at most \ref MAX_BITS integers
+     * 
+     * \tparam Source the bit source type
+     * \tparam Out the output iterator type
+     * \param src the bit source
+     * \param out the output, which receives the integers of the subset in ascending order
+     * \param u the universe
+     * \return the output iterator past the last decoded integer
+     */
+    template<BitSource Source, std::output_iterator<uintmax_t> Out>
+    static Out decode_subset(Source& src, Out out, Universe const u) {
+        assert(u.delta() < MAX_BITS);
+        auto bits = decode(src, u.delta() + 1);
+        while(bits) {
+            *out++ = u.abs(std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+        return out;
+    }
+};
+
+}
+
+#endif
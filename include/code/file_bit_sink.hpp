@@ -0,0 +1,232 @@
+/**
+ * code/file_bit_sink.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_FILE_BIT_SINK_HPP
+#define _CODE_FILE_BIT_SINK_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace code {
+
+/**
+ * \brief Parameters for writing files using a \ref code::FileBitSink "FileBitSink"
+ */
+struct FileBitSinkOptions {
+    /// \brief Whether to append to the encoded stream contained in the file rather than truncating it
+    bool append = false;
+
+    /// \brief The length of the encoded stream contained in the file in bits if appending
+    uint64_t num_bits = 0;
+
+    /// \brief The size of the write buffer in bytes
+    size_t buffer_size = 1 << 20;
+};
+
+/**
+ * \brief A bit sink that writes to a file, either from scratch or by appending to an existing encoded stream
+ * 
+ * Bits are written in LSBF order, matching the \ref code::FileBitSource "FileBitSource", and buffered in words before they are written to the file.
+ * The file always ends with the last byte that contains written bits.
+ * 
+ * In order to append to an existing stream, the sink is opened at the stream's length in bits, which must be stored alongside the file
+ * (e.g., reported by \ref num_bits_written when the stream was last written). The partial last word is restored from the file,
+ * so the stream is continued without rewriting it. Any model that is needed for encoding, such as a \ref code::HuffmanTree "HuffmanTree"
+ * stored at the beginning of the stream or the parameters of a coder, must be restored by the caller.
+ * 
+ * This satisfies the \ref code::BitSink "BitSink" concept.
+ */
+class FileBitSink {
+private:
+    int fd_;
+    bool error_;
+
+    std::vector<uint64_t> buffer_; // nb: one more word than the capacity, so that a write may exceed the capacity
+    size_t capacity_; // the capacity of the buffer in bits
+    size_t size_; // the number of bits in the buffer
+    uint64_t offset_; // the byte offset of the buffer within the file
+
+    void write_out(size_t const num_bytes) {
+        auto const* p = (uint8_t const*)buffer_.data();
+        size_t done = 0;
+        while(done < num_bytes) {
+            auto const n = pwrite(fd_, p + done, num_bytes - done, offset_ + done);
+            if(n <= 0) {
+                error_ = true;
+                return;
+            }
+            done += (size_t)n;
+        }
+    }
+
+    // discards the full words from the buffer, which must have been written, and moves the partial word to the front
+    void advance() {
+        auto const full = size_ / 64;
+        offset_ += 8 * full;
+        if(size_ % 64) buffer_[0] = buffer_[full];
+        size_ %= 64;
+    }
+
+public:
+    /**
+     * \brief Opens a file for writing
+     * 
+     * If \ref FileBitSinkOptions::append "append" is set, the file must exist and contain an encoded stream of \ref FileBitSinkOptions::num_bits "num_bits" bits.
+     * The file is truncated after the byte containing the last bit of the stream, and the bits following the stream in that byte are cleared.
+     * If the file is shorter than the stream, it is not opened. Otherwise, the file is created or truncated.
+     * 
+     * Whether the file could be opened can be checked using \ref is_open.
+     * 
+     * \param path the path to the file
+     * \param options the parameters
+     */
+    FileBitSink(char const* path, FileBitSinkOptions const& options = FileBitSinkOptions()) : error_(false), size_(0), offset_(0) {
+        auto const words = std::max(size_t(1), options.buffer_size / 8);
+        buffer_.resize(words + 1);
+        capacity_ = 64 * words;
+
+        if(!options.append) {
+            fd_ = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            return;
+        }
+
+        fd_ = open(path, O_RDWR);
+        if(fd_ < 0) return;
+
+        auto const num_bits = options.num_bits;
+        auto const num_bytes = (num_bits + 7) / 8;
+        struct stat st;
+        if(fstat(fd_, &st) != 0 || (uint64_t)st.st_size < num_bytes) {
+            close(fd_);
+            fd_ = -1;
+            return;
+        }
+
+        // restore the partial last word
+        offset_ = 8 * (num_bits / 64);
+        size_ = num_bits % 64;
+        if(size_) {
+            auto const partial = (size_ + 7) / 8;
+            if(pread(fd_, buffer_.data(), partial, offset_) != (ssize_t)partial) error_ = true; // nb: assuming little endian
+            buffer_[0] &= (uint64_t(1) << size_) - 1;
+        }
+        if(ftruncate(fd_, num_bytes) != 0) error_ = true;
+    }
+
+    FileBitSink(FileBitSink const&) = delete;
+    FileBitSink& operator=(FileBitSink const&) = delete;
+
+    /**
+     * \brief Flushes the buffer and closes the file
+     */
+    ~FileBitSink() {
+        if(fd_ >= 0) {
+            flush();
+            close(fd_);
+        }
+    }
+
+    /**
+     * \brief Reports whether the file has been opened successfully
+     * 
+     * \return true if the file is open, false otherwise
+     */
+    inline bool is_open() const { return fd_ >= 0; }
+
+    /**
+     * \brief Reports whether a write error has occurred
+     * 
+     * \return true if a write error has occurred, false otherwise
+     */
+    inline bool error() const { return error_; }
+
+    /**
+     * \brief Writes a single bit
+     * 
+     * \param bit the bit to write
+     */
+    inline void write(bool const bit) {
+        write(uint64_t(bit), 1);
+    }
+
+    /**
+     * \brief Writes the lowest bits of an integer, starting with the lowest bit
+     * 
+     * \param bits the bits to write
+     * \param num the number of bits to write, at most 64
+     */
+    inline void write(uint64_t bits, size_t const num) {
+        assert(num <= 64);
+        if(num == 0) return;
+        if(num < 64) bits &= (uint64_t(1) << num) - 1;
+
+        auto const i = size_ / 64;
+        auto const o = size_ % 64;
+        if(o == 0) {
+            buffer_[i] = bits;
+        } else {
+            buffer_[i] |= bits << o;
+            if(o + num > 64) buffer_[i + 1] = bits >> (64 - o);
+        }
+        size_ += num;
+
+        if(size_ >= capacity_) {
+            write_out(8 * (size_ / 64));
+            advance();
+        }
+    }
+
+    /**
+     * \brief Writes the buffered bits to the file
+     * 
+     * The partial last word is kept in the buffer and written again by the next flush.
+     */
+    inline void flush() {
+        write_out((size_ + 7) / 8);
+        advance();
+    }
+
+    /**
+     * \brief Reports the length of the encoded stream in bits, including the bits that were in the file before appending
+     * 
+     * This is the length to pass when reopening the file for appending.
+     * 
+     * \return the length of the encoded stream in bits
+     */
+    inline uint64_t num_bits_written() const { return 8 * offset_ + size_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,459 @@
+/**
+ * code/file_bit_source.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_FILE_BIT_SOURCE_HPP
+#define _CODE_FILE_BIT_SOURCE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "internal/io_uring_reader.hpp"
+#include "internal/thread_pool_reader.hpp"
+
+namespace code {
+
+/**
+ * \brief The mechanism used by a \ref code::FileBitSource "FileBitSource" for reading ahead
+ */
+enum class FileReadBackend {
+    /// \brief Use io_uring if available, and threads otherwise
+    automatic,
+    /// \brief Use io_uring (falls back to threads if io_uring is not available)
+    io_uring,
+    /// \brief Use a pool of threads performing blocking reads
+    threads
+};
+
+/**
+ * \brief Parameters for reading files using a \ref code::FileBitSource "FileBitSource"
+ */
+struct FileBitSourceOptions {
+    /// \brief The size of a single read request in bytes, which is rounded up to a multiple of the alignment
+    size_t block_size = 1 << 20;
+
+    /// \brief The number of blocks that are buffered, i.e., the maximum number of read requests in flight (at least two, so that bits can be peeked across blocks)
+    size_t queue_depth = 8;
+
+    /// \brief Whether to bypass the page cache using \c O_DIRECT (falls back to buffered reads if not supported by the file system)
+    bool direct = false;
+
+    /// \brief The read-ahead mechanism
+    FileReadBackend backend = FileReadBackend::automatic;
+
+    /// \brief The number of threads if a pool of threads is used for reading ahead
+    size_t num_threads = 2;
+};
+
+/**
+ * \brief A bit source that reads a file while keeping multiple aligned read requests in flight
+ * 
+ * The file is read in blocks, and up to \ref FileBitSourceOptions::queue_depth "queue_depth" blocks are requested ahead of the current one,
+ * so that decoding overlaps with I/O. Requests are handled by an io_uring if available, or by a pool of threads otherwise.
+ * Should the io_uring fail, the pending requests are handed over to a pool of threads.
+ * Since all blocks are aligned, the file can be read using \c O_DIRECT.
+ * 
+ * Bits are read in LSBF order, matching sinks that write the lowest bit first.
+ * This satisfies the \ref code::PeekableBitSource "PeekableBitSource" and \ref code::SeekableBitSource "SeekableBitSource" concepts.
+ * Reading beyond the end of the file yields 0-bits.
+ */
+class FileBitSource {
+private:
+    static constexpr size_t ALIGNMENT = 4096;
+    static constexpr size_t PADDING = 16; // nb: allows loading words at the end of a block
+
+    struct FreeDeleter {
+        void operator()(uint8_t* p) const { std::free(p); }
+    };
+
+    struct Slot {
+        std::unique_ptr<uint8_t, FreeDeleter> data;
+        uint64_t offset;
+        size_t bits;
+        bool valid;   // whether the slot has been requested
+        bool pending; // whether the request has not yet completed
+    };
+
+    int fd_;
+    uint64_t file_size_;
+    size_t block_size_;
+    size_t num_threads_;
+    bool direct_;
+    bool error_;
+
+    std::vector<Slot> slots_;
+    uint64_t next_offset_;
+    size_t cur_;
+    size_t pos_; // the bit position within the current block
+    uint64_t block_start_; // the bit position of the current block within the file
+
+    #ifdef CODE_HAS_IO_URING
+    std::unique_ptr<internal::IoUringReader> uring_;
+    #endif
+    std::unique_ptr<internal::ThreadPoolReader> pool_;
+
+    inline uint8_t* allocate_block() const {
+        auto* data = (uint8_t*)std::aligned_alloc(ALIGNMENT, block_size_ + ALIGNMENT); // nb: the padding must be a multiple of the alignment
+        std::memset(data + block_size_, 0, PADDING);
+        return data;
+    }
+
+    #ifdef CODE_HAS_IO_URING
+    // replaces the io_uring by a pool of threads after it failed, and resubmits the pending requests
+    void fall_back_to_threads(size_t const unsubmitted = SIZE_MAX) {
+        auto in_ring = [&](size_t const j){ return slots_[j].pending && j != unsubmitted; };
+
+        // drain the ring, so that the buffers are no longer in use by the kernel
+        bool drained = true;
+        for(size_t j = 0; j < slots_.size() && drained; j++) {
+            while(in_ring(j)) {
+                auto const c = uring_->wait();
+                if(c.first >= slots_.size()) {
+                    drained = false;
+                    break;
+                }
+                complete(c.first, c.second);
+            }
+        }
+
+        if(drained) {
+            uring_.reset();
+        } else {
+            // nb: the kernel may still write to the buffers of pending requests, so they are leaked along with the ring rather than freed
+            for(size_t j = 0; j < slots_.size(); j++) {
+                if(in_ring(j)) {
+                    (void)slots_[j].data.release();
+                    slots_[j].data.reset(allocate_block());
+                }
+            }
+            (void)uring_.release();
+        }
+
+        pool_ = std::make_unique<internal::ThreadPoolReader>(fd_, num_threads_);
+        for(size_t j = 0; j < slots_.size(); j++) {
+            auto& s = slots_[j];
+            if(s.pending) pool_->submit(j, s.data.get(), block_size_, s.offset);
+        }
+    }
+    #endif
+
+    void submit(size_t const i) {
+        auto& s = slots_[i];
+        s.valid = next_offset_ < file_size_;
+        s.pending = false;
+        s.offset = next_offset_;
+        s.bits = 0;
+        if(!s.valid) return;
+
+        next_offset_ += block_size_;
+        s.pending = true;
+
+        #ifdef CODE_HAS_IO_URING
+        if(uring_) {
+            if(!uring_->submit(i, s.data.get(), block_size_, s.offset)) fall_back_to_threads(i);
+            return;
+        }
+        #endif
+        pool_->submit(i, s.data.get(), block_size_, s.offset);
+    }
+
+    void complete(size_t const i, ptrdiff_t result) {
+        auto& s = slots_[i];
+        s.pending = false;
+        if(result < 0) {
+            error_ = true;
+            result = 0;
+        }
+
+        // complete short reads synchronously
+        auto const expected = (size_t)std::min(uint64_t(block_size_), file_size_ - s.offset);
+        while((size_t)result < expected) {
+            auto const n = pread(fd_, s.data.get() + result, expected - result, s.offset + result);
+            if(n < 0 && errno == EINTR) continue;
+            if(n <= 0) {
+                error_ = true;
+                break;
+            }
+            result += n;
+        }
+        s.bits = 8 * std::min((size_t)result, expected);
+    }
+
+    void wait(size_t const i) {
+        while(slots_[i].pending) {
+            #ifdef CODE_HAS_IO_URING
+            if(uring_) {
+                auto const c = uring_->wait();
+                if(c.first < slots_.size()) {
+                    complete(c.first, c.second);
+                } else {
+                    fall_back_to_threads();
+                }
+                continue;
+            }
+            #endif
+            auto const c = pool_->wait();
+            complete(c.first, c.second);
+        }
+    }
+
+    inline size_t next_slot() const { return (cur_ + 1) % slots_.size(); }
+
+    // advances to the next block, recycling the current one
+    void next_block() {
+        block_start_ += slots_[cur_].bits;
+        pos_ -= slots_[cur_].bits;
+        submit(cur_);
+        cur_ = next_slot();
+        wait(cur_);
+    }
+
+    // loads the given number of bits starting at the given bit position in a slot
+    inline uint64_t load(Slot const& s, size_t const pos, size_t const num) const {
+        auto const* p = s.data.get() + pos / 8;
+        auto const o = pos % 8;
+        uint64_t w;
+        std::memcpy(&w, p, 8); // nb: assuming little endian
+        w >>= o;
+        if(o + num > 64) w |= uint64_t(p[8]) << (64 - o);
+        return num < 64 ? (w & ((uint64_t(1) << num) - 1)) : w;
+    }
+
+public:
+    /**
+     * \brief Opens a file for reading
+     * 
+     * Whether the file could be opened can be checked using \ref is_open.
+     * 
+     * \param path the path to the file
+     * \param options the read-ahead parameters
+     */
+    FileBitSource(char const* path, FileBitSourceOptions const& options = FileBitSourceOptions())
+        : fd_(-1), file_size_(0), num_threads_(std::max(size_t(1), options.num_threads)), direct_(options.direct), error_(false), next_offset_(0), cur_(0), pos_(0), block_start_(0) {
+
+        block_size_ = std::max(size_t(1), (options.block_size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+        if(direct_) {
+            fd_ = open(path, O_RDONLY | O_DIRECT);
+            if(fd_ < 0) direct_ = false; // nb: O_DIRECT is not supported by all file systems
+        }
+        if(fd_ < 0) fd_ = open(path, O_RDONLY);
+        if(fd_ < 0) return;
+
+        struct stat st;
+        if(fstat(fd_, &st) == 0) file_size_ = (uint64_t)st.st_size;
+
+        // allocate aligned blocks
+        slots_.resize(std::max(size_t(2), options.queue_depth));
+        for(auto& s : slots_) {
+            s.data.reset(allocate_block());
+            s.valid = false;
+            s.pending = false;
+            s.bits = 0;
+        }
+
+        // set up the read-ahead mechanism
+        #ifdef CODE_HAS_IO_URING
+        if(options.backend != FileReadBackend::threads) {
+            uring_ = std::make_unique<internal::IoUringReader>(fd_, (unsigned)slots_.size());
+            if(!uring_->ok()) uring_.reset();
+        }
+        if(!uring_)
+        #endif
+        {
+            pool_ = std::make_unique<internal::ThreadPoolReader>(fd_, num_threads_);
+        }
+
+        // request the first blocks
+        for(size_t i = 0; i < slots_.size(); i++) submit(i);
+        wait(cur_);
+    }
+
+    FileBitSource(FileBitSource const&) = delete;
+    FileBitSource& operator=(FileBitSource const&) = delete;
+
+    /**
+     * \brief Waits for all requests in flight and closes the file
+     */
+    ~FileBitSource() {
+        for(size_t i = 0; i < slots_.size(); i++) wait(i);
+        #ifdef CODE_HAS_IO_URING
+        uring_.reset();
+        #endif
+        pool_.reset();
+        if(fd_ >= 0) close(fd_);
+    }
+
+    /**
+     * \brief Reports whether the file has been opened successfully
+     * 
+     * \return true if the file is open, false otherwise
+     */
+    inline bool is_open() const { return fd_ >= 0; }
+
+    /**
+     * \brief Reports whether a read error has occurred
+     * 
+     * \return true if a read error has occurred, false otherwise
+     */
+    inline bool error() const { return error_; }
+
+    /**
+     * \brief Reports whether the file is read using \c O_DIRECT
+     * 
+     * \return true if the page cache is bypassed, false otherwise
+     */
+    inline bool direct() const { return direct_; }
+
+    /**
+     * \brief Reports whether the read-ahead uses io_uring
+     * 
+     * \return true if io_uring is used, false if threads are used
+     */
+    inline bool uses_io_uring() const {
+        #ifdef CODE_HAS_IO_URING
+        return (bool)uring_;
+        #else
+        return false;
+        #endif
+    }
+
+    /**
+     * \brief Reports the size of the file in bytes
+     * 
+     * \return the size of the file
+     */
+    inline uint64_t file_size() const { return file_size_; }
+
+    /**
+     * \brief Reports the current bit position
+     * 
+     * \return the number of bits from the beginning of the file
+     */
+    inline uint64_t pos() const { return block_start_ + pos_; }
+
+    /**
+     * \brief Moves to the given bit position
+     * 
+     * If the position is not within the current block, all requests in flight are discarded and reading restarts at the block containing the position.
+     * 
+     * \param pos the bit position
+     */
+    void seek(uint64_t const pos) {
+        if(slots_.empty()) return;
+        if(pos >= block_start_ && pos < block_start_ + slots_[cur_].bits) {
+            pos_ = pos - block_start_;
+            return;
+        }
+
+        for(size_t i = 0; i < slots_.size(); i++) wait(i);
+        next_offset_ = (pos / 8 / block_size_) * block_size_;
+        block_start_ = 8 * next_offset_;
+        cur_ = 0;
+        for(size_t i = 0; i < slots_.size(); i++) submit(i);
+        wait(cur_);
+
+        pos_ = pos - block_start_;
+        skip(0);
+    }
+
+    /**
+     * \brief Reads the given number of bits without advancing
+     * 
+     * \param num the number of bits to read, at most 64
+     * \return the bits, where the first bit is the lowest bit
+     */
+    inline uint64_t peek(size_t const num) {
+        assert(num <= 64);
+        if(num == 0) return 0;
+
+        auto const& s = slots_[cur_];
+        if(pos_ + num <= s.bits) [[likely]] return load(s, pos_, num);
+
+        // the bits span the current and the next block
+        auto const avail = s.bits > pos_ ? s.bits - pos_ : 0;
+        auto const lo = avail ? load(s, pos_, avail) : 0;
+
+        auto const n = next_slot();
+        auto const& t = slots_[n];
+        if(!t.valid || avail == 0 || s.bits == 0) return lo; // nb: the end of the file has been reached
+
+        wait(n);
+        auto const need = std::min(num - avail, t.bits);
+        return need ? lo | (load(t, 0, need) << avail) : lo;
+    }
+
+    /**
+     * \brief Advances by the given number of bits
+     * 
+     * \param num the number of bits to skip
+     */
+    inline void skip(size_t const num) {
+        pos_ += num;
+        while(pos_ >= slots_[cur_].bits && slots_[next_slot()].valid && slots_[cur_].bits > 0) next_block();
+    }
+
+    /**
+     * \brief Reads a single bit
+     * 
+     * \return the bit read
+     */
+    inline bool read() {
+        auto const& s = slots_[cur_];
+        if(pos_ < s.bits) [[likely]] {
+            bool const b = (s.data.get()[pos_ / 8] >> (pos_ % 8)) & 1;
+            if(++pos_ == s.bits) skip(0);
+            return b;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * \brief Reads the given number of bits
+     * 
+     * \param num the number of bits to read, at most 64
+     * \return the bits, where the first bit is the lowest bit
+     */
+    inline uint64_t read(size_t const num) {
+        auto const bits = peek(num);
+        skip(num);
+        return bits;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,253 @@
+/**
+ * code/front_coded_dictionary.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_FRONT_CODED_DICTIONARY_HPP
+#define _CODE_FRONT_CODED_DICTIONARY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "binary.hpp"
+#include "counter.hpp"
+#include "elias_gamma.hpp"
+#include "huffman.hpp"
+
+#include "internal/bit_buffer.hpp"
+
+namespace code {
+
+/**
+ * \brief A compressed dictionary of sorted strings using front coding
+ * 
+ * The strings are grouped into buckets of a fixed size. The first string of each bucket, its header, is stored verbatim.
+ * Each following string is encoded by the length of the longest common prefix with its predecessor and the length of the remaining suffix,
+ * both using \ref code::EliasGamma "EliasGamma" codes, followed by the characters of the suffix.
+ * The suffix characters are either stored in binary or encoded using a Huffman tree built over all suffixes of the dictionary.
+ * 
+ * Strings are identified by their rank in the sorted order.
+ * Extracting a string requires decoding its bucket up to the string, and locating a string requires a binary search over the headers
+ * followed by decoding a single bucket. Thus, the bucket size trades space for query time.
+ */
+class FrontCodedDictionary {
+private:
+    using UChar = unsigned char;
+
+    static constexpr Universe NAT = Universe::umax();
+
+    size_t size_;
+    size_t bucket_size_;
+    bool huffman_;
+
+    std::string headers_;
+    std::vector<size_t> header_offsets_;
+    std::vector<uint64_t> bits_;
+    std::vector<size_t> bucket_offsets_;
+
+    HuffmanTree<UChar> tree_;
+    std::array<HuffmanCode, 256> table_;
+
+    inline size_t num_buckets() const { return header_offsets_.size() - 1; }
+
+    inline std::string_view header(size_t const b) const {
+        return std::string_view(headers_.data() + header_offsets_[b], header_offsets_[b + 1] - header_offsets_[b]);
+    }
+
+    // decodes the next string of a bucket, given its predecessor
+    void decode_next(internal::BitBufferSource& src, std::string& s) const {
+        auto const lcp = (size_t)EliasGamma::decode(src, NAT);
+        auto const len = (size_t)EliasGamma::decode(src, NAT);
+        s.resize(lcp);
+        s.reserve(lcp + len);
+        for(size_t i = 0; i < len; i++) {
+            s.push_back(huffman_ ? (char)Huffman::decode(src, tree_.root()) : (char)Binary::decode(src, 8));
+        }
+    }
+
+public:
+    /**
+     * \brief Constructs an empty dictionary
+     */
+    FrontCodedDictionary() : FrontCodedDictionary((std::string const*)nullptr, (std::string const*)nullptr) {
+    }
+
+    FrontCodedDictionary(FrontCodedDictionary&&) = default;
+    FrontCodedDictionary& operator=(FrontCodedDictionary&&) = default;
+
+    FrontCodedDictionary(FrontCodedDictionary const&) = delete;
+    FrontCodedDictionary& operator=(FrontCodedDictionary const&) = delete;
+
+    /**
+     * \brief Constructs a dictionary of the given strings
+     * 
+     * \tparam It the forward iterator type
+     * \param begin the first string
+     * \param end the end of the strings, which must be strictly increasing in lexicographic order
+     * \param bucket_size the number of strings per bucket, at least one
+     * \param huffman whether to encode the suffix characters using a Huffman code
+     */
+    template<std::forward_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, std::string_view>
+    FrontCodedDictionary(It const begin, It const end, size_t const bucket_size = 16, bool const huffman = false)
+        : size_(0), bucket_size_(bucket_size), huffman_(huffman), table_{} {
+
+        assert(bucket_size > 0);
+
+        if(huffman) {
+            // build a Huffman tree over the characters of all suffixes
+            Counter<UChar> hist;
+            size_t i = 0;
+            std::string_view prev;
+            for(auto it = begin; it != end; ++it, ++i) {
+                std::string_view const s = *it;
+                if(i % bucket_size != 0) {
+                    auto const lcp = (size_t)(std::mismatch(prev.begin(), prev.end(), s.begin(), s.end()).first - prev.begin());
+                    for(auto const c : s.substr(lcp)) hist.count((UChar)c);
+                }
+                prev = s;
+            }
+            tree_ = HuffmanTree<UChar>(hist);
+            table_ = tree_.table();
+        }
+
+        internal::BitBufferSink sink(bits_);
+        header_offsets_.push_back(0);
+        std::string_view prev;
+        for(auto it = begin; it != end; ++it, ++size_) {
+            std::string_view const s = *it;
+            assert(size_ == 0 || prev < s);
+
+            if(size_ % bucket_size == 0) {
+                headers_.append(s);
+                header_offsets_.push_back(headers_.size());
+                bucket_offsets_.push_back(sink.num_bits_written());
+            } else {
+                auto const lcp = (size_t)(std::mismatch(prev.begin(), prev.end(), s.begin(), s.end()).first - prev.begin());
+                EliasGamma::encode(sink, lcp, NAT);
+                EliasGamma::encode(sink, s.size() - lcp, NAT);
+                for(auto const c : s.substr(lcp)) {
+                    if(huffman) {
+                        Huffman::encode(sink, (UChar)c, table_);
+                    } else {
+                        Binary::encode(sink, (UChar)c, 8);
+                    }
+                }
+            }
+            prev = s;
+        }
+        headers_.shrink_to_fit();
+    }
+
+    /**
+     * \brief Reports the number of strings
+     * 
+     * \return the number of strings
+     */
+    inline size_t size() const { return size_; }
+
+    /**
+     * \brief Reports the number of strings per bucket
+     * 
+     * \return the bucket size
+     */
+    inline size_t bucket_size() const { return bucket_size_; }
+
+    /**
+     * \brief Reports whether the suffix characters are Huffman coded
+     * 
+     * \return whether the suffix characters are Huffman coded
+     */
+    inline bool huffman() const { return huffman_; }
+
+    /**
+     * \brief Extracts the string with the given identifier
+     * 
+     * \param id the identifier, less than \ref size
+     * \return the string with rank \c id
+     */
+    std::string extract(size_t const id) const {
+        assert(id < size_);
+        auto const b = id / bucket_size_;
+        std::string s(header(b));
+
+        internal::BitBufferSource src(bits_.data(), bucket_offsets_[b]);
+        for(size_t i = 0; i < id % bucket_size_; i++) decode_next(src, s);
+        return s;
+    }
+
+    /**
+     * \brief Locates the given string
+     * 
+     * The bucket that may contain the string is found using a binary search over the headers, and then decoded until the string is found.
+     * 
+     * \param s the string to locate
+     * \return the identifier of \c s, or \ref size if the dictionary does not contain \c s
+     */
+    size_t locate(std::string_view const s) const {
+        // find the last bucket whose header is less than or equal to s
+        size_t lo = 0, hi = num_buckets();
+        while(lo < hi) {
+            auto const m = lo + (hi - lo) / 2;
+            if(header(m) <= s) lo = m + 1; else hi = m;
+        }
+        if(lo == 0) return size_;
+
+        auto const b = lo - 1;
+        auto const first = b * bucket_size_;
+        if(header(b) == s) return first;
+
+        // scan the bucket
+        std::string cur(header(b));
+        internal::BitBufferSource src(bits_.data(), bucket_offsets_[b]);
+        auto const num = std::min(bucket_size_, size_ - first);
+        for(size_t i = 1; i < num; i++) {
+            decode_next(src, cur);
+            if(cur == s) return first + i;
+            if(cur > s) break;
+        }
+        return size_;
+    }
+
+    /**
+     * \brief Reports the total size of the dictionary in bits
+     * 
+     * This includes the headers and their offsets, the encoded buckets and their offsets, but not the Huffman tree.
+     * 
+     * \return the size in bits
+     */
+    inline size_t size_in_bits() const {
+        return 8 * headers_.size() + 64 * (header_offsets_.size() + bits_.size() + bucket_offsets_.size());
+    }
+};
+
+}
+
+#endif
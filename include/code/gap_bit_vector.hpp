@@ -0,0 +1,305 @@
+/**
+ * code/gap_bit_vector.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_GAP_BIT_VECTOR_HPP
+#define _CODE_GAP_BIT_VECTOR_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+#include "elias_delta.hpp"
+#include "rice.hpp"
+
+#include "internal/bit_buffer.hpp"
+
+namespace code {
+
+/**
+ * \brief The codes available for encoding the gaps in a \ref code::GapBitVector "GapBitVector"
+ */
+enum class GapCoding {
+    /// \brief Elias-delta codes, which adapt to any gap distribution
+    elias_delta,
+    /// \brief Rice codes with the exponent that minimizes the total size
+    rice,
+};
+
+/**
+ * \brief A sparse bit vector that stores the gaps between its set bits
+ * 
+ * The positions of the set bits are stored by encoding the gaps between them using either \ref code::EliasDelta "EliasDelta" or
+ * \ref code::Rice "Rice" codes (see \ref code::GapCoding "GapCoding"); for the latter, the exponent that minimizes the total size is chosen.
+ * The size of the bit vector is thus proportional to the number of set bits rather than its length.
+ * 
+ * For every \c k -th set bit, the position and the bit offset of the following gaps are stored as a skip pointer.
+ * Queries locate the relevant skip pointer using binary search and decode at most \c k gaps from there.
+ */
+class GapBitVector {
+private:
+    static constexpr Universe GAP_UNIVERSE = Universe::at_least(1);
+
+    size_t size_;
+    size_t ones_;
+    size_t sampling_;
+    GapCoding coding_;
+    uint8_t p_;
+    std::vector<uint64_t> bits_;
+    std::vector<uint64_t> sample_pos_;
+    std::vector<uint64_t> sample_offset_;
+
+    // sequentially decodes the positions of the set bits within a segment
+    class Cursor {
+    private:
+        GapBitVector const* bv_;
+        internal::BitBufferSource src_;
+        size_t remaining_;
+        uint64_t pos_;
+
+    public:
+        inline Cursor(GapBitVector const& bv, size_t const j)
+            : bv_(&bv), src_(bv.bits_.data(), bv.sample_offset_[j]), remaining_(bv.segment_size(j) - 1), pos_(bv.sample_pos_[j]) {
+        }
+
+        inline uint64_t pos() const { return pos_; }
+        inline bool has_next() const { return remaining_ > 0; }
+
+        inline uint64_t next() {
+            assert(has_next());
+            --remaining_;
+            pos_ += bv_->coding_ == GapCoding::rice ? Rice::decode(src_, bv_->p_, GAP_UNIVERSE) : EliasDelta::decode(src_);
+            return pos_;
+        }
+    };
+
+    inline size_t num_segments() const { return sample_pos_.size(); }
+
+    inline size_t segment_size(size_t const j) const {
+        return std::min(sampling_, ones_ - j * sampling_);
+    }
+
+    // finds the last segment starting at or before the given position, or returns SIZE_MAX if there is none
+    inline size_t segment(uint64_t const i) const {
+        auto const it = std::upper_bound(sample_pos_.begin(), sample_pos_.end(), i);
+        return (size_t)(it - sample_pos_.begin()) - 1;
+    }
+
+public:
+    /**
+     * \brief Constructs an empty bit vector
+     */
+    GapBitVector() : size_(0), ones_(0), sampling_(1), coding_(GapCoding::rice), p_(0) {
+    }
+
+    /**
+     * \brief Constructs a bit vector from the positions of its set bits
+     * 
+     * \tparam It the input iterator type
+     * \param begin the position of the first set bit
+     * \param end the end of the positions, which must be strictly increasing
+     * \param size the number of bits, which must exceed the last position
+     * \param coding the code used for encoding the gaps
+     * \param sampling the number of set bits between two skip pointers
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, uint64_t>
+    GapBitVector(It begin, It const end, size_t const size, GapCoding const coding = GapCoding::rice, size_t const sampling = 64)
+        : size_(size), ones_(0), sampling_(sampling), coding_(coding), p_(0) {
+
+        assert(sampling > 0);
+
+        // compute gaps relative to the last skip pointer
+        std::vector<uint64_t> gaps;
+        uint64_t prev = 0;
+        while(begin != end) {
+            uint64_t const pos = *begin++;
+            assert(pos < size);
+            if(ones_ % sampling == 0) {
+                sample_pos_.push_back(pos);
+            } else {
+                assert(pos > prev);
+                gaps.push_back(pos - prev);
+            }
+            prev = pos;
+            ++ones_;
+        }
+
+        // encode gaps segment by segment
+        internal::BitBufferSink sink(bits_);
+        if(coding == GapCoding::rice) {
+            for(auto& g : gaps) g = GAP_UNIVERSE.rel(g);
+            p_ = Rice::optimal_exponent(gaps.data(), gaps.size());
+        }
+
+        size_t const gaps_per_segment = sampling - 1;
+        for(size_t j = 0; j < num_segments(); j++) {
+            sample_offset_.push_back(sink.num_bits_written());
+
+            auto const* segment_gaps = gaps.data() + j * gaps_per_segment;
+            auto const num = segment_size(j) - 1;
+            if(coding == GapCoding::rice) {
+                Rice::encode_bulk(sink, segment_gaps, num, p_);
+            } else {
+                EliasDelta::encode_bulk(sink, segment_gaps, num);
+            }
+        }
+    }
+
+    /**
+     * \brief Reports the number of bits
+     * 
+     * \return the number of bits
+     */
+    inline size_t size() const { return size_; }
+
+    /**
+     * \brief Reports the number of set bits
+     * 
+     * \return the number of set bits
+     */
+    inline size_t num_ones() const { return ones_; }
+
+    /**
+     * \brief Reports the code used for encoding the gaps
+     * 
+     * \return the gap code
+     */
+    inline GapCoding coding() const { return coding_; }
+
+    /**
+     * \brief Reports the exponent of the Golomb divisor if gaps are Rice coded
+     * 
+     * \return the exponent of the Golomb divisor
+     */
+    inline uint8_t rice_exponent() const { return p_; }
+
+    /**
+     * \brief Reports the value of the bit at the given position
+     * 
+     * \param i the position, less than \ref size
+     * \return the bit at position \c i
+     */
+    bool operator[](size_t const i) const {
+        assert(i < size_);
+        auto const j = segment(i);
+        if(j == SIZE_MAX) return false;
+
+        Cursor c(*this, j);
+        while(c.pos() < i && c.has_next()) c.next();
+        return c.pos() == i;
+    }
+
+    /**
+     * \brief Counts the set bits before the given position
+     * 
+     * \param i the position, at most \ref size
+     * \return the number of set bits in the range <tt>[0, i)</tt>
+     */
+    size_t rank1(size_t const i) const {
+        assert(i <= size_);
+        auto const j = i ? segment(i - 1) : SIZE_MAX;
+        if(j == SIZE_MAX) return 0;
+
+        Cursor c(*this, j);
+        size_t r = j * sampling_ + 1;
+        while(c.has_next() && c.next() < i) ++r;
+        return r;
+    }
+
+    /**
+     * \brief Counts the unset bits before the given position
+     * 
+     * \param i the position, at most \ref size
+     * \return the number of unset bits in the range <tt>[0, i)</tt>
+     */
+    inline size_t rank0(size_t const i) const {
+        return i - rank1(i);
+    }
+
+    /**
+     * \brief Finds the position of the k-th set bit
+     * 
+     * \param k the rank of the set bit, between one and \ref num_ones
+     * \return the position of the k-th set bit
+     */
+    size_t select1(size_t const k) const {
+        assert(k >= 1 && k <= ones_);
+        auto const j = (k - 1) / sampling_;
+
+        Cursor c(*this, j);
+        for(auto n = (k - 1) % sampling_; n; n--) c.next();
+        return c.pos();
+    }
+
+    /**
+     * \brief Finds the first set bit at or after the given position
+     * 
+     * \param i the position
+     * \return the position of the first set bit at or after \c i, or \ref size if there is none
+     */
+    size_t next_set_bit(size_t const i) const {
+        if(ones_ == 0) return size_;
+
+        auto const j = segment(i);
+        if(j == SIZE_MAX) return sample_pos_[0];
+
+        Cursor c(*this, j);
+        while(c.pos() < i && c.has_next()) c.next();
+        if(c.pos() >= i) return c.pos();
+        return j + 1 < num_segments() ? sample_pos_[j + 1] : size_;
+    }
+
+    /**
+     * \brief Reports the positions of all set bits in ascending order
+     * 
+     * \tparam OutputIt the output iterator type
+     * \param out the output
+     */
+    template<std::output_iterator<uint64_t> OutputIt>
+    void positions(OutputIt out) const {
+        for(size_t j = 0; j < num_segments(); j++) {
+            Cursor c(*this, j);
+            *out++ = c.pos();
+            while(c.has_next()) *out++ = c.next();
+        }
+    }
+
+    /**
+     * \brief Reports the total size of the encoded gaps and the skip pointers in bits
+     * 
+     * \return the size in bits
+     */
+    size_t size_in_bits() const {
+        return 64 * (bits_.size() + sample_pos_.size() + sample_offset_.size());
+    }
+};
+
+}
+
+#endif
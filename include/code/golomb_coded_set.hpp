@@ -0,0 +1,279 @@
+/**
+ * code/golomb_coded_set.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_GOLOMB_CODED_SET_HPP
+#define _CODE_GOLOMB_CODED_SET_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "rice.hpp"
+#include "universe.hpp"
+
+#include "internal/bit_buffer.hpp"
+
+namespace code {
+
+/**
+ * \brief A Golomb-coded set, a compact probabilistic filter for read-only sets of keys
+ * 
+ * The keys are hashed into the range <tt>[0, n * 2^p)</tt>, where \c n is the number of keys and \c p is a parameter,
+ * and the sorted hash values are stored by Rice encoding the gaps between them using the Golomb divisor \c 2^p.
+ * A membership query reports false positives with a probability of approximately <tt>2^-p</tt>, but never false negatives.
+ * Each key takes about <tt>p + 2</tt> bits, compared to about <tt>1.44 p</tt> bits for a Bloom filter with the same false positive rate.
+ * 
+ * Every \c k -th hash value is sampled along with the bit offset of the following gaps, so a query only decodes a segment of at most \c k gaps.
+ * 
+ * \tparam Key the key type
+ * \tparam Hash the hash function type
+ */
+template<typename Key, typename Hash = std::hash<Key>>
+class GolombCodedSet {
+private:
+    // gaps are at least one, which the Rice code does not need to spend bits on
+    static constexpr Universe GAP_UNIVERSE = Universe::at_least(1);
+
+    // finalizer of MurmurHash3, which spreads the output of weak hash functions (such as std::hash for integers) over all bits
+    inline static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    Hash hash_;
+    uint8_t p_;
+    size_t sampling_;
+    size_t size_;
+    uint64_t range_;
+    std::vector<uint64_t> bits_;
+    std::vector<uint64_t> sample_values_;
+    std::vector<size_t> sample_pos_;
+
+    // computes the high 64 bits of the 128-bit product of two 64-bit integers
+    inline static uint64_t mul_high(uint64_t const a, uint64_t const b) {
+        #ifdef CODE_HAS_UINT128
+        return (uint64_t)((uint128_t(a) * b) >> 64);
+        #else
+        // nb: schoolbook multiplication of 32-bit halves, none of the partial sums can overflow
+        auto const a_lo = a & UINT32_MAX, a_hi = a >> 32;
+        auto const b_lo = b & UINT32_MAX, b_hi = b >> 32;
+        auto const lo_lo = a_lo * b_lo;
+        auto const hi_lo = a_hi * b_lo;
+        auto const lo_hi = a_lo * b_hi;
+        auto const mid = (lo_lo >> 32) + (hi_lo & UINT32_MAX) + lo_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (mid >> 32);
+        #endif
+    }
+
+    // maps a key into [0, range) using the high bits of the product of its hash with the range, which avoids a division
+    inline uint64_t reduce(Key const& key) const {
+        return mul_high(mix((uint64_t)hash_(key)), range_);
+    }
+
+    // finds the segment that may contain the given hash value, or returns SIZE_MAX if the value precedes all values
+    inline size_t segment(uint64_t const h) const {
+        auto const it = std::upper_bound(sample_values_.begin(), sample_values_.end(), h);
+        return (size_t)(it - sample_values_.begin()) - 1;
+    }
+
+    inline size_t segment_size(size_t const j) const {
+        return std::min(sampling_, size_ - j * sampling_);
+    }
+
+public:
+    /**
+     * \brief Constructs an empty set
+     */
+    GolombCodedSet() : p_(0), sampling_(1), size_(0), range_(0) {
+    }
+
+    GolombCodedSet(GolombCodedSet&&) = default;
+    GolombCodedSet& operator=(GolombCodedSet&&) = default;
+
+    GolombCodedSet(GolombCodedSet const&) = default;
+    GolombCodedSet& operator=(GolombCodedSet const&) = default;
+
+    /**
+     * \brief Constructs a set of the given keys
+     * 
+     * \tparam It the input iterator type
+     * \param begin the first key
+     * \param end the end of the keys
+     * \param p the base-two logarithm of the inverse false positive rate, less than 64
+     * \param sampling the number of hash values per sampled segment
+     * \param hash the hash function
+     */
+    template<std::forward_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, Key>
+    GolombCodedSet(It begin, It const end, uint8_t const p, size_t const sampling = 64, Hash hash = Hash())
+        : hash_(std::move(hash)), p_(p), sampling_(sampling), size_(0) {
+
+        assert(p < 64);
+        assert(sampling > 0);
+
+        auto const n = (uint64_t)std::max(std::distance(begin, end), std::ptrdiff_t(1));
+        assert(n <= (UINT64_MAX >> p));
+        range_ = n << p;
+
+        // hash and sort keys
+        std::vector<uint64_t> values;
+        values.reserve(n);
+        while(begin != end) values.push_back(reduce(*begin++));
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        size_ = values.size();
+
+        // encode gaps
+        internal::BitBufferSink sink(bits_);
+        std::vector<uint64_t> gaps;
+        gaps.reserve(sampling);
+
+        auto const num_segments = (size_ + sampling - 1) / sampling;
+        sample_values_.reserve(num_segments);
+        sample_pos_.reserve(num_segments);
+        for(size_t i = 0; i < size_; i += sampling) {
+            sample_values_.push_back(values[i]);
+            sample_pos_.push_back(sink.num_bits_written());
+
+            gaps.clear();
+            auto const segment_end = std::min(i + sampling, size_);
+            for(size_t k = i + 1; k < segment_end; k++) gaps.push_back(GAP_UNIVERSE.rel(values[k] - values[k - 1]));
+            Rice::encode_bulk(sink, gaps.data(), gaps.size(), p);
+        }
+    }
+
+    /**
+     * \brief Tests whether the set may contain the given key
+     * 
+     * \param key the key in question
+     * \return false if the key is definitely not contained, true if it is contained or in case of a false positive
+     */
+    bool contains(Key const& key) const {
+        if(size_ == 0) return false;
+
+        auto const h = reduce(key);
+        auto const j = segment(h);
+        if(j == SIZE_MAX) return false;
+
+        auto v = sample_values_[j];
+        internal::BitBufferSource src(bits_.data(), sample_pos_[j]);
+        for(size_t k = segment_size(j) - 1; k && v < h; k--) {
+            v += Rice::decode(src, p_, GAP_UNIVERSE);
+        }
+        return v == h;
+    }
+
+    /**
+     * \brief Tests whether the set may contain the given keys
+     * 
+     * The queries are hashed and sorted first, such that each segment of the set is decoded at most once.
+     * 
+     * \tparam It the input iterator type
+     * \tparam OutputIt the output iterator type
+     * \param begin the first key in question
+     * \param end the end of the keys in question
+     * \param out the output, which receives one result per key in the order of the keys as described for \ref contains(Key const&) const
+     */
+    template<std::input_iterator It, std::output_iterator<bool> OutputIt>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, Key>
+    void contains(It begin, It const end, OutputIt out) const {
+        std::vector<std::pair<uint64_t, size_t>> queries;
+        for(size_t i = 0; begin != end; i++) queries.emplace_back(reduce(*begin++), i);
+        std::sort(queries.begin(), queries.end());
+
+        std::vector<bool> result(queries.size(), false);
+        if(size_) {
+            size_t cur = SIZE_MAX;
+            uint64_t v = 0;
+            size_t remaining = 0;
+            internal::BitBufferSource src(bits_.data());
+            for(auto const& [h, i] : queries) {
+                auto const j = segment(h);
+                if(j == SIZE_MAX) continue;
+
+                if(j != cur) {
+                    // jump to the segment
+                    cur = j;
+                    v = sample_values_[j];
+                    remaining = segment_size(j) - 1;
+                    src.seek(sample_pos_[j]);
+                }
+
+                while(v < h && remaining) {
+                    v += Rice::decode(src, p_, GAP_UNIVERSE);
+                    --remaining;
+                }
+                result[i] = (v == h);
+            }
+        }
+
+        for(bool const b : result) *out++ = b;
+    }
+
+    /**
+     * \brief Reports the number of distinct hash values in the set
+     * 
+     * This may be less than the number of keys the set was constructed from due to hash collisions.
+     * 
+     * \return the number of distinct hash values
+     */
+    inline size_t size() const { return size_; }
+
+    /**
+     * \brief Reports the base-two logarithm of the inverse false positive rate
+     * 
+     * \return the parameter \c p
+     */
+    inline uint8_t p() const { return p_; }
+
+    /**
+     * \brief Reports the number of hash values per sampled segment
+     * 
+     * \return the sampling rate
+     */
+    inline size_t sampling() const { return sampling_; }
+
+    /**
+     * \brief Reports the total size of the encoded gaps and the samples in bits
+     * 
+     * \return the size in bits
+     */
+    inline size_t size_in_bits() const {
+        return 64 * bits_.size() + 64 * sample_values_.size() + 8 * sizeof(size_t) * sample_pos_.size();
+    }
+};
+
+}
+
+#endif
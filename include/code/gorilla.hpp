@@ -0,0 +1,284 @@
+/**
+ * code/gorilla.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_GORILLA_HPP
+#define _CODE_GORILLA_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "binary.hpp"
+#include "unary.hpp"
+
+namespace code {
+
+/**
+ * \brief A data point of a time series
+ */
+struct GorillaPoint {
+    /// \brief The timestamp
+    int64_t timestamp;
+
+    /// \brief The value
+    double value;
+};
+
+/**
+ * \brief Facebook's Gorilla compression of time series of floating point values
+ * 
+ * Each data point consists of a timestamp and a double value, which are encoded separately.
+ * 
+ * Timestamps are encoded by the difference between consecutive deltas (delta-of-delta), which is zero for regularly spaced points.
+ * The bucket of the delta-of-delta is encoded in truncated unary code (i.e., the terminating zero is omitted for the last bucket):
+ * zero is encoded as a single bit, and otherwise, the value is stored in 7, 9, 12 or 64 bits depending on its magnitude.
+ * 
+ * Values are encoded by the XOR with their predecessor, which is zero for repeated values. Otherwise, the XOR has few meaningful bits
+ * between its leading and trailing zeros for slowly changing values. If the meaningful bits fit into the window of the previous XOR,
+ * only they are stored. Otherwise, the number of leading zeros and meaningful bits are encoded using \ref code::Binary "Binary" codes
+ * in 5 and 6 bits, respectively, followed by the meaningful bits.
+ * 
+ * The first data point is stored verbatim. The state, i.e., the previous timestamp, delta and value, is kept between calls,
+ * so a time series is encoded and decoded point by point using the same sequence of calls. The decoder must know the number of points.
+ * The state can be saved and restored, so this class satisfies the \ref code::Checkpointable "Checkpointable" concept.
+ */
+class Gorilla {
+private:
+    static constexpr size_t NUM_BUCKETS = 4;
+    static constexpr uint8_t BUCKET_BITS[NUM_BUCKETS] = { 7, 9, 12, 64 };
+
+    static constexpr uint8_t LEADING_BITS = 5;
+    static constexpr uint8_t MAX_LEADING = (1 << LEADING_BITS) - 1;
+    static constexpr uint8_t LENGTH_BITS = 6;
+
+    static constexpr uint8_t NO_WINDOW = UINT8_MAX;
+
+    bool first_;
+    uint64_t prev_timestamp_;
+    uint64_t prev_delta_;
+    uint64_t prev_value_;
+    uint8_t prev_leading_;
+    uint8_t prev_trailing_;
+
+    template<BitSink Sink>
+    void encode_timestamp(Sink& sink, uint64_t const timestamp) {
+        // nb: we compute in unsigned arithmetic so that overflows wrap around consistently in the decoder
+        auto const delta = timestamp - prev_timestamp_;
+        auto const dod = delta - prev_delta_;
+        prev_timestamp_ = timestamp;
+        prev_delta_ = delta;
+
+        if(dod == 0) {
+            sink.write(0);
+            return;
+        }
+
+        for(size_t k = 0; k < NUM_BUCKETS - 1; k++) {
+            // the bucket contains the range [-(2^(b-1) - 1), 2^(b-1)]
+            auto const half = uint64_t(1) << (BUCKET_BITS[k] - 1);
+            auto const v = dod + half - 1;
+            if(v < 2 * half) {
+                Unary::encode(sink, k + 1);
+                Binary::encode(sink, v, BUCKET_BITS[k]);
+                return;
+            }
+        }
+        sink.write(UINTMAX_MAX, NUM_BUCKETS);
+        Binary::encode(sink, dod, 64);
+    }
+
+    template<BitSource Source>
+    uint64_t decode_timestamp(Source& src) {
+        size_t k = 0;
+        while(k < NUM_BUCKETS && src.read()) ++k;
+
+        uint64_t dod;
+        if(k == 0) {
+            dod = 0;
+        } else if(k < NUM_BUCKETS) {
+            auto const half = uint64_t(1) << (BUCKET_BITS[k - 1] - 1);
+            dod = (uint64_t)Binary::decode(src, BUCKET_BITS[k - 1]) - half + 1;
+        } else {
+            dod = (uint64_t)Binary::decode(src, 64);
+        }
+
+        prev_delta_ += dod;
+        prev_timestamp_ += prev_delta_;
+        return prev_timestamp_;
+    }
+
+    template<BitSink Sink>
+    void encode_value(Sink& sink, uint64_t const value) {
+        auto const x = value ^ prev_value_;
+        prev_value_ = value;
+
+        if(x == 0) {
+            sink.write(0);
+            return;
+        }
+        sink.write(1);
+
+        auto const leading = std::min((uint8_t)std::countl_zero(x), MAX_LEADING);
+        auto const trailing = (uint8_t)std::countr_zero(x);
+        if(prev_leading_ != NO_WINDOW && leading >= prev_leading_ && trailing >= prev_trailing_) {
+            // reuse the previous window
+            sink.write(0);
+            Binary::encode(sink, x >> prev_trailing_, 64 - prev_leading_ - prev_trailing_);
+        } else {
+            auto const len = 64 - leading - trailing;
+            sink.write(1);
+            Binary::encode(sink, leading, LEADING_BITS);
+            Binary::encode(sink, len - 1, LENGTH_BITS);
+            Binary::encode(sink, x >> trailing, len);
+            prev_leading_ = leading;
+            prev_trailing_ = trailing;
+        }
+    }
+
+    template<BitSource Source>
+    uint64_t decode_value(Source& src) {
+        if(src.read()) {
+            if(src.read()) {
+                prev_leading_ = (uint8_t)Binary::decode(src, LEADING_BITS);
+                auto const len = (uint8_t)Binary::decode(src, LENGTH_BITS) + 1;
+                prev_trailing_ = 64 - prev_leading_ - len;
+            }
+            auto const len = 64 - prev_leading_ - prev_trailing_;
+            prev_value_ ^= (uint64_t)Binary::decode(src, len) << prev_trailing_;
+        }
+        return prev_value_;
+    }
+
+public:
+    /**
+     * \brief Constructs a coder in the initial state
+     */
+    Gorilla() {
+        reset();
+    }
+
+    /**
+     * \brief Resets the coder to its initial state to begin a new time series
+     */
+    void reset() {
+        first_ = true;
+        prev_timestamp_ = 0;
+        prev_delta_ = 0;
+        prev_value_ = 0;
+        prev_leading_ = NO_WINDOW;
+        prev_trailing_ = 0;
+    }
+
+    /**
+     * \brief Encodes the next data point of the time series
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param timestamp the timestamp
+     * \param value the value
+     */
+    template<BitSink Sink>
+    void encode(Sink& sink, int64_t const timestamp, double const value) {
+        auto const bits = std::bit_cast<uint64_t>(value);
+        if(first_) {
+            Binary::encode(sink, (uint64_t)timestamp, 64);
+            Binary::encode(sink, bits, 64);
+            prev_timestamp_ = (uint64_t)timestamp;
+            prev_value_ = bits;
+            first_ = false;
+        } else {
+            encode_timestamp(sink, (uint64_t)timestamp);
+            encode_value(sink, bits);
+        }
+    }
+
+    /**
+     * \brief Encodes the next data point of the time series
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param p the data point
+     */
+    template<BitSink Sink>
+    void encode(Sink& sink, GorillaPoint const& p) {
+        encode(sink, p.timestamp, p.value);
+    }
+
+    /**
+     * \brief Decodes the next data point of the time series
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \return the decoded data point
+     */
+    template<BitSource Source>
+    GorillaPoint decode(Source& src) {
+        if(first_) {
+            prev_timestamp_ = (uint64_t)Binary::decode(src, 64);
+            prev_value_ = (uint64_t)Binary::decode(src, 64);
+            first_ = false;
+            return GorillaPoint { (int64_t)prev_timestamp_, std::bit_cast<double>(prev_value_) };
+        } else {
+            auto const timestamp = decode_timestamp(src);
+            auto const value = decode_value(src);
+            return GorillaPoint { (int64_t)timestamp, std::bit_cast<double>(value) };
+        }
+    }
+
+    /**
+     * \brief Saves the state of the coder
+     * 
+     * \param state the state words to append to
+     */
+    void save_state(std::vector<uint64_t>& state) const {
+        state.push_back(uint64_t(first_) | (uint64_t(prev_leading_) << 8) | (uint64_t(prev_trailing_) << 16));
+        state.push_back(prev_timestamp_);
+        state.push_back(prev_delta_);
+        state.push_back(prev_value_);
+    }
+
+    /**
+     * \brief Restores the state of the coder
+     * 
+     * \param state the state words, which are advanced past the restored state
+     */
+    void load_state(uint64_t const*& state) {
+        auto const flags = *state++;
+        first_ = flags & 1;
+        prev_leading_ = uint8_t(flags >> 8);
+        prev_trailing_ = uint8_t(flags >> 16);
+        prev_timestamp_ = *state++;
+        prev_delta_ = *state++;
+        prev_value_ = *state++;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,210 @@
+/**
+ * code/group_varint.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_GROUP_VARINT_HPP
+#define _CODE_GROUP_VARINT_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+
+namespace code {
+
+namespace internal {
+
+struct GroupVarintEntry {
+    uint8_t shuffle[16];
+    uint8_t length;
+};
+
+constexpr std::array<GroupVarintEntry, 256> make_group_varint_table() {
+    std::array<GroupVarintEntry, 256> table {};
+    for(size_t tag = 0; tag < 256; tag++) {
+        auto& e = table[tag];
+        uint8_t src = 0;
+        for(size_t i = 0; i < 4; i++) {
+            size_t const len = ((tag >> (2 * i)) & 3) + 1;
+            for(size_t b = 0; b < 4; b++) {
+                e.shuffle[4 * i + b] = b < len ? src++ : 0x80; // nb: 0x80 yields a zero byte
+            }
+        }
+        e.length = src;
+    }
+    return table;
+}
+
+}
+
+/**
+ * \brief Group Varint encoding and decoding of 32-bit integers
+ * 
+ * Integers are encoded in groups of four. Each group starts with a tag byte, which contains the number of bytes minus one
+ * of each integer in two bits (the first integer in the lowest two bits), followed by the integers' bytes in little endian order.
+ * If the number of integers is not a multiple of four, the last group is padded with zeros.
+ * 
+ * Compared to \ref code::Vbyte "Vbyte", decoding does not need to test a continuation bit for every byte.
+ * Instead, the tag byte is used as an index into a precomputed table that contains the group's total length.
+ * If SSSE3 is available, the table also contains a shuffle mask that distributes the bytes of all four integers at once.
+ */
+class GroupVarint {
+private:
+    static constexpr auto TABLE = internal::make_group_varint_table();
+
+    static constexpr uint32_t MASK[4] = { 0xFFU, 0xFFFFU, 0xFFFFFFU, 0xFFFFFFFFU };
+
+    inline static uint32_t load32(uint8_t const* p) {
+        uint32_t x;
+        std::memcpy(&x, p, 4);
+        if constexpr(std::endian::native == std::endian::big) x = __builtin_bswap32(x);
+        return x;
+    }
+
+    inline static size_t byte_length(uint32_t const x) {
+        return x ? (std::bit_width(x) + 7) / 8 : 1;
+    }
+
+    // decodes a group, possibly reading up to three bytes beyond it
+    inline static uint8_t const* decode_group(uint8_t const* in, uint32_t* out) {
+        auto const tag = *in++;
+        for(size_t i = 0; i < 4; i++) {
+            auto const len = (tag >> (2 * i)) & 3;
+            out[i] = load32(in) & MASK[len];
+            in += len + 1;
+        }
+        return in;
+    }
+
+    // decodes a group without reading beyond it
+    inline static uint8_t const* decode_group_safe(uint8_t const* in, uint32_t* out, size_t const num) {
+        auto const tag = *in++;
+        for(size_t i = 0; i < 4; i++) {
+            size_t const len = ((tag >> (2 * i)) & 3) + 1;
+            uint32_t x = 0;
+            for(size_t b = 0; b < len; b++) x |= uint32_t(in[b]) << (8 * b);
+            if(i < num) out[i] = x;
+            in += len;
+        }
+        return in;
+    }
+
+public:
+    /**
+     * \brief Reports the maximum size of the encoding of the given number of integers
+     * 
+     * \param num the number of integers
+     * \return the maximum size in bytes
+     */
+    inline static constexpr size_t max_size(size_t const num) {
+        return ((num + 3) / 4) * 17;
+    }
+
+    /**
+     * \brief Encodes a sequence of integers
+     * 
+     * \param out the output buffer, which must have space for at least \ref max_size "max_size(num)" bytes
+     * \param in the integers to encode
+     * \param num the number of integers
+     * \return a pointer to the first byte following the encoding
+     */
+    static uint8_t* encode(uint8_t* out, uint32_t const* in, size_t const num) {
+        for(size_t i = 0; i < num; i += 4) {
+            auto* tag = out++;
+            *tag = 0;
+            for(size_t j = 0; j < 4; j++) {
+                auto const x = (i + j < num) ? in[i + j] : 0;
+                auto const len = byte_length(x);
+                *tag |= uint8_t((len - 1) << (2 * j));
+                for(size_t b = 0; b < len; b++) *out++ = uint8_t(x >> (8 * b));
+            }
+        }
+        return out;
+    }
+
+    /**
+     * \brief Decodes a sequence of integers
+     * 
+     * The input is not read beyond the end of the encoding.
+     * 
+     * \param in the encoded input
+     * \param out the output, which must have space for \c num integers
+     * \param num the number of integers
+     * \return a pointer to the first byte following the encoding
+     */
+    static uint8_t const* decode(uint8_t const* in, uint32_t* out, size_t const num) {
+        auto const groups = (num + 3) / 4;
+        size_t g = 0;
+
+        #ifdef __SSSE3__
+        // nb: loading 16 bytes following a tag is safe if at least three more groups follow, as each group has at least five bytes
+        for(; g + 3 < groups; g++) {
+            auto const& e = TABLE[*in];
+            auto const data = _mm_loadu_si128((__m128i const*)(in + 1));
+            _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(data, _mm_loadu_si128((__m128i const*)e.shuffle)));
+            in += 1 + e.length;
+            out += 4;
+        }
+        #endif
+
+        // nb: reading up to three bytes beyond a group is safe if another group follows
+        for(; g + 1 < groups; g++) {
+            in = decode_group(in, out);
+            out += 4;
+        }
+
+        if(g < groups) {
+            in = decode_group_safe(in, out, num - 4 * g);
+        }
+        return in;
+    }
+
+    /**
+     * \brief Computes the size of the encoding of the given number of integers without decoding them
+     * 
+     * \param in the encoded input
+     * \param num the number of integers
+     * \return the size of the encoding in bytes
+     */
+    static size_t size(uint8_t const* in, size_t const num) {
+        auto const groups = (num + 3) / 4;
+        size_t total = 0;
+        for(size_t g = 0; g < groups; g++) {
+            auto const len = 1 + TABLE[in[total]].length;
+            total += len;
+        }
+        return total;
+    }
+};
+
+}
+
+#endif
@@ -28,10 +28,17 @@
 #ifndef _CODE_HUFFMAN_HPP
 #define _CODE_HUFFMAN_HPP
 
+#include <optional>
+
+#include "bit_feed.hpp"
 #include "concepts.hpp"
 #include "huffman_code.hpp"
+#include "huffman_packed_table.hpp"
 #include "huffman_tree.hpp"
 
+#include "internal/huffman_simd.hpp"
+#include "internal/word_packer.hpp"
+
 namespace code {
 
 /**
@@ -90,6 +97,56 @@ public:
         }
     }
 
+    /**
+     * \brief Encodes a sequence of characters using the Huffman codes given by the specified packed Huffman table
+     * 
+     * The codewords are merged into 64-bit words before being written to the sink.
+     * If available, AVX-512 or AVX2 is used to gather and merge the codewords of multiple characters at once;
+     * blocks containing long codewords and the remainder of the input are encoded using scalar code.
+     * 
+     * The output is identical to that of calling \ref encode for each character, provided that the sink's
+     * \c write(bits, num) writes the lowest bit first (as in iopp).
+     * The behaviour of this function is undefined if any character is not known by the table.
+     * 
+     * \tparam Sink the bit sink type
+     * \tparam Char the character type
+     * \param sink the bit sink
+     * \param input the characters to encode
+     * \param num the number of characters to encode
+     * \param table the packed Huffman table
+     */
+    template<BitSink Sink, std::integral Char>
+    static void encode_bulk(Sink& sink, Char const* input, size_t const num, HuffmanPackedTable const& table) {
+        using UChar = std::make_unsigned_t<Char>;
+
+        internal::WordPacker<Sink> packer(sink);
+        auto encode_scalar = [&](size_t const i, size_t const n){
+            for(size_t j = i; j < i + n; j++) {
+                auto const e = table.entry((UChar)input[j]);
+                if(HuffmanPackedTable::length(e) != HuffmanPackedTable::ESCAPE) [[likely]] {
+                    packer.append(HuffmanPackedTable::word(e), HuffmanPackedTable::length(e));
+                } else {
+                    auto const code = table[(UChar)input[j]];
+                    packer.append(code.word, code.length);
+                }
+            }
+        };
+
+        size_t i = 0;
+        if constexpr(sizeof(Char) <= 4) {
+            #if defined(__AVX512F__)
+            for(; i + internal::HUFFMAN_AVX512_BLOCK <= num; i += internal::HUFFMAN_AVX512_BLOCK) {
+                if(!internal::huffman_encode_avx512(packer, input + i, table)) encode_scalar(i, internal::HUFFMAN_AVX512_BLOCK);
+            }
+            #elif defined(__AVX2__)
+            for(; i + internal::HUFFMAN_AVX2_BLOCK <= num; i += internal::HUFFMAN_AVX2_BLOCK) {
+                if(!internal::huffman_encode_avx2(packer, input + i, table)) encode_scalar(i, internal::HUFFMAN_AVX2_BLOCK);
+            }
+            #endif
+        }
+        encode_scalar(i, num - i);
+    }
+
     /**
      * \brief Decodes a Huffman code and reports the corresponding integer
      * 
@@ -178,6 +235,50 @@ public:
          */
         template<BitSource Source> uintmax_t decode(Source& src, Universe u = Universe::umax()) { return Huffman::decode(src, *nav_); }
     };
+
+    /**
+     * \brief Resumable decoding of Huffman codes from input that arrives in chunks
+     * 
+     * The current position in the Huffman tree is kept across calls, so decoding continues where the input ended.
+     * 
+     * \tparam TreeNavigator the Huffman tree navigator type
+     */
+    template<HuffmanTreeNavigator TreeNavigator>
+    class ResumableDecoder {
+    private:
+        TreeNavigator const* root_;
+        TreeNavigator const* v_;
+
+    public:
+        /**
+         * \brief Constructs a resumable Huffman decoder
+         * 
+         * \param root the root of the Huffman tree used for decoding
+         */
+        ResumableDecoder(TreeNavigator const& root) : root_(&root), v_(&root) { }
+
+        /**
+         * \brief Decodes a Huffman code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded integer, or nothing if the feed has run out of bits before a leaf was reached
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed) {
+            while(!v_->is_leaf()) {
+                if(!feed.available()) return std::nullopt;
+                v_ = feed.read() ? &v_->right_child() : &v_->left_child();
+            }
+
+            auto const x = (uintmax_t)**v_;
+            v_ = root_;
+            return x;
+        }
+
+        /**
+         * \brief Returns to the root of the Huffman tree, discarding the partially decoded codeword
+         */
+        void reset() { v_ = root_; }
+    };
 };
 
 }
@@ -0,0 +1,216 @@
+/**
+ * code/huffman_packed_table.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_HUFFMAN_PACKED_TABLE_HPP
+#define _CODE_HUFFMAN_PACKED_TABLE_HPP
+
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "huffman_code.hpp"
+#include "universe.hpp"
+
+namespace code {
+
+/**
+ * \brief A compact Huffman table
+ * 
+ * The table covers exactly the universe of represented characters and stores one 32-bit entry per character.
+ * The lowest \ref WORD_BITS bits of an entry contain the codeword in LSBF order, and the highest \ref LENGTH_BITS bits contain its length.
+ * Entries of characters that are not represented have length zero.
+ * 
+ * Codewords longer than \ref MAX_LENGTH bits, which only occur for extremely skewed distributions, are marked by the length \ref ESCAPE
+ * and their word field holds an index into a side table of full \ref code::HuffmanCode "HuffmanCode" objects.
+ * 
+ * The entries are allocated on the heap once and are immutable afterwards.
+ * Copies of a table share the same entries, so a table can be cheaply passed to and concurrently used by multiple threads.
+ * 
+ * This class satisfies the \ref code::HuffmanCodeProvider "HuffmanCodeProvider" concept.
+ */
+class HuffmanPackedTable {
+public:
+    /**
+     * \brief The number of bits available for a codeword in a table entry
+     */
+    static constexpr size_t WORD_BITS = 27;
+
+    /**
+     * \brief The number of bits used for the codeword length in a table entry
+     */
+    static constexpr size_t LENGTH_BITS = 5;
+
+    /**
+     * \brief The maximum length of a codeword that is stored directly in a table entry
+     */
+    static constexpr size_t MAX_LENGTH = WORD_BITS;
+
+    /**
+     * \brief The length value marking entries that refer to the side table of long codewords
+     */
+    static constexpr uint32_t ESCAPE = (uint32_t(1) << LENGTH_BITS) - 1;
+
+    /**
+     * \brief The mask to extract the codeword from a table entry
+     */
+    static constexpr uint32_t WORD_MASK = (uint32_t(1) << WORD_BITS) - 1;
+
+    /**
+     * \brief Extracts the codeword length from a table entry
+     * 
+     * \param entry the table entry
+     * \return the codeword length, or \ref ESCAPE for long codewords
+     */
+    inline static constexpr size_t length(uint32_t const entry) { return entry >> WORD_BITS; }
+
+    /**
+     * \brief Extracts the codeword from a table entry
+     * 
+     * \param entry the table entry
+     * \return the codeword in LSBF order, or the side table index for long codewords
+     */
+    inline static constexpr uintmax_t word(uint32_t const entry) { return entry & WORD_MASK; }
+
+private:
+    uintmax_t min_;
+    size_t size_;
+    std::shared_ptr<uint32_t[]> entries_;
+    std::shared_ptr<std::vector<HuffmanCode> const> long_codes_;
+
+public:
+    /**
+     * \brief Constructs an empty table
+     */
+    HuffmanPackedTable() : min_(0), size_(0) {
+    }
+
+    /**
+     * \brief Constructs a table for the given characters and their Huffman codes
+     * 
+     * \tparam It the input iterator type, whose values must be pairs of characters and their Huffman codes
+     * \param u the universe of characters, which must contain all input characters
+     * \param begin the beginning of the input
+     * \param end the end of the input
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, std::pair<uintmax_t, HuffmanCode>>
+    HuffmanPackedTable(Universe const& u, It begin, It const end) : min_(u.min()), size_(u.delta() + 1) {
+        entries_ = std::make_shared<uint32_t[]>(size_); // nb: value-initialized, i.e., all entries are zero
+
+        std::vector<HuffmanCode> long_codes;
+        while(begin != end) {
+            std::pair<uintmax_t, HuffmanCode> const e = *begin++;
+            auto const& code = e.second;
+            assert(e.first >= min_ && e.first - min_ < size_);
+
+            if(code.length <= MAX_LENGTH) {
+                entries_[e.first - min_] = uint32_t(code.word) | (uint32_t(code.length) << WORD_BITS);
+            } else {
+                entries_[e.first - min_] = uint32_t(long_codes.size()) | (ESCAPE << WORD_BITS);
+                long_codes.push_back(code);
+            }
+        }
+
+        if(!long_codes.empty()) {
+            long_codes_ = std::make_shared<std::vector<HuffmanCode> const>(std::move(long_codes));
+        }
+    }
+
+    HuffmanPackedTable(HuffmanPackedTable const&) = default;
+    HuffmanPackedTable(HuffmanPackedTable&&) = default;
+    HuffmanPackedTable& operator=(HuffmanPackedTable const&) = default;
+    HuffmanPackedTable& operator=(HuffmanPackedTable&&) = default;
+
+    /**
+     * \brief Retrieves the Huffman code for the given character
+     * 
+     * The behaviour of this function is undefined if the character is not contained in the table's universe.
+     * 
+     * \param c the character
+     * \return the Huffman code for the character, which has length zero if the character is not represented
+     */
+    HuffmanCode operator[](uintmax_t const c) const {
+        auto const e = entry(c);
+        auto const len = length(e);
+        if(len != ESCAPE) [[likely]] {
+            return { word(e), len };
+        } else {
+            return (*long_codes_)[word(e)];
+        }
+    }
+
+    /**
+     * \brief Retrieves the raw table entry for the given character
+     * 
+     * The behaviour of this function is undefined if the character is not contained in the table's universe.
+     * 
+     * \param c the character
+     * \return the table entry
+     */
+    uint32_t entry(uintmax_t const c) const {
+        assert(c - min_ < size_);
+        return entries_[c - min_];
+    }
+
+    /**
+     * \brief Provides direct read-only access to the table entries
+     * 
+     * The entry for a character \c c is located at index \c c-min() .
+     * 
+     * \return a pointer to the first table entry
+     */
+    uint32_t const* data() const { return entries_.get(); }
+
+    /**
+     * \brief Reports the smallest character covered by the table
+     * 
+     * \return the smallest character covered by the table
+     */
+    uintmax_t min() const { return min_; }
+
+    /**
+     * \brief Reports the number of table entries
+     * 
+     * This equals the size of the universe of represented characters.
+     * 
+     * \return the number of table entries
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * \brief Reports whether the table contains codewords that exceed \ref MAX_LENGTH bits
+     * 
+     * \return true iff there are long codewords
+     */
+    bool has_long_codes() const { return (bool)long_codes_; }
+};
+
+}
+
+#endif
@@ -32,14 +32,18 @@
 #include <array>
 #include <cassert>
 #include <concepts>
+#include <optional>
 #include <queue>
+#include <ranges>
 #include <vector>
 #include <unordered_map>
 #include <utility>
 
+#include "bit_feed.hpp"
 #include "concepts.hpp"
 #include "counter.hpp"
 #include "huffman_code.hpp"
+#include "huffman_packed_table.hpp"
 #include "elias_delta.hpp"
 
 namespace code {
@@ -247,12 +251,13 @@ public:
         return tree.table();
     }
 
-private:
+protected:
     std::vector<Node> nodes_;
 
     Node const* root_;
     std::unordered_map<Char, Node const*> leaves_;
 
+private:
     template<Histogram<Char> H>
     void build_from_histogram(H const& histogram) {
         // define max-priority queue of tree nodes
@@ -266,6 +271,12 @@ private:
         };
         std::priority_queue<Node*, std::vector<Node*>, FreqCompare> queue;
 
+        if(histogram.size() == 0) {
+            // histogram is empty
+            root_ = nullptr;
+            return;
+        }
+
         // construct and enqueue leaves
         nodes_.reserve(2 * histogram.size());
         leaves_.reserve(histogram.size());
@@ -379,27 +390,44 @@ private:
     }
 
     using BitVectorIterator = std::vector<bool>::const_iterator;
+    using CharIterator = typename std::vector<Char>::const_iterator;
 
-    template<BitSource Source>
-    Node* decode_node(Source& src, BitVectorIterator& bits, Universe const& u) {
+    Node* build_node(BitVectorIterator& bits, CharIterator& chars) {
         bool const b = *bits++;
         if(b) {
-            // decode character and construct leaf
-            auto const c = (Char)Binary::decode(src, u);
+            // construct leaf
+            auto const c = *chars++;
             nodes_.emplace_back(c, 0); // no weight
             
             auto* v = &nodes_.back();
             leaves_.emplace(c, v);
             return v;
         } else {
-            // decode children and construct inner node
-            auto* l = decode_node(src, bits, u);
-            auto* r = decode_node(src, bits, u);
+            // construct children and inner node
+            auto* l = build_node(bits, chars);
+            auto* r = build_node(bits, chars);
             nodes_.emplace_back(*l, *r);
             return &nodes_.back();
         }
     }
 
+    void build_from_topology(std::vector<bool> const& topology, std::vector<Char> const& chars) {
+        if(topology.size() > 1) {
+            // allocate
+            nodes_.reserve(topology.size());
+            leaves_.reserve(chars.size());
+
+            // build the tree
+            auto bits = topology.cbegin();
+            auto it = chars.cbegin();
+            root_ = build_node(bits, it);
+            assert(bits == topology.cend() && it == chars.cend());
+        } else {
+            // we have an empty tree
+            root_ = nullptr;
+        }
+    }
+
 public:
     /**
      * \brief Decodes a Huffman tree from the given bit source
@@ -411,30 +439,148 @@ public:
      */
     template<BitSource Source>
     HuffmanTree(Source& src) {
-        // first, decode the topology so we can properly allocate our nodes array
+        // first, decode the topology so we know the number of characters
         std::vector<bool> topology;
         size_t alphabet_size = 0;
         
         decode_topology(src, topology, alphabet_size);
-        if(topology.size() > 1) {
-            // allocate
-            nodes_.reserve(topology.size());
-            leaves_.reserve(alphabet_size);
 
+        std::vector<Char> chars;
+        if(topology.size() > 1) {
             // second, decode the universe of characters
             auto const min = EliasDelta::decode(src, Universe::umax());
             auto const max = EliasDelta::decode(src, Universe::at_least(min));
             Universe u(min, max);
             
-            // build the tree and decode characters
-            auto bits = topology.cbegin();
-            root_ = decode_node(src, bits, u);
-        } else {
-            // we have decoded an empty tree
-            root_ = nullptr;
+            // decode characters
+            chars.reserve(alphabet_size);
+            for(size_t i = 0; i < alphabet_size; i++) chars.push_back((Char)Binary::decode(src, u));
         }
+        build_from_topology(topology, chars);
+    }
+
+    /**
+     * \brief Constructs a Huffman tree from its topology and characters
+     * 
+     * The topology is given in pre-order, where inner nodes are represented by a 0-bit and leaves are represented by a 1-bit, as written by \ref encode.
+     * 
+     * \param topology the tree topology
+     * \param chars the characters represented by the leaves in left-to-right order
+     */
+    HuffmanTree(std::vector<bool> const& topology, std::vector<Char> const& chars) {
+        build_from_topology(topology, chars);
     }
 
+    /**
+     * \brief Resumable decoding of Huffman trees from input that arrives in chunks
+     * 
+     * The decoder proceeds in phases, decoding the topology, the universe of characters and the characters, where each phase keeps its progress
+     * across calls. The tree is constructed once all of it has been decoded.
+     */
+    class ResumableDecoder {
+    private:
+        enum class Phase {
+            /// \brief Decoding the tree topology
+            topology,
+            /// \brief Decoding the minimum character
+            min,
+            /// \brief Decoding the maximum character
+            max,
+            /// \brief Decoding the characters
+            chars
+        };
+
+        Phase phase_;
+        std::vector<bool> topology_;
+        size_t pending_; // the number of subtrees whose topology has not yet been decoded
+        size_t alphabet_size_;
+        uintmax_t min_;
+        EliasDelta::ResumableDecoder delta_;
+        Binary::ResumableDecoder binary_;
+        std::vector<Char> chars_;
+
+    public:
+        /**
+         * \brief Constructs a decoder in the initial state
+         */
+        ResumableDecoder() {
+            reset();
+        }
+
+        /**
+         * \brief Decodes a Huffman tree as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded Huffman tree, or nothing if the feed has run out of bits before the tree was complete
+         */
+        std::optional<HuffmanTree> decode(BitFeed& feed) {
+            if(phase_ == Phase::topology) {
+                while(pending_ > 0) {
+                    if(!feed.available()) return std::nullopt;
+
+                    bool const b = feed.read();
+                    topology_.push_back(b);
+                    if(b) {
+                        // leaf
+                        --pending_;
+                        ++alphabet_size_;
+                    } else {
+                        // inner node, its two children replace it
+                        ++pending_;
+                    }
+                }
+
+                if(topology_.size() == 1) {
+                    // we have decoded an empty tree
+                    reset();
+                    return HuffmanTree();
+                }
+                phase_ = Phase::min;
+            }
+
+            if(phase_ == Phase::min) {
+                auto const min = delta_.decode(feed, Universe::umax());
+                if(!min) return std::nullopt;
+
+                min_ = *min;
+                phase_ = Phase::max;
+            }
+
+            if(phase_ == Phase::max) {
+                auto const max = delta_.decode(feed, Universe::at_least(min_));
+                if(!max) return std::nullopt;
+
+                binary_.reset(Universe(min_, *max).entropy());
+                chars_.reserve(alphabet_size_);
+                phase_ = Phase::chars;
+            }
+
+            while(chars_.size() < alphabet_size_) {
+                auto const c = binary_.decode(feed);
+                if(!c) return std::nullopt;
+                chars_.push_back((Char)(min_ + *c));
+            }
+
+            HuffmanTree tree(topology_, chars_);
+            reset();
+            return tree;
+        }
+
+        /**
+         * \brief Discards the partially decoded tree
+         */
+        void reset() {
+            phase_ = Phase::topology;
+            topology_.clear();
+            pending_ = 1;
+            alphabet_size_ = 0;
+            min_ = 0;
+            delta_.reset();
+            binary_.reset();
+            chars_.clear();
+        }
+    };
+
     /**
      * \brief Computes the Huffman code for the given character
      * 
@@ -464,17 +610,21 @@ public:
      * 
      * This involves precomputing the Huffman codes for all input characters and constructing a mapping from character to code.
      * The returned object satisfies the \ref tdc::code::HuffmanCodeProvider "HuffmanCodeProvider" concept.
+     * For 8-bit characters, it is an array, for 16-bit characters, it is a \ref packed_table "packed table", and for larger characters, it is a hash table.
      * 
      * \return a mapping from all input characters to their Huffman codes
      */
     auto table() const {
-        if constexpr(std::numeric_limits<UChar>::max() <= UINT16_MAX) {
-            // for 8-bit and 16-bit characters, we can afford building an array
+        if constexpr(std::numeric_limits<UChar>::max() <= UINT8_MAX) {
+            // for 8-bit characters, we can afford building an array
             std::array<HuffmanCode, std::numeric_limits<UChar>::max() + 1> table;
             for(auto e : leaves_) {
                 table[(UChar)e.first] = e.second->code();
             }
             return table;
+        } else if constexpr(std::numeric_limits<UChar>::max() <= UINT16_MAX) {
+            // for 16-bit characters, a full array would take up a megabyte, so we use a packed table over the actual alphabet instead
+            return packed_table();
         } else {
             // for larger alphabets, we use hashing instead
             HashCodeTable table;
@@ -486,6 +636,28 @@ public:
         }
     }
 
+    /**
+     * \brief Computes a packed Huffman table
+     * 
+     * The table contains a 32-bit entry for each character in the universe spanned by the input characters.
+     * It is allocated on the heap and may be shared across threads; refer to \ref code::HuffmanPackedTable "HuffmanPackedTable" for details.
+     * 
+     * \return a packed mapping from all input characters to their Huffman codes
+     */
+    HuffmanPackedTable packed_table() const {
+        if(leaves_.empty()) return HuffmanPackedTable();
+
+        Range range;
+        for(auto e : leaves_) {
+            range.contain((UChar)e.first);
+        }
+
+        auto codes = leaves_ | std::views::transform([](auto const& e){
+            return std::pair<uintmax_t, HuffmanCode>((UChar)e.first, e.second->code());
+        });
+        return HuffmanPackedTable(Universe(range), codes.begin(), codes.end());
+    }
+
     /**
      * \brief Retrieves the root node of the Huffman tree
      * 
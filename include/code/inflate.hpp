@@ -0,0 +1,421 @@
+/**
+ * code/inflate.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INFLATE_HPP
+#define _CODE_INFLATE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "canonical_huffman.hpp"
+#include "internal/byte_bit_reader.hpp"
+#include "internal/checksums.hpp"
+#include "internal/deflate_tables.hpp"
+
+namespace code {
+
+/**
+ * \brief Results of decoding DEFLATE data
+ */
+enum class InflateStatus {
+    /// \brief The data has been decoded successfully
+    ok,
+    /// \brief The input ended prematurely
+    truncated,
+    /// \brief The zlib or gzip header is invalid
+    invalid_header,
+    /// \brief A block has the reserved block type
+    invalid_block_type,
+    /// \brief The length of a stored block does not match its complement
+    invalid_stored_length,
+    /// \brief The code lengths of a dynamic block do not describe a valid code
+    invalid_code,
+    /// \brief A literal/length symbol is invalid
+    invalid_symbol,
+    /// \brief A distance is invalid or refers to before the beginning of the output
+    invalid_distance,
+    /// \brief The checksum or size in the trailer does not match the decoded data
+    checksum_mismatch,
+    /// \brief The data requires a feature that is not supported, i.e., a preset dictionary
+    unsupported,
+};
+
+/**
+ * \brief Decoding of DEFLATE (RFC 1951) data as well as its zlib (RFC 1950) and gzip (RFC 1952) wrappers
+ * 
+ * Huffman codes are decoded using \ref code::CanonicalHuffmanDecoder "CanonicalHuffmanDecoder" tables.
+ * DEFLATE packs bits starting with the lowest bit of each byte, but transmits Huffman codewords starting with their most significant bit.
+ * Since the canonical codes are bit-reversed into the LSBF convention of \ref code::HuffmanCode "HuffmanCode",
+ * the input can be read as a plain LSBF bit stream and the upcoming bits can be used directly to index the decoding tables.
+ * 
+ * In the main loop, the bit buffer is refilled once per symbol such that a complete length/distance pair including all extra bits
+ * can be decoded without further checks.
+ * 
+ * The decoded data is appended to an output vector, which also serves as the window for back references.
+ * Malformed input is reported by means of an \ref code::InflateStatus "InflateStatus".
+ */
+class Inflate {
+private:
+    using Reader = internal::ByteBitReader;
+
+    static constexpr size_t LITLEN_PRIMARY_BITS = 10;
+    static constexpr size_t DIST_PRIMARY_BITS = 8;
+
+    static CanonicalHuffmanDecoder const& fixed_litlen() {
+        static CanonicalHuffmanDecoder const decoder = [](){
+            uint8_t lengths[internal::deflate::NUM_LITLEN];
+            std::fill(lengths, lengths + 144, 8);
+            std::fill(lengths + 144, lengths + 256, 9);
+            std::fill(lengths + 256, lengths + 280, 7);
+            std::fill(lengths + 280, lengths + 288, 8);
+            return CanonicalHuffmanDecoder(lengths, lengths + internal::deflate::NUM_LITLEN, LITLEN_PRIMARY_BITS);
+        }();
+        return decoder;
+    }
+
+    static CanonicalHuffmanDecoder const& fixed_dist() {
+        static CanonicalHuffmanDecoder const decoder = [](){
+            uint8_t lengths[internal::deflate::NUM_DIST];
+            std::fill(lengths, lengths + internal::deflate::NUM_DIST, 5);
+            return CanonicalHuffmanDecoder(lengths, lengths + internal::deflate::NUM_DIST, DIST_PRIMARY_BITS);
+        }();
+        return decoder;
+    }
+
+    // tests whether a decoder can be used for a literal/length or distance code
+    // nb: like zlib, we accept incomplete codes only if they consist of at most one codeword
+    static bool acceptable(CanonicalHuffmanDecoder const& decoder) {
+        return decoder.valid() && (decoder.complete() || decoder.max_length() <= 1);
+    }
+
+    static InflateStatus decode_dynamic_codes(Reader& r, CanonicalHuffmanDecoder& litlen, CanonicalHuffmanDecoder& dist) {
+        using namespace internal::deflate;
+
+        auto const hlit = r.read(5) + 257;
+        auto const hdist = r.read(5) + 1;
+        auto const hclen = r.read(4) + 4;
+        if(hlit > 286 || hdist > 30) return InflateStatus::invalid_code;
+
+        // decode the code length code
+        uint8_t codelen_lengths[NUM_CODELEN] = {};
+        for(size_t i = 0; i < hclen; i++) {
+            codelen_lengths[CODELEN_ORDER[i]] = r.read(3);
+        }
+        if(r.overrun()) return InflateStatus::truncated;
+
+        CanonicalHuffmanDecoder const codelen(codelen_lengths, codelen_lengths + NUM_CODELEN, MAX_CODELEN_LENGTH);
+        if(!codelen.complete()) return InflateStatus::invalid_code;
+
+        // decode the literal/length and distance code lengths, which are a single sequence
+        uint8_t lengths[NUM_LITLEN + NUM_DIST];
+        size_t const num = hlit + hdist;
+        size_t i = 0;
+        while(i < num) {
+            auto const sym = codelen.decode(r);
+            if(sym == CanonicalHuffmanDecoder::INVALID) return InflateStatus::invalid_code;
+
+            if(sym < 16) {
+                lengths[i++] = sym;
+            } else {
+                uint8_t value = 0;
+                size_t repeat;
+                if(sym == 16) {
+                    if(i == 0) return InflateStatus::invalid_code;
+                    value = lengths[i - 1];
+                    repeat = 3 + r.read(2);
+                } else if(sym == 17) {
+                    repeat = 3 + r.read(3);
+                } else {
+                    repeat = 11 + r.read(7);
+                }
+
+                if(i + repeat > num) return InflateStatus::invalid_code;
+                std::fill(lengths + i, lengths + i + repeat, value);
+                i += repeat;
+            }
+
+            if(r.overrun()) return InflateStatus::truncated;
+        }
+
+        // the end-of-block symbol must be encodable
+        if(lengths[END_OF_BLOCK] == 0) return InflateStatus::invalid_code;
+
+        litlen = CanonicalHuffmanDecoder(lengths, lengths + hlit, LITLEN_PRIMARY_BITS);
+        dist = CanonicalHuffmanDecoder(lengths + hlit, lengths + num, DIST_PRIMARY_BITS);
+        if(!acceptable(litlen) || !acceptable(dist)) return InflateStatus::invalid_code;
+        return InflateStatus::ok;
+    }
+
+    static InflateStatus decode_huffman_block(
+        Reader& r, CanonicalHuffmanDecoder const& litlen, CanonicalHuffmanDecoder const& dist,
+        std::vector<uint8_t>& out, size_t& pos, size_t const start) {
+
+        using namespace internal::deflate;
+
+        // nb: we keep some slack at the end of the output so that matches can be copied in chunks of eight bytes
+        constexpr size_t SLACK = MAX_MATCH + 8;
+
+        auto* o = out.data();
+        while(true) {
+            if(out.size() - pos < SLACK) {
+                out.resize(std::max(2 * out.size(), out.size() + SLACK));
+                o = out.data();
+            }
+
+            // refill the bit buffer, which is then sufficient for decoding a literal or a complete length/distance pair
+            r.ensure();
+            if(r.overrun()) return InflateStatus::truncated;
+
+            auto [sym, len] = litlen.lookup(r.buffer());
+            if(!len) return InflateStatus::invalid_symbol;
+            r.skip(len);
+
+            if(sym < 256) {
+                o[pos++] = uint8_t(sym);
+                continue;
+            }
+
+            if(sym == END_OF_BLOCK) return InflateStatus::ok;
+
+            // decode length
+            sym -= 257;
+            if(sym >= 29) return InflateStatus::invalid_symbol;
+            size_t const match_len = LENGTH_BASE[sym] + r.read(LENGTH_EXTRA[sym]);
+
+            // decode distance
+            auto [dsym, dlen] = dist.lookup(r.buffer());
+            if(!dlen || dsym >= 30) return InflateStatus::invalid_distance;
+            r.skip(dlen);
+            size_t const d = DIST_BASE[dsym] + r.read(DIST_EXTRA[dsym]);
+            if(d > pos - start) return InflateStatus::invalid_distance;
+
+            // copy match
+            auto* dst = o + pos;
+            auto const* src = dst - d;
+            if(d >= 8) {
+                // copy in chunks of eight bytes, which may write up to seven bytes beyond the match
+                for(size_t k = 0; k < match_len; k += 8) std::memcpy(dst + k, src + k, 8);
+            } else {
+                for(size_t k = 0; k < match_len; k++) dst[k] = src[k];
+            }
+            pos += match_len;
+        }
+    }
+
+    static InflateStatus decode_stored_block(Reader& r, std::vector<uint8_t>& out, size_t& pos) {
+        r.align();
+        auto const len = r.read(16);
+        auto const nlen = r.read(16);
+        if(r.overrun()) return InflateStatus::truncated;
+        if(len != (~nlen & 0xFFFF)) return InflateStatus::invalid_stored_length;
+
+        auto const in_pos = r.byte_pos();
+        if(in_pos + len > r.size()) return InflateStatus::truncated;
+
+        if(out.size() - pos < len) out.resize(pos + len);
+        std::memcpy(out.data() + pos, r.data() + in_pos, len);
+        pos += len;
+
+        r.seek(in_pos + len);
+        return InflateStatus::ok;
+    }
+
+    static InflateStatus inflate(Reader& r, std::vector<uint8_t>& out) {
+        size_t const start = out.size();
+        size_t pos = start;
+
+        CanonicalHuffmanDecoder litlen, dist;
+        auto status = InflateStatus::ok;
+        bool last = false;
+        while(!last && status == InflateStatus::ok) {
+            last = r.read(1);
+            auto const type = r.read(2);
+            if(r.overrun()) {
+                status = InflateStatus::truncated;
+                break;
+            }
+
+            switch(type) {
+                case 0:
+                    status = decode_stored_block(r, out, pos);
+                    break;
+
+                case 1:
+                    status = decode_huffman_block(r, fixed_litlen(), fixed_dist(), out, pos, start);
+                    break;
+
+                case 2:
+                    status = decode_dynamic_codes(r, litlen, dist);
+                    if(status == InflateStatus::ok) status = decode_huffman_block(r, litlen, dist, out, pos, start);
+                    break;
+
+                default:
+                    status = InflateStatus::invalid_block_type;
+                    break;
+            }
+        }
+
+        out.resize(pos);
+
+        // nb: if we consumed bits beyond the end of the input, any error is a consequence of that
+        if(r.overrun()) status = InflateStatus::truncated;
+        r.align();
+        return status;
+    }
+
+    static uint32_t load_le32(uint8_t const* p) {
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    static uint32_t load_be32(uint8_t const* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+public:
+    /**
+     * \brief Decodes raw DEFLATE data
+     * 
+     * \param in the input
+     * \param num the size of the input in bytes
+     * \param out the output vector, to which the decoded data is appended
+     * \param consumed if not null, receives the number of input bytes that make up the DEFLATE stream
+     * \return the decoding status
+     */
+    static InflateStatus inflate(uint8_t const* in, size_t const num, std::vector<uint8_t>& out, size_t* consumed = nullptr) {
+        Reader r(in, in + num);
+        auto const status = inflate(r, out);
+        if(consumed) *consumed = r.byte_pos();
+        return status;
+    }
+
+    /**
+     * \brief Decodes zlib data
+     * 
+     * Streams using a preset dictionary are not supported.
+     * 
+     * \param in the input
+     * \param num the size of the input in bytes
+     * \param out the output vector, to which the decoded data is appended
+     * \param consumed if not null, receives the number of input bytes that make up the zlib stream
+     * \return the decoding status
+     */
+    static InflateStatus zlib(uint8_t const* in, size_t const num, std::vector<uint8_t>& out, size_t* consumed = nullptr) {
+        if(consumed) *consumed = 0;
+
+        // decode header
+        if(num < 2) return InflateStatus::truncated;
+        auto const cmf = in[0];
+        auto const flg = in[1];
+        if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0) return InflateStatus::invalid_header;
+        if(flg & 0x20) return InflateStatus::unsupported;
+
+        // decode data
+        auto const start = out.size();
+        Reader r(in + 2, in + num);
+        auto const status = inflate(r, out);
+        if(status != InflateStatus::ok) return status;
+
+        // verify checksum
+        auto const end = 2 + r.byte_pos();
+        if(end + 4 > num) return InflateStatus::truncated;
+        if(load_be32(in + end) != internal::adler32(1, out.data() + start, out.size() - start)) return InflateStatus::checksum_mismatch;
+
+        if(consumed) *consumed = end + 4;
+        return InflateStatus::ok;
+    }
+
+    /**
+     * \brief Decodes gzip data
+     * 
+     * If the input consists of multiple concatenated gzip members, all of them are decoded.
+     * Data following the last member is ignored.
+     * 
+     * \param in the input
+     * \param num the size of the input in bytes
+     * \param out the output vector, to which the decoded data is appended
+     * \param consumed if not null, receives the number of input bytes that make up the gzip members
+     * \return the decoding status
+     */
+    static InflateStatus gzip(uint8_t const* in, size_t const num, std::vector<uint8_t>& out, size_t* consumed = nullptr) {
+        constexpr uint8_t FHCRC = 0x02, FEXTRA = 0x04, FNAME = 0x08, FCOMMENT = 0x10, FRESERVED = 0xE0;
+
+        if(consumed) *consumed = 0;
+
+        size_t p = 0;
+        do {
+            // decode header
+            if(num - p < 10) return InflateStatus::truncated;
+            if(in[p] != 0x1F || in[p + 1] != 0x8B || in[p + 2] != 8) return InflateStatus::invalid_header;
+            auto const flg = in[p + 3];
+            if(flg & FRESERVED) return InflateStatus::invalid_header;
+            p += 10;
+
+            if(flg & FEXTRA) {
+                if(num - p < 2) return InflateStatus::truncated;
+                size_t const xlen = in[p] | (in[p + 1] << 8);
+                if(num - p < 2 + xlen) return InflateStatus::truncated;
+                p += 2 + xlen;
+            }
+            for(auto const flag : { FNAME, FCOMMENT }) {
+                if(flg & flag) {
+                    auto const* z = (uint8_t const*)std::memchr(in + p, 0, num - p);
+                    if(!z) return InflateStatus::truncated;
+                    p = (z - in) + 1;
+                }
+            }
+            if(flg & FHCRC) {
+                if(num - p < 2) return InflateStatus::truncated;
+                p += 2;
+            }
+
+            // decode data
+            auto const start = out.size();
+            Reader r(in + p, in + num);
+            auto const status = inflate(r, out);
+            if(status != InflateStatus::ok) return status;
+            p += r.byte_pos();
+
+            // verify trailer
+            if(num - p < 8) return InflateStatus::truncated;
+            auto const size = out.size() - start;
+            if(load_le32(in + p) != internal::crc32(0, out.data() + start, size)) return InflateStatus::checksum_mismatch;
+            if(load_le32(in + p + 4) != uint32_t(size)) return InflateStatus::checksum_mismatch;
+            p += 8;
+
+            if(consumed) *consumed = p;
+        } while(num - p >= 2 && in[p] == 0x1F && in[p + 1] == 0x8B);
+
+        return InflateStatus::ok;
+    }
+};
+
+}
+
+#endif
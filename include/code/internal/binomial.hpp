@@ -0,0 +1,65 @@
+/**
+ * code/internal/binomial.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_BINOMIAL_HPP
+#define _CODE_INTERNAL_BINOMIAL_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace code::internal {
+
+constexpr size_t BINOMIAL_MAX_N = 64;
+
+constexpr std::array<std::array<uint64_t, BINOMIAL_MAX_N>, BINOMIAL_MAX_N> make_binomial_table() {
+    std::array<std::array<uint64_t, BINOMIAL_MAX_N>, BINOMIAL_MAX_N> table {};
+    for(size_t n = 0; n < BINOMIAL_MAX_N; n++) {
+        table[n][0] = 1;
+        for(size_t k = 1; k <= n; k++) table[n][k] = table[n - 1][k - 1] + (k < n ? table[n - 1][k] : 0);
+    }
+    return table;
+}
+
+constexpr auto BINOMIAL_TABLE = make_binomial_table();
+
+/**
+ * \brief Computes the binomial coefficient using a precomputed table
+ * 
+ * \param n the number of elements, less than 64
+ * \param k the number of chosen elements
+ * \return the binomial coefficient, or zero if \c k exceeds \c n
+ */
+constexpr inline uint64_t binomial(size_t const n, size_t const k) {
+    assert(n < BINOMIAL_MAX_N);
+    return k <= n ? BINOMIAL_TABLE[n][k] : 0;
+}
+
+}
+
+#endif
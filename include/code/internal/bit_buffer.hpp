@@ -0,0 +1,251 @@
+/**
+ * code/internal/bit_buffer.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_BIT_BUFFER_HPP
+#define _CODE_INTERNAL_BIT_BUFFER_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace code::internal {
+
+/**
+ * \brief A bit sink that appends bits to a vector of 64-bit words
+ * 
+ * Bits are written in LSBF order, i.e., the first bit is the lowest bit of the first word.
+ * The vector always ends with a zero word following the last word containing written bits, so that a \ref BitBufferSource may peek beyond the end of the stream.
+ * This satisfies the \ref code::BitSink "BitSink" concept.
+ */
+class BitBufferSink {
+private:
+    std::vector<uint64_t>* words_;
+    size_t size_;
+
+public:
+    /**
+     * \brief Constructs a sink that appends to the given vector, which must be empty
+     * 
+     * \param words the vector of words
+     */
+    inline BitBufferSink(std::vector<uint64_t>& words) : words_(&words), size_(0) {
+        assert(words.empty());
+        words.push_back(0);
+    }
+
+    /**
+     * \brief Constructs a sink that appends to the encoded stream contained in the given vector
+     * 
+     * The vector is truncated after the word containing the last bit of the stream, and the bits following the stream in that word are cleared.
+     * A zero word is then appended as padding.
+     * 
+     * \param words the vector of words
+     * \param num_bits the length of the encoded stream in bits
+     */
+    inline BitBufferSink(std::vector<uint64_t>& words, size_t const num_bits) : words_(&words), size_(num_bits) {
+        assert(64 * words.size() >= num_bits);
+        words.resize((num_bits + 63) / 64);
+        if(num_bits % 64) words.back() &= (uint64_t(1) << (num_bits % 64)) - 1;
+        words.push_back(0);
+    }
+
+    /**
+     * \brief Writes a single bit
+     * 
+     * \param bit the bit to write
+     */
+    inline void write(bool const bit) {
+        write(uint64_t(bit), 1);
+    }
+
+    /**
+     * \brief Writes the lowest bits of an integer, starting with the lowest bit
+     * 
+     * \param bits the bits to write
+     * \param num the number of bits to write, at most 64
+     */
+    inline void write(uint64_t bits, size_t const num) {
+        assert(num <= 64);
+        if(num == 0) return;
+        if(num < 64) bits &= (uint64_t(1) << num) - 1;
+
+        // nb: the word containing the next bit is either the last word containing bits or the padding word
+        auto const w = size_ / 64;
+        auto const o = size_ % 64;
+        (*words_)[w] |= bits << o;
+        if(o + num > 64) (*words_)[w + 1] = bits >> (64 - o);
+        if(o == 0 || o + num > 64) words_->push_back(0);
+        size_ += num;
+    }
+
+    /**
+     * \brief Does nothing, as bits are written to the vector immediately
+     */
+    inline void flush() {
+    }
+
+    /**
+     * \brief Reports the number of bits written so far
+     * 
+     * \return the number of bits written so far
+     */
+    inline size_t num_bits_written() const { return size_; }
+};
+
+/**
+ * \brief A bit sink that only counts the bits written to it
+ * 
+ * This is useful for computing the size of an encoding without producing it.
+ * This satisfies the \ref code::BitSink "BitSink" concept.
+ */
+class BitCounter {
+private:
+    size_t size_;
+
+public:
+    /**
+     * \brief Constructs a counter with no bits written
+     */
+    inline BitCounter() : size_(0) {
+    }
+
+    /**
+     * \brief Counts a single bit
+     */
+    inline void write(bool) { ++size_; }
+
+    /**
+     * \brief Counts the given number of bits
+     * 
+     * \param num the number of bits
+     */
+    inline void write(uint64_t, size_t const num) { size_ += num; }
+
+    /**
+     * \brief Does nothing
+     */
+    inline void flush() {
+    }
+
+    /**
+     * \brief Reports the number of bits written so far
+     * 
+     * \return the number of bits written so far
+     */
+    inline size_t num_bits_written() const { return size_; }
+};
+
+/**
+ * \brief A bit source that reads bits from an array of 64-bit words starting at an arbitrary bit position
+ * 
+ * Bits are read in LSBF order, matching \ref BitBufferSink.
+ * This satisfies the \ref code::PeekableBitSource "PeekableBitSource" and \ref code::SeekableBitSource "SeekableBitSource" concepts.
+ * Reading beyond the end of the array is not checked; peeking up to 64 bits beyond the last bit of a stream written by a \ref BitBufferSink is safe due to its padding word.
+ */
+class BitBufferSource {
+private:
+    uint64_t const* data_;
+    size_t pos_;
+
+public:
+    /**
+     * \brief Constructs a source reading from the given array
+     * 
+     * \param data the array of words
+     * \param pos the bit position to start reading from
+     */
+    inline BitBufferSource(uint64_t const* data, size_t const pos = 0) : data_(data), pos_(pos) {
+    }
+
+    /**
+     * \brief Reads a single bit
+     * 
+     * \return the bit read
+     */
+    inline bool read() {
+        bool const b = (data_[pos_ / 64] >> (pos_ % 64)) & 1;
+        ++pos_;
+        return b;
+    }
+
+    /**
+     * \brief Reads the given number of bits without advancing
+     * 
+     * \param num the number of bits to read, at most 64
+     * \return the bits, where the first bit is the lowest bit
+     */
+    inline uint64_t peek(size_t const num) const {
+        assert(num <= 64);
+        if(num == 0) return 0;
+
+        auto const w = pos_ / 64;
+        auto const o = pos_ % 64;
+        uint64_t bits = data_[w] >> o;
+        if(o + num > 64) bits |= data_[w + 1] << (64 - o);
+        return num < 64 ? (bits & ((uint64_t(1) << num) - 1)) : bits;
+    }
+
+    /**
+     * \brief Advances by the given number of bits
+     * 
+     * \param num the number of bits to skip
+     */
+    inline void skip(size_t const num) {
+        pos_ += num;
+    }
+
+    /**
+     * \brief Reads the given number of bits
+     * 
+     * \param num the number of bits to read, at most 64
+     * \return the bits, where the first bit is the lowest bit
+     */
+    inline uint64_t read(size_t const num) {
+        auto const bits = peek(num);
+        pos_ += num;
+        return bits;
+    }
+
+    /**
+     * \brief Reports the current bit position
+     * 
+     * \return the current bit position
+     */
+    inline size_t pos() const { return pos_; }
+
+    /**
+     * \brief Moves to the given bit position
+     * 
+     * \param pos the bit position
+     */
+    inline void seek(size_t const pos) { pos_ = pos; }
+};
+
+}
+
+#endif
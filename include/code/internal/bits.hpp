@@ -28,8 +28,13 @@
 #ifndef _CODE_INTERNAL_BITS_HPP
 #define _CODE_INTERNAL_BITS_HPP
 
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "../concepts.hpp"
 
 namespace code::internal {
 
@@ -43,6 +48,76 @@ constexpr inline uintmax_t set_bit(size_t const i) {
     return uintmax_t(1) << i;
 }
 
+/**
+ * \brief Concept for unsigned integer types wider than 64 bits, which bit sinks and sources can only transfer in multiple words
+ * 
+ * \tparam Int the integer type
+ */
+template<typename Int>
+concept WideUnsigned = std::unsigned_integral<Int> && (std::numeric_limits<Int>::digits > 64);
+
+/**
+ * \brief Concept for integer types that can be encoded
+ * 
+ * Integers of up to 64 bits are encoded as \c uintmax_t, whereas \ref WideUnsigned integers are encoded using their full width.
+ * 
+ * \tparam Int the integer type
+ */
+template<typename Int>
+concept EncodableInteger = std::integral<Int> && (std::numeric_limits<Int>::digits <= 64 || WideUnsigned<Int>);
+
+/**
+ * \brief The unsigned integer type that an integer of the given type is encoded as
+ * 
+ * \tparam Int the integer type
+ */
+template<EncodableInteger Int>
+using encoded_t = std::conditional_t<WideUnsigned<Int>, Int, uintmax_t>;
+
+/**
+ * \brief Writes the lowest bits of a wide integer, starting with the lowest bit
+ * 
+ * The bits are written in 64-bit words, i.e., using two calls to the sink for up to 128 bits.
+ * 
+ * \tparam Sink the bit sink type
+ * \tparam Int the integer type
+ * \param sink the bit sink
+ * \param x the bits to write
+ * \param num the number of bits to write
+ */
+template<BitSink Sink, WideUnsigned Int>
+inline void write_wide(Sink& sink, Int x, size_t num) {
+    while(num > 64) {
+        sink.write(uint64_t(x), 64);
+        x >>= 64;
+        num -= 64;
+    }
+    sink.write(uint64_t(x), num);
+}
+
+/**
+ * \brief Reads a wide integer, where the first bit read is the lowest bit
+ * 
+ * The bits are read in 64-bit words, i.e., using two calls to the source for up to 128 bits.
+ * 
+ * \tparam Int the integer type
+ * \tparam Source the bit source type
+ * \param src the bit source
+ * \param num the number of bits to read
+ * \return the bits read
+ */
+template<WideUnsigned Int, BitSource Source>
+inline Int read_wide(Source& src, size_t num) {
+    Int x = 0;
+    size_t shift = 0;
+    while(num > 64) {
+        x |= Int(src.read(64)) << shift;
+        shift += 64;
+        num -= 64;
+    }
+    return x | (Int(src.read(num)) << shift);
+}
+
 }
 
 #endif
@@ -0,0 +1,213 @@
+/**
+ * code/internal/byte_bit_reader.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_BYTE_BIT_READER_HPP
+#define _CODE_INTERNAL_BYTE_BIT_READER_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace code::internal {
+
+/**
+ * \brief Reads bits from a byte buffer, starting with the lowest bit of each byte
+ * 
+ * The reader keeps up to 64 upcoming bits in a buffer that is refilled using unaligned 64-bit loads where possible.
+ * Reading beyond the end of the input yields zero bits; whether this happened can be tested using \ref overrun.
+ * 
+ * This class satisfies the \ref code::PeekableBitSource "PeekableBitSource" concept.
+ */
+class ByteBitReader {
+private:
+    uint8_t const* begin_;
+    uint8_t const* pos_;
+    uint8_t const* end_;
+    uint64_t buffer_;
+    size_t size_;    // number of valid bits in buffer
+    size_t padding_; // number of zero bytes loaded beyond the end of the input
+
+    inline void refill() {
+        if(end_ - pos_ >= 8) {
+            uint64_t word;
+            std::memcpy(&word, pos_, 8);
+            if constexpr(std::endian::native == std::endian::big) word = __builtin_bswap64(word);
+            buffer_ |= word << size_;
+            pos_ += (63 - size_) >> 3;
+            size_ |= 56;
+        } else {
+            while(size_ <= 56) {
+                if(pos_ < end_) {
+                    buffer_ |= uint64_t(*pos_++) << size_;
+                } else {
+                    ++padding_;
+                }
+                size_ += 8;
+            }
+        }
+    }
+
+public:
+    /**
+     * \brief The maximum number of bits that can be peeked or read at once
+     */
+    static constexpr size_t MAX_BITS = 56;
+
+    /**
+     * \brief Constructs a reader for the given byte buffer
+     * 
+     * \param begin the beginning of the input
+     * \param end the end of the input
+     */
+    inline ByteBitReader(uint8_t const* begin, uint8_t const* end) : begin_(begin), pos_(begin), end_(end), buffer_(0), size_(0), padding_(0) {
+    }
+
+    /**
+     * \brief Ensures that at least \ref MAX_BITS bits are buffered
+     * 
+     * This allows for decoding multiple short codes in a row without further refills.
+     */
+    inline void ensure() {
+        if(size_ < MAX_BITS) refill();
+    }
+
+    /**
+     * \brief Retrieves the upcoming bits without extracting them
+     * 
+     * \param num the number of bits, at most \ref MAX_BITS
+     * \return the upcoming bits in LSBF order
+     */
+    inline uint64_t peek(size_t const num) {
+        assert(num <= MAX_BITS);
+        if(size_ < num) refill();
+        return buffer_ & ~(UINT64_MAX << num);
+    }
+
+    /**
+     * \brief Retrieves the buffered bits without refilling the buffer
+     * 
+     * \return the buffered bits in LSBF order, of which only \ref buffered are valid
+     */
+    inline uint64_t buffer() const { return buffer_; }
+
+    /**
+     * \brief Reports the number of buffered bits
+     * 
+     * \return the number of buffered bits
+     */
+    inline size_t buffered() const { return size_; }
+
+    /**
+     * \brief Discards bits
+     * 
+     * \param num the number of bits to discard, at most the number of buffered bits
+     */
+    inline void skip(size_t const num) {
+        assert(num <= size_);
+        buffer_ = num < 64 ? buffer_ >> num : 0;
+        size_ -= num;
+    }
+
+    /**
+     * \brief Reads a single bit
+     * 
+     * \return the bit
+     */
+    inline bool read() {
+        return (bool)read(1);
+    }
+
+    /**
+     * \brief Reads multiple bits
+     * 
+     * \param num the number of bits, at most \ref MAX_BITS
+     * \return the bits in LSBF order
+     */
+    inline uint64_t read(size_t const num) {
+        auto const bits = peek(num);
+        skip(num);
+        return bits;
+    }
+
+    /**
+     * \brief Discards bits up to the next byte boundary
+     */
+    inline void align() {
+        skip(size_ & 7);
+    }
+
+    /**
+     * \brief Reports the number of input bytes consumed so far, including a partially consumed byte
+     * 
+     * \return the number of consumed bytes
+     */
+    inline size_t byte_pos() const {
+        return (size_t(pos_ - begin_) + padding_) - (size_ >> 3);
+    }
+
+    /**
+     * \brief Continues reading at the given byte position, discarding all buffered bits
+     * 
+     * \param pos the byte position, which must not exceed the size of the input
+     */
+    inline void seek(size_t const pos) {
+        assert(pos <= size_t(end_ - begin_));
+        pos_ = begin_ + pos;
+        buffer_ = 0;
+        size_ = 0;
+        padding_ = 0;
+    }
+
+    /**
+     * \brief Reports whether bits beyond the end of the input have been consumed
+     * 
+     * \return true if more bits have been consumed than the input contains
+     */
+    inline bool overrun() const {
+        return padding_ * 8 > size_;
+    }
+
+    /**
+     * \brief Provides direct access to the input
+     * 
+     * \return the beginning of the input
+     */
+    inline uint8_t const* data() const { return begin_; }
+
+    /**
+     * \brief Reports the size of the input
+     * 
+     * \return the size of the input in bytes
+     */
+    inline size_t size() const { return end_ - begin_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * code/internal/checksums.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_CHECKSUMS_HPP
+#define _CODE_INTERNAL_CHECKSUMS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace code::internal {
+
+/// \cond INTERNAL
+constexpr std::array<uint32_t, 256> make_crc32_table() {
+    std::array<uint32_t, 256> table {};
+    for(uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for(size_t k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC32_TABLE = make_crc32_table();
+/// \endcond
+
+/**
+ * \brief Updates a CRC-32 checksum as used by gzip
+ * 
+ * \param crc the checksum of the preceding data, zero initially
+ * \param data the data
+ * \param num the number of bytes
+ * \return the updated checksum
+ */
+inline uint32_t crc32(uint32_t crc, uint8_t const* data, size_t num) {
+    crc = ~crc;
+    while(num--) crc = CRC32_TABLE[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/**
+ * \brief Updates an Adler-32 checksum as used by zlib
+ * 
+ * \param adler the checksum of the preceding data, one initially
+ * \param data the data
+ * \param num the number of bytes
+ * \return the updated checksum
+ */
+inline uint32_t adler32(uint32_t const adler, uint8_t const* data, size_t num) {
+    constexpr uint32_t MOD = 65521;
+    constexpr size_t NMAX = 5552; // the maximum number of bytes before the sums may overflow
+
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+    while(num) {
+        auto n = num < NMAX ? num : NMAX;
+        num -= n;
+        while(n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= MOD;
+        b %= MOD;
+    }
+    return (b << 16) | a;
+}
+
+}
+
+#endif
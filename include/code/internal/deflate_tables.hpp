@@ -0,0 +1,115 @@
+/**
+ * code/internal/deflate_tables.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_DEFLATE_TABLES_HPP
+#define _CODE_INTERNAL_DEFLATE_TABLES_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace code::internal::deflate {
+
+/// \brief The end-of-block symbol of the literal/length alphabet
+constexpr uint32_t END_OF_BLOCK = 256;
+
+/// \brief The number of symbols of the literal/length alphabet, including the two unused symbols
+constexpr size_t NUM_LITLEN = 288;
+
+/// \brief The number of symbols of the distance alphabet, including the two unused symbols
+constexpr size_t NUM_DIST = 32;
+
+/// \brief The number of symbols of the code length alphabet
+constexpr size_t NUM_CODELEN = 19;
+
+/// \brief The maximum length of a literal/length or distance codeword
+constexpr size_t MAX_CODE_LENGTH = 15;
+
+/// \brief The maximum length of a code length codeword
+constexpr size_t MAX_CODELEN_LENGTH = 7;
+
+/// \brief The maximum match length
+constexpr size_t MAX_MATCH = 258;
+
+/// \brief The maximum match distance
+constexpr size_t MAX_DISTANCE = 32768;
+
+/// \brief The base match lengths of the length symbols 257 to 285
+constexpr uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+/// \brief The number of extra bits of the length symbols 257 to 285
+constexpr uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/// \brief The base distances of the distance symbols 0 to 29
+constexpr uint16_t DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+/// \brief The number of extra bits of the distance symbols 0 to 29
+constexpr uint8_t DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/// \brief The order in which the code length code lengths are transmitted
+constexpr uint8_t CODELEN_ORDER[NUM_CODELEN] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/**
+ * \brief Finds the length symbol for a match length
+ * 
+ * \param len the match length, between 3 and 258
+ * \return the index of the length symbol, i.e., the symbol minus 257
+ */
+constexpr inline size_t length_index(size_t const len) {
+    size_t i = 28;
+    while(LENGTH_BASE[i] > len) --i;
+    return i;
+}
+
+/**
+ * \brief Finds the distance symbol for a match distance
+ * 
+ * \param dist the match distance, between 1 and 32768
+ * \return the distance symbol
+ */
+constexpr inline size_t dist_index(size_t const dist) {
+    size_t i = 29;
+    while(DIST_BASE[i] > dist) --i;
+    return i;
+}
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * code/internal/huffman_simd.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_HUFFMAN_SIMD_HPP
+#define _CODE_INTERNAL_HUFFMAN_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "../huffman_packed_table.hpp"
+
+namespace code::internal {
+
+/*
+ * The kernels below encode a fixed-size block of characters using the entries of a packed Huffman table.
+ * 
+ * The table entries of all characters are gathered at once. Since the packed codewords have at most 27 bits,
+ * the codewords of two consecutive characters can be merged into a single codeword of at most 54 bits within
+ * a 64-bit lane, shifting the second codeword by the length of the first. The merged codewords are then passed
+ * to the word packer, which halves the amount of scalar work compared to appending each codeword separately.
+ * 
+ * A kernel reports false without writing anything if the block contains a character outside of the table's
+ * universe or a character with a long codeword; the caller is expected to fall back to scalar encoding then.
+ */
+
+#ifdef __AVX2__
+constexpr size_t HUFFMAN_AVX2_BLOCK = 8;
+
+template<typename Char, typename Packer>
+inline bool huffman_encode_avx2(Packer& packer, Char const* in, HuffmanPackedTable const& table) {
+    static_assert(sizeof(Char) <= 4);
+
+    // load characters and make them relative to the table's minimum
+    __m256i idx;
+    if constexpr(sizeof(Char) == 1) {
+        idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const*)in));
+    } else if constexpr(sizeof(Char) == 2) {
+        idx = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const*)in));
+    } else {
+        idx = _mm256_loadu_si256((__m256i const*)in);
+    }
+    idx = _mm256_sub_epi32(idx, _mm256_set1_epi32((int)(uint32_t)table.min()));
+
+    // verify that all characters are in the table's universe
+    auto const last = _mm256_set1_epi32((int)(uint32_t)(table.size() - 1));
+    if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_min_epu32(idx, last), idx)) != -1) return false;
+
+    // gather entries and verify that there are no long codewords
+    auto const e = _mm256_i32gather_epi32((int const*)table.data(), idx, 4);
+    auto const escape = _mm256_set1_epi32((int)HuffmanPackedTable::ESCAPE);
+    if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_srli_epi32(e, HuffmanPackedTable::WORD_BITS), escape)) != 0) return false;
+
+    // merge pairs of codewords in 64-bit lanes
+    auto const word_mask = _mm256_set1_epi64x(HuffmanPackedTable::WORD_MASK);
+    auto const lo_word = _mm256_and_si256(e, word_mask);
+    auto const lo_len = _mm256_and_si256(_mm256_srli_epi64(e, HuffmanPackedTable::WORD_BITS), _mm256_set1_epi64x(HuffmanPackedTable::ESCAPE));
+    auto const hi_word = _mm256_and_si256(_mm256_srli_epi64(e, 32), word_mask);
+    auto const hi_len = _mm256_srli_epi64(e, 32 + HuffmanPackedTable::WORD_BITS);
+
+    alignas(32) uint64_t words[4];
+    alignas(32) uint64_t lengths[4];
+    _mm256_store_si256((__m256i*)words, _mm256_or_si256(lo_word, _mm256_sllv_epi64(hi_word, lo_len)));
+    _mm256_store_si256((__m256i*)lengths, _mm256_add_epi64(lo_len, hi_len));
+
+    for(size_t i = 0; i < 4; i++) packer.append(words[i], lengths[i]);
+    return true;
+}
+#endif
+
+#ifdef __AVX512F__
+constexpr size_t HUFFMAN_AVX512_BLOCK = 16;
+
+template<typename Char, typename Packer>
+inline bool huffman_encode_avx512(Packer& packer, Char const* in, HuffmanPackedTable const& table) {
+    static_assert(sizeof(Char) <= 4);
+
+    // load characters and make them relative to the table's minimum
+    __m512i idx;
+    if constexpr(sizeof(Char) == 1) {
+        idx = _mm512_cvtepu8_epi32(_mm_loadu_si128((__m128i const*)in));
+    } else if constexpr(sizeof(Char) == 2) {
+        idx = _mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i const*)in));
+    } else {
+        idx = _mm512_loadu_si512(in);
+    }
+    idx = _mm512_sub_epi32(idx, _mm512_set1_epi32((int)(uint32_t)table.min()));
+
+    // verify that all characters are in the table's universe
+    auto const last = _mm512_set1_epi32((int)(uint32_t)(table.size() - 1));
+    if(_mm512_cmple_epu32_mask(idx, last) != 0xFFFF) return false;
+
+    // gather entries and verify that there are no long codewords
+    auto const e = _mm512_i32gather_epi32(idx, table.data(), 4);
+    auto const escape = _mm512_set1_epi32((int)HuffmanPackedTable::ESCAPE);
+    if(_mm512_cmpeq_epi32_mask(_mm512_srli_epi32(e, HuffmanPackedTable::WORD_BITS), escape) != 0) return false;
+
+    // merge pairs of codewords in 64-bit lanes
+    auto const word_mask = _mm512_set1_epi64(HuffmanPackedTable::WORD_MASK);
+    auto const lo_word = _mm512_and_si512(e, word_mask);
+    auto const lo_len = _mm512_and_si512(_mm512_srli_epi64(e, HuffmanPackedTable::WORD_BITS), _mm512_set1_epi64(HuffmanPackedTable::ESCAPE));
+    auto const hi_word = _mm512_and_si512(_mm512_srli_epi64(e, 32), word_mask);
+    auto const hi_len = _mm512_srli_epi64(e, 32 + HuffmanPackedTable::WORD_BITS);
+
+    alignas(64) uint64_t words[8];
+    alignas(64) uint64_t lengths[8];
+    _mm512_store_si512(words, _mm512_or_si512(lo_word, _mm512_sllv_epi64(hi_word, lo_len)));
+    _mm512_store_si512(lengths, _mm512_add_epi64(lo_len, hi_len));
+
+    for(size_t i = 0; i < 8; i++) packer.append(words[i], lengths[i]);
+    return true;
+}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * code/internal/intersect_simd.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_INTERSECT_SIMD_HPP
+#define _CODE_INTERNAL_INTERSECT_SIMD_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+
+namespace code::internal {
+
+/*
+ * Intersection of two strictly increasing arrays of 32-bit integers.
+ * 
+ * If SSSE3 is available, four integers of each array are compared at once: the vector of the second array is rotated
+ * three times so that all sixteen pairs are compared, and the matching integers of the first array are moved to the front
+ * using a byte shuffle with a mask from a table indexed by the comparison result. The vector with the smaller maximum
+ * is advanced, and the remainder is intersected using a scalar merge.
+ */
+
+constexpr size_t INTERSECT_SIMD_OVERHANG = 4;
+
+#ifdef __SSSE3__
+constexpr std::array<std::array<uint8_t, 16>, 16> make_intersect_compact_table() {
+    std::array<std::array<uint8_t, 16>, 16> table {};
+    for(size_t mask = 0; mask < 16; mask++) {
+        size_t k = 0;
+        for(size_t lane = 0; lane < 4; lane++) {
+            if(mask & (1 << lane)) {
+                for(size_t b = 0; b < 4; b++) table[mask][4 * k + b] = (uint8_t)(4 * lane + b);
+                ++k;
+            }
+        }
+        for(; k < 4; k++) {
+            for(size_t b = 0; b < 4; b++) table[mask][4 * k + b] = 0x80;
+        }
+    }
+    return table;
+}
+
+constexpr auto INTERSECT_COMPACT_TABLE = make_intersect_compact_table();
+#endif
+
+/**
+ * \brief Intersects two strictly increasing arrays
+ * 
+ * \param a the first array
+ * \param na the length of the first array
+ * \param b the second array
+ * \param nb the length of the second array
+ * \param out the output, which must have space for the intersection plus \ref INTERSECT_SIMD_OVERHANG integers
+ * \return the size of the intersection
+ */
+inline size_t intersect_sorted(uint32_t const* a, size_t const na, uint32_t const* b, size_t const nb, uint32_t* out) {
+    size_t i = 0, j = 0, k = 0;
+
+    #ifdef __SSSE3__
+    while(i + 4 <= na && j + 4 <= nb) {
+        auto const va = _mm_loadu_si128((__m128i const*)(a + i));
+        auto const vb = _mm_loadu_si128((__m128i const*)(b + j));
+
+        auto m = _mm_cmpeq_epi32(va, vb);
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        auto const mask = _mm_movemask_ps(_mm_castsi128_ps(m));
+        auto const shuffle = _mm_loadu_si128((__m128i const*)INTERSECT_COMPACT_TABLE[mask].data());
+        _mm_storeu_si128((__m128i*)(out + k), _mm_shuffle_epi8(va, shuffle));
+        k += std::popcount((unsigned)mask);
+
+        auto const amax = a[i + 3];
+        auto const bmax = b[j + 3];
+        if(amax <= bmax) i += 4;
+        if(bmax <= amax) j += 4;
+    }
+    #endif
+
+    while(i < na && j < nb) {
+        if(a[i] < b[j]) {
+            ++i;
+        } else if(b[j] < a[i]) {
+            ++j;
+        } else {
+            out[k++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return k;
+}
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+/**
+ * code/internal/io_uring_reader.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_IO_URING_READER_HPP
+#define _CODE_INTERNAL_IO_URING_READER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CODE_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace code::internal {
+
+#ifdef CODE_HAS_IO_URING
+
+/**
+ * \brief Asynchronous file reads using a Linux io_uring
+ * 
+ * The ring is set up using raw system calls, so liburing is not required.
+ * Reads are submitted as \c IORING_OP_READV requests, which are supported by all kernels that support io_uring (5.1 and later).
+ * Each request is identified by a tag that is reported along with the result once it is complete; completions may occur in any order.
+ */
+class IoUringReader {
+private:
+    int ring_fd_;
+    int fd_;
+
+    void* sq_ptr_;
+    size_t sq_size_;
+    void* cq_ptr_;
+    size_t cq_size_;
+    io_uring_sqe* sqes_;
+    size_t sqes_size_;
+
+    unsigned* sq_tail_;
+    unsigned* sq_mask_;
+    unsigned* sq_array_;
+    unsigned* cq_head_;
+    unsigned* cq_tail_;
+    unsigned* cq_mask_;
+    io_uring_cqe* cqes_;
+
+    std::vector<iovec> iovecs_; // nb: must remain valid until the request has been consumed by the kernel
+
+    inline int enter(unsigned const to_submit, unsigned const min_complete, unsigned const flags) {
+        int r;
+        do {
+            r = (int)syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0);
+        } while(r < 0 && errno == EINTR);
+        return r;
+    }
+
+public:
+    /**
+     * \brief Sets up an io_uring for reading from the given file
+     * 
+     * If the setup fails, e.g., because io_uring is not supported by the kernel or disabled, \ref ok reports false.
+     * 
+     * \param fd the file descriptor
+     * \param depth the maximum number of requests in flight
+     */
+    IoUringReader(int const fd, unsigned const depth) : ring_fd_(-1), fd_(fd), sq_ptr_(MAP_FAILED), cq_ptr_(MAP_FAILED), sqes_((io_uring_sqe*)MAP_FAILED), iovecs_(depth) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        ring_fd_ = (int)syscall(__NR_io_uring_setup, depth, &p);
+        if(ring_fd_ < 0) return;
+
+        sq_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool const single_mmap = p.features & IORING_FEAT_SINGLE_MMAP;
+        if(single_mmap) sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+        sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+        if(sq_ptr_ == MAP_FAILED) return;
+
+        cq_ptr_ = single_mmap ? sq_ptr_ : mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if(cq_ptr_ == MAP_FAILED) return;
+
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = (io_uring_sqe*)mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+        if(sqes_ == MAP_FAILED) return;
+
+        auto* sq = (uint8_t*)sq_ptr_;
+        sq_tail_ = (unsigned*)(sq + p.sq_off.tail);
+        sq_mask_ = (unsigned*)(sq + p.sq_off.ring_mask);
+        sq_array_ = (unsigned*)(sq + p.sq_off.array);
+
+        auto* cq = (uint8_t*)cq_ptr_;
+        cq_head_ = (unsigned*)(cq + p.cq_off.head);
+        cq_tail_ = (unsigned*)(cq + p.cq_off.tail);
+        cq_mask_ = (unsigned*)(cq + p.cq_off.ring_mask);
+        cqes_ = (io_uring_cqe*)(cq + p.cq_off.cqes);
+    }
+
+    IoUringReader(IoUringReader const&) = delete;
+    IoUringReader& operator=(IoUringReader const&) = delete;
+
+    /**
+     * \brief Tears down the io_uring
+     * 
+     * All submitted requests must have been completed.
+     */
+    ~IoUringReader() {
+        if(sqes_ != MAP_FAILED) munmap(sqes_, sqes_size_);
+        if(cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+        if(sq_ptr_ != MAP_FAILED) munmap(sq_ptr_, sq_size_);
+        if(ring_fd_ >= 0) close(ring_fd_);
+    }
+
+    /**
+     * \brief Reports whether the io_uring has been set up successfully
+     * 
+     * \return true if the io_uring is usable, false otherwise
+     */
+    inline bool ok() const { return ring_fd_ >= 0 && sqes_ != MAP_FAILED; }
+
+    /**
+     * \brief Submits a read request
+     * 
+     * If the kernel does not accept the request, it is withdrawn from the submission queue, so it cannot be submitted later by accident.
+     * 
+     * \param tag the tag identifying the request, less than the depth
+     * \param buf the buffer to read into
+     * \param len the number of bytes to read
+     * \param offset the file offset to read from
+     * \return true if the request has been submitted, false otherwise
+     */
+    bool submit(size_t const tag, void* const buf, size_t const len, uint64_t const offset) {
+        iovecs_[tag].iov_base = buf;
+        iovecs_[tag].iov_len = len;
+
+        auto const tail = *sq_tail_; // nb: only we write the tail
+        auto const i = tail & *sq_mask_;
+        auto& sqe = sqes_[i];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = fd_;
+        sqe.addr = (uint64_t)&iovecs_[tag];
+        sqe.len = 1;
+        sqe.off = offset;
+        sqe.user_data = tag;
+        sq_array_[i] = i;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+        int r;
+        do {
+            r = enter(1, 0, 0);
+        } while(r < 0 && (errno == EAGAIN || errno == EBUSY)); // nb: temporary shortage of resources
+
+        if(r != 1) {
+            // nb: without a polling thread, the kernel only consumes entries during io_uring_enter, so the entry can safely be withdrawn
+            __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Waits for the completion of any submitted request
+     * 
+     * \return the tag of the completed request and its result, i.e., the number of bytes read or a negative error code
+     */
+    std::pair<size_t, ptrdiff_t> wait() {
+        while(true) {
+            auto const head = *cq_head_; // nb: only we write the head
+            if(head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                auto const& cqe = cqes_[head & *cq_mask_];
+                std::pair<size_t, ptrdiff_t> const result((size_t)cqe.user_data, (ptrdiff_t)cqe.res);
+                __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+                return result;
+            }
+            if(enter(0, 1, IORING_ENTER_GETEVENTS) < 0) return { SIZE_MAX, -errno };
+        }
+    }
+};
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * code/internal/mtf_simd.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_MTF_SIMD_HPP
+#define _CODE_INTERNAL_MTF_SIMD_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace code::internal {
+
+/*
+ * The kernels below operate on a move-to-front list of 256 bytes that is aligned to 32 bytes and preceded by at least one byte of padding.
+ * 
+ * The search compares 32 list entries at once against the searched byte, so since most ranks are small in practice,
+ * a byte is typically found using a single comparison.
+ * 
+ * The shift of a small prefix of the list is done by blending the first 32 entries with the same entries shifted by one position,
+ * which avoids the overhead of a call to memmove.
+ */
+
+#ifdef __AVX2__
+inline size_t mtf_find_avx2(uint8_t const* list, uint8_t const c) {
+    auto const needle = _mm256_set1_epi8((char)c);
+    for(size_t i = 0; i < 256; i += 32) {
+        auto const m = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)(list + i)), needle));
+        if(m) return i + std::countr_zero(m);
+    }
+    return 256; // nb: cannot happen if the list is a permutation
+}
+
+inline void mtf_shift32_avx2(uint8_t* list, size_t const rank) {
+    // blend the entries at positions 1 to rank with their predecessors
+    auto const indices = _mm256_setr_epi8(
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+    auto const mask = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(rank + 1)), indices); // nb: rank < 32, no overflow
+    auto const cur = _mm256_load_si256((__m256i const*)list);
+    auto const prev = _mm256_loadu_si256((__m256i const*)(list - 1));
+    _mm256_store_si256((__m256i*)list, _mm256_blendv_epi8(cur, prev, mask));
+}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * code/internal/sais.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_SAIS_HPP
+#define _CODE_INTERNAL_SAIS_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace code::internal {
+
+/**
+ * \brief Computes the suffix array of a string using the SA-IS algorithm by Nong, Zhang and Chan
+ * 
+ * The string is implicitly terminated by a sentinel that is smaller than all of its characters.
+ * The algorithm runs in linear time and is applied recursively to the reduced string of sorted LMS substrings.
+ * 
+ * \tparam Char the character type
+ * \param s the string
+ * \param n the length of the string, which must be less than \c 2^31
+ * \param sigma the size of the alphabet, i.e., all characters must be less than \c sigma
+ * \return the suffix array of the string
+ */
+template<typename Char>
+std::vector<int32_t> sais(Char const* s, size_t const n, size_t const sigma) {
+    assert(n < (size_t(1) << 31));
+
+    if(n == 0) return {};
+    if(n == 1) return { 0 };
+    if(n == 2) return s[0] < s[1] ? std::vector<int32_t>{ 0, 1 } : std::vector<int32_t>{ 1, 0 };
+
+    auto const len = int32_t(n);
+    std::vector<int32_t> sa(n);
+
+    // classify suffixes: true for S-type, false for L-type (nb: the last suffix is L-type due to the sentinel)
+    std::vector<bool> stype(n, false);
+    for(int32_t i = len - 2; i >= 0; i--) {
+        stype[i] = (s[i] == s[i + 1]) ? stype[i + 1] : (s[i] < s[i + 1]);
+    }
+
+    // compute bucket boundaries: l_start[c] is the start of the bucket of c, s_start[c] is the start of its S-type region
+    std::vector<int32_t> l_start(sigma + 1, 0), s_start(sigma + 1, 0);
+    for(size_t i = 0; i < n; i++) {
+        if(!stype[i]) {
+            ++s_start[s[i]];
+        } else {
+            ++l_start[s[i] + 1];
+        }
+    }
+    for(size_t c = 0; c <= sigma; c++) {
+        s_start[c] += l_start[c];
+        if(c < sigma) l_start[c + 1] += s_start[c];
+    }
+
+    // induced sorting of all suffixes, given the LMS suffixes in sorted order
+    std::vector<int32_t> bucket(sigma + 1);
+    auto induce = [&](std::vector<int32_t> const& lms){
+        std::fill(sa.begin(), sa.end(), -1);
+
+        // place LMS suffixes at the beginning of the S-type regions
+        std::copy(s_start.begin(), s_start.end(), bucket.begin());
+        for(auto const i : lms) {
+            sa[bucket[s[i]]++] = i;
+        }
+
+        // induce L-type suffixes from left to right
+        std::copy(l_start.begin(), l_start.end(), bucket.begin());
+        sa[bucket[s[len - 1]]++] = len - 1;
+        for(size_t k = 0; k < n; k++) {
+            auto const i = sa[k];
+            if(i >= 1 && !stype[i - 1]) sa[bucket[s[i - 1]]++] = i - 1;
+        }
+
+        // induce S-type suffixes from right to left
+        std::copy(l_start.begin(), l_start.end(), bucket.begin());
+        for(size_t k = n; k-- > 0;) {
+            auto const i = sa[k];
+            if(i >= 1 && stype[i - 1]) sa[--bucket[s[i - 1] + 1]] = i - 1;
+        }
+    };
+
+    // find LMS positions
+    std::vector<int32_t> lms_index(n + 1, -1);
+    std::vector<int32_t> lms;
+    for(int32_t i = 1; i < len; i++) {
+        if(!stype[i - 1] && stype[i]) {
+            lms_index[i] = int32_t(lms.size());
+            lms.push_back(i);
+        }
+    }
+    auto const m = int32_t(lms.size());
+
+    // sort LMS substrings
+    induce(lms);
+
+    if(m) {
+        std::vector<int32_t> sorted_lms;
+        sorted_lms.reserve(m);
+        for(auto const i : sa) {
+            if(lms_index[i] >= 0) sorted_lms.push_back(i);
+        }
+
+        // name LMS substrings, yielding the reduced string
+        std::vector<int32_t> reduced(m);
+        int32_t name = 0;
+        reduced[lms_index[sorted_lms[0]]] = 0;
+        for(int32_t k = 1; k < m; k++) {
+            auto l = sorted_lms[k - 1];
+            auto r = sorted_lms[k];
+            auto const end_l = (lms_index[l] + 1 < m) ? lms[lms_index[l] + 1] : len;
+            auto const end_r = (lms_index[r] + 1 < m) ? lms[lms_index[r] + 1] : len;
+
+            bool same = (end_l - l == end_r - r);
+            if(same) {
+                while(l < end_l && s[l] == s[r]) {
+                    ++l;
+                    ++r;
+                }
+                if(l == len || s[l] != s[r]) same = false;
+            }
+
+            if(!same) ++name;
+            reduced[lms_index[sorted_lms[k]]] = name;
+        }
+
+        // sort LMS suffixes recursively and induce the final suffix array
+        auto const reduced_sa = sais(reduced.data(), reduced.size(), size_t(name) + 1);
+        for(int32_t k = 0; k < m; k++) {
+            sorted_lms[k] = lms[reduced_sa[k]];
+        }
+        induce(sorted_lms);
+    }
+
+    return sa;
+}
+
+}
+
+#endif
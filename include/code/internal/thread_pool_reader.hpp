@@ -0,0 +1,165 @@
+/**
+ * code/internal/thread_pool_reader.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_THREAD_POOL_READER_HPP
+#define _CODE_INTERNAL_THREAD_POOL_READER_HPP
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace code::internal {
+
+/**
+ * \brief Asynchronous file reads using a pool of threads that perform blocking reads
+ * 
+ * This provides the same interface as \ref IoUringReader and serves as a fallback where io_uring is not available.
+ */
+class ThreadPoolReader {
+private:
+    struct Request {
+        size_t tag;
+        void* buf;
+        size_t len;
+        uint64_t offset;
+    };
+
+    int fd_;
+    std::mutex mutex_;
+    std::condition_variable requested_;
+    std::condition_variable completed_;
+    std::deque<Request> requests_;
+    std::deque<std::pair<size_t, ptrdiff_t>> completions_;
+    bool stop_;
+    std::vector<std::thread> threads_;
+
+    void work() {
+        std::unique_lock lock(mutex_);
+        while(true) {
+            requested_.wait(lock, [&](){ return stop_ || !requests_.empty(); });
+            if(requests_.empty()) return; // nb: we were stopped
+
+            auto const r = requests_.front();
+            requests_.pop_front();
+            lock.unlock();
+
+            // read until the request is satisfied or the end of the file is reached
+            ptrdiff_t result = 0;
+            while((size_t)result < r.len) {
+                auto const n = pread(fd_, (uint8_t*)r.buf + result, r.len - result, r.offset + result);
+                if(n < 0 && errno == EINTR) continue;
+                if(n < 0) result = -errno;
+                if(n <= 0) break;
+                result += n;
+            }
+
+            lock.lock();
+            completions_.emplace_back(r.tag, result);
+            completed_.notify_one();
+        }
+    }
+
+public:
+    /**
+     * \brief Starts the threads for reading from the given file
+     * 
+     * \param fd the file descriptor
+     * \param num_threads the number of threads, at least one
+     */
+    ThreadPoolReader(int const fd, size_t const num_threads) : fd_(fd), stop_(false) {
+        threads_.reserve(num_threads);
+        for(size_t i = 0; i < num_threads; i++) threads_.emplace_back([this](){ work(); });
+    }
+
+    ThreadPoolReader(ThreadPoolReader const&) = delete;
+    ThreadPoolReader& operator=(ThreadPoolReader const&) = delete;
+
+    /**
+     * \brief Stops the threads
+     * 
+     * Requests that have not yet been started are discarded, but requests in progress are completed.
+     */
+    ~ThreadPoolReader() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+            requests_.clear();
+        }
+        requested_.notify_all();
+        for(auto& t : threads_) t.join();
+    }
+
+    /**
+     * \brief Reports whether the reader is usable, which is always the case
+     * 
+     * \return true
+     */
+    inline bool ok() const { return true; }
+
+    /**
+     * \brief Submits a read request
+     * 
+     * \param tag the tag identifying the request
+     * \param buf the buffer to read into
+     * \param len the number of bytes to read
+     * \param offset the file offset to read from
+     * \return true
+     */
+    bool submit(size_t const tag, void* const buf, size_t const len, uint64_t const offset) {
+        {
+            std::lock_guard lock(mutex_);
+            requests_.push_back(Request { tag, buf, len, offset });
+        }
+        requested_.notify_one();
+        return true;
+    }
+
+    /**
+     * \brief Waits for the completion of any submitted request
+     * 
+     * \return the tag of the completed request and its result, i.e., the number of bytes read or a negative error code
+     */
+    std::pair<size_t, ptrdiff_t> wait() {
+        std::unique_lock lock(mutex_);
+        completed_.wait(lock, [&](){ return !completions_.empty(); });
+        auto const c = completions_.front();
+        completions_.pop_front();
+        return c;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * code/internal/universal_bulk.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_UNIVERSAL_BULK_HPP
+#define _CODE_INTERNAL_UNIVERSAL_BULK_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX512F__) && defined(__AVX512CD__)
+#include <immintrin.h>
+#endif
+
+namespace code::internal {
+
+/*
+ * Elias-gamma, Elias-delta and Rice codewords all consist of a unary prefix of a one bits terminated by a zero bit,
+ * followed by the lowest b1 bits of an integer y1 and the lowest b2 bits of an integer y2:
+ * 
+ * - gamma(x):   a = b1 = bit_width(x) - 1, y1 = x, b2 = 0
+ * - delta(x):   m = bit_width(x) - 1, a = b1 = bit_width(m + 1) - 1, y1 = m + 1, y2 = x, b2 = m
+ * - rice(x, p): q = x >> p, a = b1 = bit_width(q + 1) - 1, y1 = q + 1, y2 = x, b2 = p
+ * 
+ * In LSBF order, such a codeword is the word (2^a - 1) | (y1 mod 2^b1) << (a + 1) | (y2 mod 2^b2) << (a + 1 + b1).
+ * The functions below form these words in registers and pass them to a word packer, such that the sink is written
+ * only once per 64 bits. Codewords that exceed 64 bits are split into their parts.
+ */
+
+constexpr inline uint64_t low_bits(uint64_t const x, size_t const b) {
+    return b >= 64 ? x : (x & ((uint64_t(1) << b) - 1));
+}
+
+template<typename Packer>
+inline void append_prefixed(Packer& packer, size_t const a, uint64_t const y1, size_t const b1, uint64_t const y2, size_t const b2) {
+    auto const len = a + 1 + b1 + b2;
+    if(len <= 64) [[likely]] {
+        auto word = low_bits(UINT64_MAX, a);
+        if(b1) word |= low_bits(y1, b1) << (a + 1);
+        if(b2) word |= low_bits(y2, b2) << (a + 1 + b1);
+        packer.append(word, len);
+    } else {
+        for(auto ones = a; ones; ) {
+            auto const n = ones < 64 ? ones : 64;
+            packer.append(low_bits(UINT64_MAX, n), n);
+            ones -= n;
+        }
+        packer.append(0, 1);
+        if(b1) packer.append(low_bits(y1, b1), b1);
+        if(b2) packer.append(low_bits(y2, b2), b2);
+    }
+}
+
+template<typename Packer>
+inline void append_gamma(Packer& packer, uint64_t const x) {
+    assert(x > 0);
+    auto const m = (size_t)std::bit_width(x) - 1;
+    append_prefixed(packer, m, x, m, 0, 0);
+}
+
+template<typename Packer>
+inline void append_delta(Packer& packer, uint64_t const x) {
+    assert(x > 0);
+    auto const m = (size_t)std::bit_width(x) - 1;
+    auto const mm = (size_t)std::bit_width(m + 1) - 1;
+    append_prefixed(packer, mm, m + 1, mm, x, m);
+}
+
+template<typename Packer>
+inline void append_rice(Packer& packer, uint64_t const x, size_t const p) {
+    auto const q = p >= 64 ? 0 : (x >> p);
+    auto const mm = (size_t)std::bit_width(q + 1) - 1;
+    append_prefixed(packer, mm, q + 1, mm, x, p);
+}
+
+#if defined(__AVX512F__) && defined(__AVX512CD__)
+constexpr size_t UNIVERSAL_AVX512_BLOCK = 8;
+
+template<typename Int>
+inline __m512i universal_load_avx512(Int const* in) {
+    static_assert(sizeof(Int) == 4 || sizeof(Int) == 8);
+    if constexpr(sizeof(Int) == 4) {
+        return _mm512_cvtepu32_epi64(_mm256_loadu_si256((__m256i const*)in));
+    } else {
+        return _mm512_loadu_si512(in);
+    }
+}
+
+// computes the bit width minus one of each lane using the vectorized leading zero count
+inline __m512i universal_floor_log2_avx512(__m512i const x) {
+    return _mm512_sub_epi64(_mm512_set1_epi64(63), _mm512_lzcnt_epi64(x));
+}
+
+// composes the codewords as described above and passes them to the packer, reporting false without writing anything if any exceeds 64 bits
+template<typename Packer>
+inline bool universal_append_avx512(Packer& packer, __m512i const a, __m512i const y1, __m512i const y2, __m512i const b2) {
+    auto const one = _mm512_set1_epi64(1);
+    auto const a1 = _mm512_add_epi64(a, one);
+    auto const len = _mm512_add_epi64(_mm512_add_epi64(a1, a), b2);
+    if(_mm512_cmpgt_epu64_mask(len, _mm512_set1_epi64(64)) != 0) return false;
+
+    // nb: variable shifts by 64 or more yield zero, so masks for 64-bit parts need special care
+    auto const ones = _mm512_sub_epi64(_mm512_sllv_epi64(one, a), one);
+    auto const mask2 = _mm512_mask_blend_epi64(_mm512_cmpeq_epu64_mask(b2, _mm512_set1_epi64(64)),
+        _mm512_sub_epi64(_mm512_sllv_epi64(one, b2), one), _mm512_set1_epi64(-1));
+
+    auto word = _mm512_or_si512(ones, _mm512_sllv_epi64(_mm512_and_si512(y1, ones), a1));
+    word = _mm512_or_si512(word, _mm512_sllv_epi64(_mm512_and_si512(y2, mask2), _mm512_add_epi64(a1, a)));
+
+    alignas(64) uint64_t words[8];
+    alignas(64) uint64_t lengths[8];
+    _mm512_store_si512(words, word);
+    _mm512_store_si512(lengths, len);
+    for(size_t i = 0; i < 8; i++) packer.append(words[i], lengths[i]);
+    return true;
+}
+
+template<typename Int, typename Packer>
+inline bool gamma_encode_avx512(Packer& packer, Int const* in) {
+    auto const x = universal_load_avx512(in);
+    auto const m = universal_floor_log2_avx512(x);
+    return universal_append_avx512(packer, m, x, _mm512_setzero_si512(), _mm512_setzero_si512());
+}
+
+template<typename Int, typename Packer>
+inline bool delta_encode_avx512(Packer& packer, Int const* in) {
+    auto const x = universal_load_avx512(in);
+    auto const k = _mm512_add_epi64(universal_floor_log2_avx512(x), _mm512_set1_epi64(1));
+    auto const mm = universal_floor_log2_avx512(k);
+    return universal_append_avx512(packer, mm, k, x, _mm512_sub_epi64(k, _mm512_set1_epi64(1)));
+}
+
+template<typename Int, typename Packer>
+inline bool rice_encode_avx512(Packer& packer, Int const* in, size_t const p) {
+    auto const x = universal_load_avx512(in);
+    auto const vp = _mm512_set1_epi64(p);
+    auto const k = _mm512_add_epi64(_mm512_srlv_epi64(x, vp), _mm512_set1_epi64(1));
+    auto const mm = universal_floor_log2_avx512(k);
+    return universal_append_avx512(packer, mm, k, x, vp);
+}
+#endif
+
+}
+
+#endif
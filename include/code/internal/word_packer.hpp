@@ -0,0 +1,112 @@
+/**
+ * code/internal/word_packer.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_INTERNAL_WORD_PACKER_HPP
+#define _CODE_INTERNAL_WORD_PACKER_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "../concepts.hpp"
+
+namespace code::internal {
+
+/**
+ * \brief Accumulates codewords into full 64-bit words before passing them to a bit sink
+ * 
+ * This reduces the number of calls to the sink to one per 64 bits.
+ * Codewords are expected in LSBF order, i.e., the lowest bit is the first bit of the code.
+ * Writing the accumulated words is thus equivalent to writing the codewords bit by bit if, like for iopp,
+ * the sink's \c write(bits, num) writes the lowest bit first.
+ * 
+ * \tparam Sink the bit sink type
+ */
+template<BitSink Sink>
+class WordPacker {
+private:
+    Sink* sink_;
+    uint64_t buffer_;
+    size_t size_;
+
+public:
+    /**
+     * \brief Constructs a word packer for the given sink
+     * 
+     * \param sink the bit sink
+     */
+    inline WordPacker(Sink& sink) : sink_(&sink), buffer_(0), size_(0) {
+    }
+
+    WordPacker(WordPacker const&) = delete;
+    WordPacker& operator=(WordPacker const&) = delete;
+
+    /**
+     * \brief Flushes the remaining bits to the sink
+     */
+    inline ~WordPacker() {
+        flush();
+    }
+
+    /**
+     * \brief Appends a codeword
+     * 
+     * The codeword must not have any bits set above its length.
+     * 
+     * \param word the codeword in LSBF order
+     * \param len the length of the codeword, at most 64
+     */
+    inline void append(uint64_t const word, size_t const len) {
+        assert(len <= 64);
+        assert(len == 64 || (word >> len) == 0);
+
+        buffer_ |= word << size_;
+        size_ += len;
+        if(size_ >= 64) {
+            sink_->write(buffer_, 64);
+            size_ -= 64;
+            buffer_ = size_ ? word >> (len - size_) : 0;
+        }
+    }
+
+    /**
+     * \brief Writes the remaining bits to the sink
+     * 
+     * Note that this does not flush the sink itself.
+     */
+    inline void flush() {
+        if(size_) {
+            sink_->write(buffer_, size_);
+            buffer_ = 0;
+            size_ = 0;
+        }
+    }
+};
+
+}
+
+#endif
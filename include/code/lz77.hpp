@@ -0,0 +1,335 @@
+/**
+ * code/lz77.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_LZ77_HPP
+#define _CODE_LZ77_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "binary.hpp"
+#include "concepts.hpp"
+#include "counter.hpp"
+#include "huffman.hpp"
+#include "internal/deflate_tables.hpp"
+
+namespace code {
+
+/**
+ * \brief Parameters of the LZ77 matcher
+ */
+struct LZ77Options {
+    /**
+     * \brief The maximum number of hash chain entries to inspect when searching a match
+     */
+    size_t max_chain = 64;
+
+    /**
+     * \brief Whether to use lazy matching
+     * 
+     * If enabled, a match is only taken if the match starting at the next position is not longer.
+     * Otherwise, matches are taken greedily.
+     */
+    bool lazy = true;
+
+    /**
+     * \brief The length at which a match is considered good enough, stopping the search and lazy evaluation
+     */
+    size_t nice_length = 128;
+
+    /**
+     * \brief The maximum number of literals and matches per block
+     * 
+     * The Huffman trees are rebuilt for every block, adapting them to changing input statistics.
+     */
+    size_t block_size = 65536;
+
+    /**
+     * \brief Constructs options for the given compression level
+     * 
+     * Levels 1 to 3 use greedy matching, higher levels use lazy matching and increasingly longer hash chain searches.
+     * 
+     * \param level the compression level between 1 and 9
+     * \return the options for the given compression level
+     */
+    static constexpr LZ77Options level(unsigned const level) {
+        constexpr size_t CHAIN[] = { 4, 8, 16, 16, 32, 64, 128, 512, 4096 };
+        constexpr size_t NICE[] = { 8, 16, 32, 32, 64, 128, 128, 258, 258 };
+
+        auto const i = std::clamp(level, 1U, 9U) - 1;
+        LZ77Options options;
+        options.max_chain = CHAIN[i];
+        options.lazy = i >= 3;
+        options.nice_length = NICE[i];
+        return options;
+    }
+};
+
+/**
+ * \brief LZ77 compression with Huffman coded literals, lengths and distances
+ * 
+ * The input is parsed into literals and back references (matches) into a window of the preceding 32 KiB using a hash chain matcher.
+ * Similar to DEFLATE, literals and match lengths share one alphabet, where match lengths are represented by buckets, and distances are represented by buckets in another alphabet.
+ * The exact values within the buckets are encoded as extra bits using \ref code::Binary "Binary" codes.
+ * 
+ * The parsing is divided into blocks. For each block, one \ref code::HuffmanTree "HuffmanTree" is constructed for the literal/length alphabet
+ * and one for the distance alphabet. Both trees are encoded at the beginning of the block, followed by the block's symbols and an end-of-block symbol.
+ * Each block is preceded by a 1-bit, and the end of the compressed data is marked by a 0-bit.
+ */
+class LZ77 {
+private:
+    static constexpr size_t WINDOW = internal::deflate::MAX_DISTANCE;
+    static constexpr size_t MIN_MATCH = 3;
+    static constexpr size_t MAX_MATCH = internal::deflate::MAX_MATCH;
+    static constexpr size_t HASH_BITS = 15;
+
+    struct Match {
+        size_t len;
+        size_t dist;
+    };
+
+    struct Token {
+        uint16_t len;  // the match length, or zero for literals
+        uint16_t value; // the match distance, or the literal
+    };
+
+    class Matcher {
+    private:
+        uint8_t const* in_;
+        size_t n_;
+        LZ77Options options_;
+
+        std::vector<int32_t> head_;
+        std::vector<int32_t> prev_;
+
+        inline size_t hash(size_t const i) const {
+            uint32_t const x = uint32_t(in_[i]) | (uint32_t(in_[i + 1]) << 8) | (uint32_t(in_[i + 2]) << 16);
+            return (x * 2654435761U) >> (32 - HASH_BITS);
+        }
+
+    public:
+        Matcher(uint8_t const* in, size_t const n, LZ77Options const& options)
+            : in_(in), n_(n), options_(options), head_(size_t(1) << HASH_BITS, -1), prev_(WINDOW, -1) {
+        }
+
+        inline void insert(size_t const i) {
+            if(i + MIN_MATCH <= n_) {
+                auto const h = hash(i);
+                prev_[i & (WINDOW - 1)] = head_[h];
+                head_[h] = int32_t(i);
+            }
+        }
+
+        Match find(size_t const i) const {
+            Match best { 0, 0 };
+            if(i + MIN_MATCH > n_) return best;
+
+            size_t const max_len = std::min(MAX_MATCH, n_ - i);
+            size_t const nice = std::min(options_.nice_length, max_len);
+            auto const* cur = in_ + i;
+
+            auto cand = head_[hash(i)];
+            for(size_t chain = options_.max_chain; chain && cand >= 0 && i - cand <= WINDOW; --chain) {
+                auto const* p = in_ + cand;
+                if(p[best.len] == cur[best.len]) { // nb: quick check whether the candidate can improve the match
+                    size_t len = 0;
+                    while(len < max_len && p[len] == cur[len]) ++len;
+                    if(len > best.len) {
+                        best = Match { len, i - cand };
+                        if(len >= nice) break;
+                    }
+                }
+
+                auto const next = prev_[cand & (WINDOW - 1)];
+                if(next >= cand) break; // nb: the entry has been overwritten
+                cand = next;
+            }
+
+            if(best.len < MIN_MATCH) best.len = 0;
+            return best;
+        }
+    };
+
+    template<BitSink Sink>
+    static void encode_block(Sink& sink, std::vector<Token> const& tokens) {
+        using namespace internal::deflate;
+
+        // compute histograms
+        Counter<uint16_t> litlen_hist;
+        Counter<uint8_t> dist_hist;
+        for(auto const& t : tokens) {
+            if(t.len) {
+                litlen_hist.count(uint16_t(257 + length_index(t.len)));
+                dist_hist.count(uint8_t(dist_index(t.value)));
+            } else {
+                litlen_hist.count(t.value);
+            }
+        }
+        litlen_hist.count(END_OF_BLOCK);
+
+        // nb: a Huffman tree needs at least two characters, unless it is empty
+        if(litlen_hist.size() == 1) litlen_hist.set(0, 0);
+        if(dist_hist.size() == 1) dist_hist.set(dist_hist.begin()->first ? 0 : 1, 0);
+
+        // construct and encode Huffman trees
+        HuffmanTree<uint16_t> litlen_tree(litlen_hist);
+        HuffmanTree<uint8_t> dist_tree(dist_hist);
+
+        sink.write(1);
+        litlen_tree.encode(sink);
+        dist_tree.encode(sink);
+
+        // encode symbols
+        auto const litlen = litlen_tree.table();
+        auto const dist = dist_tree.table();
+        for(auto const& t : tokens) {
+            if(t.len) {
+                auto const li = length_index(t.len);
+                Huffman::encode(sink, 257 + li, litlen);
+                if(LENGTH_EXTRA[li]) Binary::encode(sink, t.len - LENGTH_BASE[li], LENGTH_EXTRA[li]);
+
+                auto const di = dist_index(t.value);
+                Huffman::encode(sink, di, dist);
+                if(DIST_EXTRA[di]) Binary::encode(sink, t.value - DIST_BASE[di], DIST_EXTRA[di]);
+            } else {
+                Huffman::encode(sink, t.value, litlen);
+            }
+        }
+        Huffman::encode(sink, END_OF_BLOCK, litlen);
+    }
+
+public:
+    /**
+     * \brief Compresses the given input
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param in the input
+     * \param num the length of the input
+     * \param options the matcher parameters
+     */
+    template<BitSink Sink>
+    static void encode(Sink& sink, uint8_t const* in, size_t const num, LZ77Options const& options = LZ77Options()) {
+        Matcher matcher(in, num, options);
+
+        std::vector<Token> tokens;
+        tokens.reserve(options.block_size);
+
+        auto emit = [&](Token const t){
+            tokens.push_back(t);
+            if(tokens.size() >= options.block_size) {
+                encode_block(sink, tokens);
+                tokens.clear();
+            }
+        };
+
+        // emits a match and inserts the covered positions from the given one into the hash chains
+        auto emit_match = [&](Match const& m, size_t const i, size_t const insert_from){
+            emit(Token { uint16_t(m.len), uint16_t(m.dist) });
+            for(size_t k = insert_from; k < i + m.len; k++) matcher.insert(k);
+        };
+
+        size_t i = 0;
+        auto cur = matcher.find(i);
+        while(i < num) {
+            if(!cur.len) {
+                // no match, emit literal
+                emit(Token { 0, in[i] });
+                matcher.insert(i);
+                cur = matcher.find(++i);
+            } else if(options.lazy && cur.len < options.nice_length) {
+                // lazy evaluation: test whether the next position yields a longer match
+                matcher.insert(i);
+                auto const next = matcher.find(i + 1);
+                if(next.len > cur.len) {
+                    emit(Token { 0, in[i] });
+                    ++i;
+                    cur = next;
+                } else {
+                    emit_match(cur, i, i + 1);
+                    i += cur.len;
+                    cur = matcher.find(i);
+                }
+            } else {
+                emit_match(cur, i, i);
+                i += cur.len;
+                cur = matcher.find(i);
+            }
+        }
+
+        if(!tokens.empty()) encode_block(sink, tokens);
+        sink.write(0);
+    }
+
+    /**
+     * \brief Decompresses data that has been compressed using \ref encode
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param out the output vector, to which the decompressed data is appended
+     */
+    template<BitSource Source>
+    static void decode(Source& src, std::vector<uint8_t>& out) {
+        using namespace internal::deflate;
+
+        [[maybe_unused]] auto const start = out.size();
+        while(src.read()) {
+            // decode Huffman trees
+            HuffmanTree<uint16_t> litlen(src);
+            HuffmanTree<uint8_t> dist(src);
+
+            // decode symbols
+            while(true) {
+                auto const sym = Huffman::decode(src, litlen.root());
+                if(sym < 256) {
+                    out.push_back(uint8_t(sym));
+                } else if(sym == END_OF_BLOCK) {
+                    break;
+                } else {
+                    auto const li = sym - 257;
+                    size_t const len = LENGTH_BASE[li] + (LENGTH_EXTRA[li] ? Binary::decode(src, LENGTH_EXTRA[li]) : 0);
+
+                    auto const di = Huffman::decode(src, dist.root());
+                    size_t const d = DIST_BASE[di] + (DIST_EXTRA[di] ? Binary::decode(src, DIST_EXTRA[di]) : 0);
+                    assert(d <= out.size() - start);
+
+                    // nb: the match may overlap with its own output
+                    auto p = out.size() - d;
+                    for(size_t k = 0; k < len; k++) out.push_back(out[p + k]);
+                }
+            }
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * code/move_to_front.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_MOVE_TO_FRONT_HPP
+#define _CODE_MOVE_TO_FRONT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "internal/mtf_simd.hpp"
+
+namespace code {
+
+/**
+ * \brief The move-to-front (MTF) transform of bytes
+ * 
+ * The transform maintains a list of all 256 byte values, initially in ascending order.
+ * Each input byte is replaced by its current position (rank) in the list and then moved to the front of the list.
+ * Recently seen bytes thus receive small ranks, so for inputs with strong locality, such as the Burrows-Wheeler transform of a text,
+ * the output consists mostly of small integers that are well suited for \ref code::Huffman "Huffman", \ref code::EliasGamma "EliasGamma"
+ * or \ref code::Unary "Unary" codes, particularly after \ref code::ZeroRunLength "ZeroRunLength" coding.
+ * 
+ * The list is kept between calls, so a long input can be transformed in multiple pieces.
+ * It can also be saved and restored, so this class satisfies the \ref code::Checkpointable "Checkpointable" concept.
+ * If AVX2 is available, the list is searched and shifted using vector instructions.
+ */
+class MoveToFront {
+private:
+    static constexpr size_t PADDING = 32;
+
+    alignas(32) uint8_t storage_[PADDING + 256];
+
+    inline uint8_t* list() { return storage_ + PADDING; }
+
+    inline size_t find(uint8_t const c) {
+        #ifdef __AVX2__
+        return internal::mtf_find_avx2(list(), c);
+        #else
+        return (uint8_t const*)std::memchr(list(), c, 256) - list();
+        #endif
+    }
+
+    // moves the entry at the given rank to the front
+    inline void move_to_front(size_t const rank, uint8_t const c) {
+        #ifdef __AVX2__
+        if(rank < 32) {
+            internal::mtf_shift32_avx2(list(), rank);
+        } else {
+            std::memmove(list() + 1, list(), rank);
+        }
+        #else
+        std::memmove(list() + 1, list(), rank);
+        #endif
+        list()[0] = c;
+    }
+
+public:
+    /**
+     * \brief Constructs the transform with the initial list
+     */
+    MoveToFront() {
+        reset();
+    }
+
+    /**
+     * \brief Resets the list to its initial state, where the byte values are in ascending order
+     */
+    void reset() {
+        std::memset(storage_, 0, PADDING);
+        for(size_t i = 0; i < 256; i++) list()[i] = uint8_t(i);
+    }
+
+    /**
+     * \brief Transforms bytes into their ranks
+     * 
+     * \param in the input bytes
+     * \param num the number of bytes
+     * \param out the output, which must have space for \c num ranks and may equal \c in
+     */
+    void encode(uint8_t const* in, size_t num, uint8_t* out) {
+        while(num--) {
+            auto const c = *in++;
+            if(list()[0] == c) {
+                *out++ = 0;
+            } else {
+                auto const rank = find(c);
+                move_to_front(rank, c);
+                *out++ = uint8_t(rank);
+            }
+        }
+    }
+
+    /**
+     * \brief Transforms ranks back into bytes
+     * 
+     * \param in the input ranks
+     * \param num the number of ranks
+     * \param out the output, which must have space for \c num bytes and may equal \c in
+     */
+    void decode(uint8_t const* in, size_t num, uint8_t* out) {
+        while(num--) {
+            auto const rank = *in++;
+            auto const c = list()[rank];
+            if(rank) move_to_front(rank, c);
+            *out++ = c;
+        }
+    }
+
+    /**
+     * \brief Saves the current list
+     * 
+     * \param state the state words to append to
+     */
+    void save_state(std::vector<uint64_t>& state) const {
+        auto const* words = storage_ + PADDING;
+        for(size_t i = 0; i < 256; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, words + i, 8);
+            state.push_back(w);
+        }
+    }
+
+    /**
+     * \brief Restores a saved list
+     * 
+     * \param state the state words, which are advanced past the restored state
+     */
+    void load_state(uint64_t const*& state) {
+        std::memcpy(list(), state, 256);
+        state += 256 / 8;
+    }
+};
+
+}
+
+#endif
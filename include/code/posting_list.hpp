@@ -0,0 +1,441 @@
+/**
+ * code/posting_list.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_POSTING_LIST_HPP
+#define _CODE_POSTING_LIST_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+#include "binary.hpp"
+#include "rice.hpp"
+#include "vbyte.hpp"
+
+#include "internal/bit_buffer.hpp"
+#include "internal/intersect_simd.hpp"
+
+namespace code {
+
+/**
+ * \brief The codecs available for encoding the blocks of a \ref code::PostingList "PostingList"
+ */
+enum class PostingCodec {
+    /// \brief Binary codes using the bit width of the largest gap in the block
+    bit_packing,
+    /// \brief Rice codes using an exponent chosen per block
+    rice,
+    /// \brief Variable byte codes
+    vbyte,
+};
+
+/**
+ * \brief A block-compressed posting list, i.e., a strictly increasing sequence of 32-bit document identifiers
+ * 
+ * The list is split into blocks, and the gaps within each block are encoded using one of the codecs given by \ref code::PostingCodec "PostingCodec".
+ * A skip table stores the maximum value and the bit offset of each block, so blocks can be located and decoded individually.
+ * 
+ * Lists are traversed using a \ref Cursor, which supports galloping searches (\ref Cursor::next_geq) over the skip table.
+ * The \ref intersect operator uses the skip table to decode only blocks whose value ranges overlap and intersects decoded blocks using SIMD instructions if available.
+ */
+class PostingList {
+public:
+    /**
+     * \brief The value reported by cursors that have passed the end of the list
+     */
+    static constexpr uint32_t END = UINT32_MAX;
+
+private:
+    static constexpr uint8_t VBYTE_BITS = 7;
+    static constexpr Universe WIDTH_UNIVERSE = Universe(0, 32);
+    static constexpr Universe EXPONENT_UNIVERSE = Universe(0, 31);
+
+    size_t size_;
+    size_t block_size_;
+    PostingCodec codec_;
+    std::vector<uint64_t> bits_;
+    std::vector<uint32_t> block_max_;
+    std::vector<uint64_t> block_offset_;
+
+    inline size_t num_values(size_t const block) const {
+        return std::min(block_size_, size_ - block * block_size_);
+    }
+
+    // the smallest value that a block may contain
+    inline uint32_t lower_bound(size_t const block) const {
+        return block ? block_max_[block - 1] + 1 : 0;
+    }
+
+    // finds the first block starting at the given block whose maximum is at least x using a galloping search
+    size_t find_block(uint32_t const x, size_t const from) const {
+        auto const n = num_blocks();
+        if(from >= n || block_max_[from] >= x) return from;
+
+        size_t lo = from, step = 1;
+        while(lo + step < n && block_max_[lo + step] < x) {
+            lo += step;
+            step *= 2;
+        }
+        auto const hi = std::min(lo + step, n);
+        return (size_t)(std::lower_bound(block_max_.begin() + lo + 1, block_max_.begin() + hi, x) - block_max_.begin());
+    }
+
+    template<typename Sink>
+    void encode_block(Sink& sink, uint32_t const* gaps, size_t const num) {
+        switch(codec_) {
+            case PostingCodec::bit_packing: {
+                uint32_t max = 0;
+                for(size_t i = 0; i < num; i++) max = std::max(max, gaps[i]);
+                auto const width = (size_t)std::bit_width(max);
+                Binary::encode(sink, width, WIDTH_UNIVERSE);
+                for(size_t i = 0; i < num; i++) Binary::encode(sink, gaps[i], width);
+                break;
+            }
+
+            case PostingCodec::rice: {
+                auto const p = Rice::optimal_exponent(gaps, num);
+                Binary::encode(sink, p, EXPONENT_UNIVERSE);
+                Rice::encode_bulk(sink, gaps, num, p);
+                break;
+            }
+
+            case PostingCodec::vbyte:
+                for(size_t i = 0; i < num; i++) Vbyte::encode(sink, gaps[i], VBYTE_BITS);
+                break;
+        }
+    }
+
+    // decodes the values of the given block and returns their number
+    size_t decode_block(size_t const block, uint32_t* out) const {
+        auto const num = num_values(block);
+        internal::BitBufferSource src(bits_.data(), block_offset_[block]);
+
+        // decode gaps
+        switch(codec_) {
+            case PostingCodec::bit_packing: {
+                auto const width = (size_t)Binary::decode(src, WIDTH_UNIVERSE);
+                for(size_t i = 0; i < num; i++) out[i] = (uint32_t)src.read(width);
+                break;
+            }
+
+            case PostingCodec::rice: {
+                auto const p = (uint8_t)Binary::decode(src, EXPONENT_UNIVERSE);
+                for(size_t i = 0; i < num; i++) out[i] = (uint32_t)Rice::decode(src, p);
+                break;
+            }
+
+            case PostingCodec::vbyte:
+                for(size_t i = 0; i < num; i++) out[i] = (uint32_t)Vbyte::decode(src, VBYTE_BITS);
+                break;
+        }
+
+        // prefix sums
+        uint32_t v = lower_bound(block) + out[0];
+        out[0] = v;
+        for(size_t i = 1; i < num; i++) {
+            v += out[i] + 1;
+            out[i] = v;
+        }
+        return num;
+    }
+
+public:
+    /**
+     * \brief Traverses a posting list in ascending order
+     * 
+     * Only the current block is held in decoded form.
+     */
+    class Cursor {
+    private:
+        PostingList const* list_;
+        std::vector<uint32_t> values_;
+        size_t block_;
+        size_t num_;
+        size_t pos_;
+
+        inline void load(size_t const block) {
+            block_ = block;
+            pos_ = 0;
+            num_ = block < list_->num_blocks() ? list_->decode_block(block, values_.data()) : 0;
+        }
+
+    public:
+        /**
+         * \brief Constructs a cursor pointing to the first value of the given list
+         * 
+         * \param list the posting list
+         */
+        Cursor(PostingList const& list) : list_(&list), values_(list.block_size_) {
+            load(0);
+        }
+
+        /**
+         * \brief Tests whether the cursor has passed the end of the list
+         * 
+         * \return true if there are no more values, false otherwise
+         */
+        inline bool end() const { return pos_ >= num_; }
+
+        /**
+         * \brief Reports the current value
+         * 
+         * \return the current value, or \ref END if the cursor has passed the end of the list
+         */
+        inline uint32_t value() const { return end() ? END : values_[pos_]; }
+
+        /**
+         * \brief Advances to the next value
+         * 
+         * \return the next value, or \ref END if the cursor has passed the end of the list
+         */
+        inline uint32_t next() {
+            if(++pos_ >= num_ && num_ > 0) load(block_ + 1);
+            return value();
+        }
+
+        /**
+         * \brief Advances to the first value that is greater than or equal to the given value
+         * 
+         * The cursor does not move if the current value already satisfies the condition.
+         * Blocks are skipped using a galloping search over the skip table, and the decoded block is searched using a galloping search.
+         * 
+         * \param x the value to search
+         * \return the first value greater than or equal to \c x, or \ref END if there is none
+         */
+        uint32_t next_geq(uint32_t const x) {
+            if(end() || values_[pos_] >= x) return value();
+
+            if(values_[num_ - 1] < x) {
+                load(list_->find_block(x, block_ + 1));
+                if(end()) return END;
+            }
+
+            // gallop within the block
+            size_t lo = pos_, step = 1;
+            while(lo + step < num_ && values_[lo + step] < x) {
+                lo += step;
+                step *= 2;
+            }
+            auto const hi = std::min(lo + step, num_);
+            pos_ = (size_t)(std::lower_bound(values_.begin() + lo, values_.begin() + hi, x) - values_.begin());
+            return value();
+        }
+    };
+
+    /**
+     * \brief Constructs an empty posting list
+     */
+    PostingList() : size_(0), block_size_(1), codec_(PostingCodec::bit_packing) {
+    }
+
+    /**
+     * \brief Constructs a posting list from the given values
+     * 
+     * \tparam It the input iterator type
+     * \param begin the first value
+     * \param end the end of the values, which must be strictly increasing and less than \ref END
+     * \param codec the codec used for encoding the blocks
+     * \param block_size the number of values per block
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, uint32_t>
+    PostingList(It begin, It const end, PostingCodec const codec = PostingCodec::bit_packing, size_t const block_size = 128)
+        : size_(0), block_size_(block_size), codec_(codec) {
+
+        assert(block_size > 0);
+
+        internal::BitBufferSink sink(bits_);
+        std::vector<uint32_t> gaps;
+        gaps.reserve(block_size);
+
+        uint32_t prev = 0;
+        auto flush = [&](){
+            block_max_.push_back(prev);
+            block_offset_.push_back(sink.num_bits_written());
+            encode_block(sink, gaps.data(), gaps.size());
+            gaps.clear();
+        };
+
+        while(begin != end) {
+            uint32_t const x = *begin++;
+            assert(x < END);
+            if(gaps.empty()) {
+                assert(size_ == 0 || x > prev);
+                gaps.push_back(x - lower_bound(block_max_.size()));
+            } else {
+                assert(x > prev);
+                gaps.push_back(x - prev - 1);
+            }
+            prev = x;
+            ++size_;
+            if(gaps.size() == block_size) flush();
+        }
+        if(!gaps.empty()) flush();
+    }
+
+    /**
+     * \brief Reports the number of values
+     * 
+     * \return the number of values
+     */
+    inline size_t size() const { return size_; }
+
+    /**
+     * \brief Reports the number of blocks
+     * 
+     * \return the number of blocks
+     */
+    inline size_t num_blocks() const { return block_max_.size(); }
+
+    /**
+     * \brief Reports the codec used for encoding the blocks
+     * 
+     * \return the codec
+     */
+    inline PostingCodec codec() const { return codec_; }
+
+    /**
+     * \brief Constructs a cursor pointing to the first value
+     * 
+     * \return the cursor
+     */
+    inline Cursor cursor() const { return Cursor(*this); }
+
+    /**
+     * \brief Decodes all values
+     * 
+     * \tparam OutputIt the output iterator type
+     * \param out the output
+     */
+    template<std::output_iterator<uint32_t> OutputIt>
+    void decode(OutputIt out) const {
+        std::vector<uint32_t> values(block_size_);
+        for(size_t b = 0; b < num_blocks(); b++) {
+            auto const num = decode_block(b, values.data());
+            out = std::copy(values.begin(), values.begin() + num, out);
+        }
+    }
+
+    /**
+     * \brief Reports the total size of the encoded blocks and the skip table in bits
+     * 
+     * \return the size in bits
+     */
+    inline size_t size_in_bits() const {
+        return 64 * bits_.size() + 32 * block_max_.size() + 64 * block_offset_.size();
+    }
+
+    /**
+     * \brief Computes the intersection of two posting lists
+     * 
+     * Pairs of blocks whose value ranges do not overlap according to the skip tables are skipped without decoding them,
+     * and the remaining pairs of blocks are intersected using SIMD instructions if available.
+     * 
+     * \tparam OutputIt the output iterator type
+     * \param a the first posting list
+     * \param b the second posting list
+     * \param out the output, which receives the common values in ascending order
+     * \return the number of common values
+     */
+    template<std::output_iterator<uint32_t> OutputIt>
+    static size_t intersect(PostingList const& a, PostingList const& b, OutputIt out) {
+        std::vector<uint32_t> va(a.block_size_), vb(b.block_size_);
+        std::vector<uint32_t> common(std::min(a.block_size_, b.block_size_) + internal::INTERSECT_SIMD_OVERHANG);
+        size_t da = SIZE_MAX, db = SIZE_MAX;
+        size_t na = 0, nb = 0;
+
+        size_t total = 0;
+        size_t i = 0, j = 0;
+        while(i < a.num_blocks() && j < b.num_blocks()) {
+            // skip blocks that cannot overlap
+            if(a.block_max_[i] < b.lower_bound(j)) {
+                i = a.find_block(b.lower_bound(j), i + 1);
+                continue;
+            }
+            if(b.block_max_[j] < a.lower_bound(i)) {
+                j = b.find_block(a.lower_bound(i), j + 1);
+                continue;
+            }
+
+            if(da != i) { na = a.decode_block(i, va.data()); da = i; }
+            if(db != j) { nb = b.decode_block(j, vb.data()); db = j; }
+
+            // intersect the overlapping parts
+            auto const* pa = std::lower_bound(va.data(), va.data() + na, vb[0]);
+            auto const* pb = std::lower_bound(vb.data(), vb.data() + nb, va[0]);
+            auto const k = internal::intersect_sorted(pa, va.data() + na - pa, pb, vb.data() + nb - pb, common.data());
+            out = std::copy(common.begin(), common.begin() + k, out);
+            total += k;
+
+            auto const max_a = a.block_max_[i];
+            auto const max_b = b.block_max_[j];
+            if(max_a <= max_b) ++i;
+            if(max_b <= max_a) ++j;
+        }
+        return total;
+    }
+
+    /**
+     * \brief Computes the union of two posting lists
+     * 
+     * \tparam OutputIt the output iterator type
+     * \param a the first posting list
+     * \param b the second posting list
+     * \param out the output, which receives the values contained in either list in ascending order
+     * \return the number of values in the union
+     */
+    template<std::output_iterator<uint32_t> OutputIt>
+    static size_t unite(PostingList const& a, PostingList const& b, OutputIt out) {
+        auto ca = a.cursor();
+        auto cb = b.cursor();
+
+        size_t total = 0;
+        auto x = ca.value();
+        auto y = cb.value();
+        while(x != END || y != END) {
+            if(x < y) {
+                *out++ = x;
+                x = ca.next();
+            } else if(y < x) {
+                *out++ = y;
+                y = cb.next();
+            } else {
+                *out++ = x;
+                x = ca.next();
+                y = cb.next();
+            }
+            ++total;
+        }
+        return total;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * code/prefix_varint.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_PREFIX_VARINT_HPP
+#define _CODE_PREFIX_VARINT_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace code {
+
+/**
+ * \brief Prefix varint encoding and decoding of 64-bit integers
+ * 
+ * A codeword consists of \c n bytes, where the first byte starts with <tt>n-1</tt> zero bits followed by a one bit.
+ * The remaining <tt>7n</tt> bits contain the integer in big endian order, so integers of up to 56 bits are encoded using at most eight bytes.
+ * Larger integers are encoded using nine bytes, where the first byte is zero and the remaining eight bytes contain the integer.
+ * 
+ * In contrast to \ref code::Vbyte "Vbyte", the length of a codeword is known from its first byte.
+ * Thus, decoding requires a single leading zero count and a single unaligned load instead of a loop over the bytes,
+ * which makes prefix varints well suited for decoding single values in random-access record layouts.
+ * 
+ * The fast decoder loads eight bytes starting at the first byte of a codeword, i.e., it may read up to \ref PADDING bytes beyond the codeword.
+ * The input buffer must be padded accordingly, or \ref decode_safe must be used.
+ */
+class PrefixVarint {
+private:
+    inline static uint64_t load_be64(uint8_t const* p) {
+        uint64_t x;
+        std::memcpy(&x, p, 8);
+        if constexpr(std::endian::native == std::endian::little) x = __builtin_bswap64(x);
+        return x;
+    }
+
+    inline static void store_be64(uint8_t* p, uint64_t x) {
+        if constexpr(std::endian::native == std::endian::little) x = __builtin_bswap64(x);
+        std::memcpy(p, &x, 8);
+    }
+
+public:
+    /**
+     * \brief The number of bytes that the fast decoder may read beyond the end of a codeword
+     */
+    static constexpr size_t PADDING = 7;
+
+    /**
+     * \brief The maximum length of a codeword in bytes
+     */
+    static constexpr size_t MAX_LENGTH = 9;
+
+    /**
+     * \brief Computes the length of the codeword for the given integer
+     * 
+     * \param x the integer
+     * \return the length of the codeword in bytes
+     */
+    inline static constexpr size_t length(uint64_t const x) {
+        auto const w = (size_t)std::bit_width(x);
+        return w <= 56 ? std::max(size_t(1), (w + 6) / 7) : MAX_LENGTH;
+    }
+
+    /**
+     * \brief Determines the length of a codeword from its first byte
+     * 
+     * \param first the first byte of the codeword
+     * \return the length of the codeword in bytes
+     */
+    inline static constexpr size_t length_of(uint8_t const first) {
+        return std::countl_zero(first) + 1;
+    }
+
+    /**
+     * \brief Encodes an integer
+     * 
+     * \param out the output buffer, which must have space for \ref length "length(x)" bytes
+     * \param x the integer to encode
+     * \return a pointer to the first byte following the codeword
+     */
+    inline static uint8_t* encode(uint8_t* out, uint64_t const x) {
+        auto const n = length(x);
+        if(n == MAX_LENGTH) {
+            *out++ = 0;
+            store_be64(out, x);
+            return out + 8;
+        }
+
+        // place the marker bit above the payload and align the codeword to the most significant byte
+        uint64_t v = (x | (uint64_t(1) << (7 * n))) << (64 - 8 * n);
+        if constexpr(std::endian::native == std::endian::little) v = __builtin_bswap64(v);
+        std::memcpy(out, &v, n);
+        return out + n;
+    }
+
+    /**
+     * \brief Decodes an integer
+     * 
+     * Eight bytes are loaded starting at the input, so the input buffer must be padded by \ref PADDING bytes.
+     * 
+     * \param in the input buffer, which is advanced to the first byte following the codeword
+     * \return the decoded integer
+     */
+    inline static uint64_t decode(uint8_t const*& in) {
+        auto const n = length_of(*in);
+        if(n == MAX_LENGTH) [[unlikely]] {
+            auto const x = load_be64(in + 1);
+            in += MAX_LENGTH;
+            return x;
+        }
+
+        auto const x = (load_be64(in) >> (64 - 8 * n)) & ((uint64_t(1) << (7 * n)) - 1);
+        in += n;
+        return x;
+    }
+
+    /**
+     * \brief Decodes an integer without reading beyond the codeword
+     * 
+     * \param in the input buffer, which is advanced to the first byte following the codeword
+     * \return the decoded integer
+     */
+    inline static uint64_t decode_safe(uint8_t const*& in) {
+        auto const n = length_of(*in);
+        uint64_t x = (n == MAX_LENGTH) ? 0 : (*in & (0xFFU >> n));
+        for(size_t i = 1; i < n; i++) x = (x << 8) | in[i];
+        in += n;
+        return x;
+    }
+
+    /**
+     * \brief Encodes a sequence of integers
+     * 
+     * \tparam It the input iterator type
+     * \param out the output buffer, which must have sufficient space
+     * \param begin the first integer to encode
+     * \param end the end of the input
+     * \return a pointer to the first byte following the encoded codewords
+     */
+    template<std::input_iterator It>
+    static uint8_t* encode_bulk(uint8_t* out, It begin, It const end) {
+        while(begin != end) out = encode(out, *begin++);
+        return out;
+    }
+
+    /**
+     * \brief Decodes a sequence of integers
+     * 
+     * Only the last few codewords are decoded without reading beyond the input, so the input buffer need not be padded.
+     * 
+     * \tparam OutputIt the output iterator type
+     * \param in the input buffer
+     * \param out the output
+     * \param num the number of integers to decode
+     * \param size the size of the input buffer in bytes
+     * \return a pointer to the first byte following the decoded codewords
+     */
+    template<std::output_iterator<uint64_t> OutputIt>
+    static uint8_t const* decode_bulk(uint8_t const* in, OutputIt out, size_t num, size_t const size) {
+        // nb: a codeword has at most nine bytes, so the fast decoder is safe while at least 16 bytes remain
+        auto const* const end = in + size;
+        while(num && end - in >= 16) {
+            *out++ = decode(in);
+            --num;
+        }
+        while(num--) *out++ = decode_safe(in);
+        return in;
+    }
+};
+
+}
+
+#endif
@@ -30,27 +30,32 @@
 
 #include <algorithm>
 #include <concepts>
+#include <cstdint>
+#include <limits>
 
 namespace code {
 
 /**
- * \brief Represents a range of unsigned integers
+ * \brief Represents a range of unsigned integers of the given type
  * 
- * Ranges are typically used to setup a \ref code::Universe by initializing an empty range, and then
- * extending it by contained integers while processing an input. \ref code::Universe offers construction
+ * Ranges are typically used to setup a \ref code::BasicUniverse "Universe" by initializing an empty range, and then
+ * extending it by contained integers while processing an input. \ref code::BasicUniverse "Universe" offers construction
  * from a range, but not vice versa.
+ * 
+ * \tparam Int the unsigned integer type
  */
-class Range {
+template<std::unsigned_integral Int>
+class BasicRange {
 private:
-    uintmax_t min_, max_;
+    Int min_, max_;
 
 public:
     /**
      * \brief Constructs an empty range
      * 
      */
-    inline Range() {
-        min_ = UINTMAX_MAX;
+    inline BasicRange() {
+        min_ = std::numeric_limits<Int>::max();
         max_ = 0;
     }
 
@@ -60,13 +65,13 @@ public:
      * \param min the range's lower bound
      * \param max the range's upper bound
      */
-    inline Range(uintmax_t const min, uintmax_t const max) : min_(min), max_(max) {
+    inline BasicRange(Int const min, Int const max) : min_(min), max_(max) {
     }
 
-    Range(Range const&) = default;
-    Range(Range&&) = default;
-    Range& operator=(Range const&) = default;
-    Range& operator=(Range&&) = default;
+    BasicRange(BasicRange const&) = default;
+    BasicRange(BasicRange&&) = default;
+    BasicRange& operator=(BasicRange const&) = default;
+    BasicRange& operator=(BasicRange&&) = default;
 
     /**
      * \brief Extends the range so that it contains the specified value
@@ -75,26 +80,32 @@ public:
      * \param value 
      */
     template<std::unsigned_integral T>
+    requires (std::numeric_limits<T>::digits <= std::numeric_limits<Int>::digits)
     void contain(T const value) {
-        min_ = std::min(min_, uintmax_t(value));
-        max_ = std::max(max_, uintmax_t(value));
+        min_ = std::min(min_, Int(value));
+        max_ = std::max(max_, Int(value));
     }
 
     /**
      * \brief Reports the range's current lower bound
      * 
-     * \return uintmax_t the range's current lower bound
+     * \return the range's current lower bound
      */
-    uintmax_t min() const { return min_; }
+    Int min() const { return min_; }
 
     /**
      * \brief Reports the range's current upper bound
      * 
-     * \return uintmax_t the range's current upper bound
+     * \return the range's current upper bound
      */
-    uintmax_t max() const { return max_; }
+    Int max() const { return max_; }
 };
 
+/**
+ * \brief A range of unsigned integers of the largest standard type
+ */
+using Range = BasicRange<uintmax_t>;
+
 }
 
 #endif
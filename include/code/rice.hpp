@@ -28,6 +28,15 @@
 #ifndef _CODE_RICE_HPP
 #define _CODE_RICE_HPP
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "bit_feed.hpp"
 #include "elias_gamma.hpp"
 
 namespace code {
@@ -41,7 +50,8 @@ namespace code {
  * The number of bits that the remainder is encoded with is determined by the universe of possible remainders for the divisor.
  * In rice coding, the divisor is a power of two.
  * 
- * Instances of this class satisfy both the \ref tdc::code::IntegerEncoder "IntegerEncoder" and the \ref tdc::code::IntegerDecoder "IntegerDecoder" concepts.
+ * Instances of this class satisfy both the \ref tdc::code::IntegerEncoder "IntegerEncoder" and the \ref tdc::code::IntegerDecoder "IntegerDecoder" concepts,
+ * as well as the \ref code::Checkpointable "Checkpointable" concept.
  */
 class Rice {
 public:
@@ -49,15 +59,19 @@ public:
      * \brief Encodes an integer using rice code with the specified divisor
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type
      * \param sink the bit sink
      * \param x the integer to encode
      * \param p the exponent of the Golomb divisor \c 2^p
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, uint8_t p) {
-        uintmax_t const q = x >> p;
-        EliasGamma::encode(sink, q + 1); // must not pass zero
-        Binary::encode(sink, x, p); // Golomb remainder equals the lowest p bits of v
+    template<BitSink Sink, internal::EncodableInteger Int>
+    inline static void encode(Sink& sink, Int const x, uint8_t p) {
+        using U = internal::encoded_t<Int>;
+        assert(p < std::numeric_limits<U>::digits);
+        U const v = x;
+        U const q = v >> p;
+        EliasGamma::encode(sink, U(q + 1)); // must not pass zero
+        Binary::encode(sink, v, p); // Golomb remainder equals the lowest p bits of v
     }
 
     /**
@@ -66,28 +80,103 @@ public:
      * This function actually encodes the value of the integer relative to the universe's minimum.
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type of the universe
      * \param sink the bit sink
      * \param x the integer to encode
      * \param p the exponent of the Golomb divisor \c 2^p
      * \param u the universe of \c x
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, uint8_t p, Universe u) {
+    template<BitSink Sink, std::unsigned_integral Int>
+    inline static void encode(Sink& sink, std::type_identity_t<Int> x, uint8_t p, BasicUniverse<Int> u) {
         encode(sink, u.rel(x), p);
     }
 
+    /**
+     * \brief Encodes a sequence of integers using rice code with the specified divisor
+     * 
+     * Each codeword is formed as a whole in a register, and the codewords are merged into 64-bit words before being written to the sink.
+     * If AVX-512 (including the conflict detection instructions) is available, the bit widths and codewords of multiple integers
+     * are computed at once using vectorized leading zero counts; blocks containing codewords longer than 64 bits are encoded using scalar code.
+     * 
+     * The output is identical to that of calling \ref encode for each integer, provided that the sink's
+     * \c write(bits, num) writes the lowest bit first (as in iopp).
+     * 
+     * \tparam Sink the bit sink type
+     * \tparam Int the integer type
+     * \param sink the bit sink
+     * \param input the integers to encode
+     * \param num the number of integers to encode
+     * \param p the exponent of the Golomb divisor \c 2^p
+     */
+    template<BitSink Sink, std::unsigned_integral Int>
+    static void encode_bulk(Sink& sink, Int const* input, size_t const num, uint8_t const p) {
+        if constexpr(internal::WideUnsigned<Int>) {
+            // nb: codewords of wide integers may not fit into a register
+            for(size_t i = 0; i < num; i++) encode(sink, input[i], p);
+            return;
+        }
+
+        internal::WordPacker<Sink> packer(sink);
+
+        size_t i = 0;
+        #if defined(__AVX512F__) && defined(__AVX512CD__)
+        if constexpr(sizeof(Int) == 4 || sizeof(Int) == 8) {
+            for(; i + internal::UNIVERSAL_AVX512_BLOCK <= num; i += internal::UNIVERSAL_AVX512_BLOCK) {
+                if(!internal::rice_encode_avx512(packer, input + i, p)) {
+                    for(size_t j = i; j < i + internal::UNIVERSAL_AVX512_BLOCK; j++) internal::append_rice(packer, input[j], p);
+                }
+            }
+        }
+        #endif
+        for(; i < num; i++) internal::append_rice(packer, input[i], p);
+    }
+
+    /**
+     * \brief Computes the exponent of the Golomb divisor that minimizes the size of the rice codes of the given integers
+     * 
+     * The optimal Golomb divisor is around 0.69 times the mean, so only exponents close to that estimate are considered.
+     * 
+     * \tparam Int the integer type
+     * \param input the integers to encode
+     * \param num the number of integers
+     * \return the exponent of the Golomb divisor
+     */
+    template<std::unsigned_integral Int>
+    requires (sizeof(Int) <= sizeof(uint64_t))
+    static uint8_t optimal_exponent(Int const* input, size_t const num) {
+        if(num == 0) return 0;
+
+        uint64_t sum = 0;
+        for(size_t i = 0; i < num; i++) sum += input[i];
+        auto const mean = sum / num;
+        auto const p0 = std::max(size_t(1), (size_t)std::bit_width(mean / 100 * 69 + mean % 100 * 69 / 100)) - 1; // nb: avoid overflow
+
+        uint8_t best_p = 0;
+        size_t best_size = SIZE_MAX;
+        for(size_t p = p0 >= 2 ? p0 - 2 : 0; p <= std::min(p0 + 2, size_t(std::numeric_limits<Int>::digits - 1)); p++) {
+            size_t size = 0;
+            for(size_t i = 0; i < num; i++) size += 2 * std::bit_width((uint64_t(input[i]) >> p) + 1) - 1 + p;
+            if(size < best_size) {
+                best_p = (uint8_t)p;
+                best_size = size;
+            }
+        }
+        return best_p;
+    }
+
     /**
      * \brief Decodes an integer using rice code with the specified divisor
      * 
+     * \tparam Int the integer type
      * \tparam Source the bit source type
      * \param src the bit sink
      * \param p the exponent of the Golomb divisor \c 2^p
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, uint8_t p) {
-        auto const q = EliasGamma::decode(src) - 1;
-        return (q << p) | Binary::decode(src, p);
+    template<std::unsigned_integral Int = uintmax_t, BitSource Source>
+    inline static Int decode(Source& src, uint8_t p) {
+        auto const q = EliasGamma::decode<Int>(src) - 1;
+        return (q << p) | Binary::decode<Int>(src, p);
     }
 
     /**
@@ -96,14 +185,15 @@ public:
      * This function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
      * 
      * \tparam Source the bit source type
+     * \tparam Int the integer type of the universe
      * \param src the bit source
      * \param p the exponent of the Golomb divisor \c 2^p
      * \param u the universe of the integer to decode
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, uint8_t p, Universe u) {
-        return u.abs(decode(src, p));
+    template<BitSource Source, std::unsigned_integral Int>
+    inline static Int decode(Source& src, uint8_t p, BasicUniverse<Int> u) {
+        return u.abs(decode<Int>(src, p));
     }
 
 private:
@@ -124,12 +214,13 @@ public:
      * This function actually encodes the value of the integer relative to the universe's minimum.
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type of the universe
      * \param sink the bit sink
      * \param x the integer to encode
      * \param u the universe of \c x
      */
-    template<BitSink Sink>
-    inline void encode(Sink& sink, uintmax_t x, Universe u) {
+    template<BitSink Sink, std::unsigned_integral Int>
+    inline void encode(Sink& sink, std::type_identity_t<Int> x, BasicUniverse<Int> u) {
         encode(sink, x, exponent_, u);
     }
 
@@ -139,12 +230,13 @@ public:
      * This function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
      * 
      * \tparam Source the bit source type
+     * \tparam Int the integer type of the universe
      * \param src the bit source
      * \param u the universe of the integer to decode
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline uintmax_t decode(Source& src, Universe u) {
+    template<BitSource Source, std::unsigned_integral Int>
+    inline Int decode(Source& src, BasicUniverse<Int> u) {
         return decode(src, exponent_, u);
     }
 
@@ -154,6 +246,86 @@ public:
      * \return the base-two exponent of the Golomb divisor used by this coder 
      */
     uint8_t exponent() const { return exponent_; }
+
+    /**
+     * \brief Saves the exponent of the Golomb divisor of this coder
+     * 
+     * \param state the state words to append to
+     */
+    void save_state(std::vector<uint64_t>& state) const { state.push_back(exponent_); }
+
+    /**
+     * \brief Restores the exponent of the Golomb divisor of this coder
+     * 
+     * \param state the state words, which are advanced past the restored state
+     */
+    void load_state(uint64_t const*& state) { exponent_ = (uint8_t)*state++; }
+
+    /**
+     * \brief Resumable decoding of rice codes from input that arrives in chunks
+     * 
+     * The gamma-coded quotient and the binary remainder are decoded by resumable decoders, so partial codewords are kept across calls.
+     */
+    class ResumableDecoder {
+    private:
+        uint8_t p_;
+        EliasGamma::ResumableDecoder gamma_;
+        Binary::ResumableDecoder binary_;
+        uintmax_t q_;
+        bool remainder_;
+
+    public:
+        /**
+         * \brief Constructs a decoder for the specified Golomb divisor
+         * 
+         * \param p the exponent of the Golomb divisor \c 2^p
+         */
+        ResumableDecoder(uint8_t p) : p_(p), binary_(p), q_(0), remainder_(false) {
+        }
+
+        /**
+         * \brief Decodes an integer using rice code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed) {
+            if(!remainder_) {
+                auto const q = gamma_.decode(feed);
+                if(!q) return std::nullopt;
+
+                q_ = *q - 1;
+                remainder_ = true;
+            }
+
+            auto const r = binary_.decode(feed);
+            if(!r) return std::nullopt;
+
+            remainder_ = false;
+            return (q_ << p_) | *r;
+        }
+
+        /**
+         * \brief Decodes an integer from the given universe using rice code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \param u the universe of the integer to decode
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed, Universe u) {
+            auto const x = decode(feed);
+            return x ? std::optional<uintmax_t>(u.abs(*x)) : std::nullopt;
+        }
+
+        /**
+         * \brief Discards the partially decoded codeword
+         */
+        void reset() {
+            gamma_.reset();
+            binary_.reset();
+            remainder_ = false;
+        }
+    };
 };
 
 }
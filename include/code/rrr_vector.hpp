@@ -0,0 +1,327 @@
+/**
+ * code/rrr_vector.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_RRR_VECTOR_HPP
+#define _CODE_RRR_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+#include "binary.hpp"
+#include "enumerative.hpp"
+
+#include "internal/bit_buffer.hpp"
+
+namespace code {
+
+/**
+ * \brief A compressed bit vector supporting rank and select queries (RRR)
+ * 
+ * The bits are split into blocks of \c BlockSize bits. Each block is represented by its \em class, i.e., its number of set bits,
+ * which is encoded using \ref code::Binary "Binary" over the universe <tt>[0, BlockSize]</tt>, and its \em offset, which is the rank
+ * of the block among all blocks of the same class in the combinatorial number system, encoded using \ref code::Enumerative "Enumerative" code.
+ * The offset of a block of class \c c thus takes <tt>ceil(log2(binomial(BlockSize, c)))</tt> bits;
+ * blocks of classes zero and \c BlockSize are unique and need no offset.
+ * 
+ * For every superblock of \c SuperblockSize blocks, the rank and the position of the first offset are sampled using the minimum number of bits.
+ * Rank and access queries decode at most one superblock's classes and a single offset and thus take constant time.
+ * Select queries are answered by a binary search over the superblocks narrowed down by sampled positions of every \ref SELECT_SAMPLE -th set or unset bit.
+ * 
+ * \tparam BlockSize the number of bits per block, less than 64
+ * \tparam SuperblockSize the number of blocks per superblock
+ */
+template<size_t BlockSize = 15, size_t SuperblockSize = 32>
+class RRRVector {
+private:
+    static_assert(BlockSize > 0 && BlockSize < 64);
+    static_assert(SuperblockSize > 0);
+
+    static constexpr Universe CLASS_UNIVERSE = Universe(0, BlockSize);
+    static constexpr size_t CLASS_BITS = CLASS_UNIVERSE.entropy();
+    static constexpr size_t SUPERBLOCK_BITS = BlockSize * SuperblockSize;
+
+    static constexpr std::array<uint8_t, BlockSize + 1> make_offset_bits() {
+        std::array<uint8_t, BlockSize + 1> bits {};
+        for(size_t c = 0; c <= BlockSize; c++) bits[c] = Enumerative::offset_bits(BlockSize, c);
+        return bits;
+    }
+
+    static constexpr auto OFFSET_BITS = make_offset_bits();
+
+    size_t size_;
+    size_t ones_;
+    std::vector<uint64_t> classes_;
+    std::vector<uint64_t> offsets_;
+    std::vector<uint64_t> samples_;
+    size_t num_superblocks_;
+    uint8_t rank_bits_;
+    uint8_t pos_bits_;
+    std::vector<uint32_t> select1_;
+    std::vector<uint32_t> select0_;
+
+    inline size_t num_blocks() const { return (size_ + BlockSize - 1) / BlockSize; }
+    inline size_t num_superblocks() const { return num_superblocks_; }
+
+    inline uint64_t sb_rank(size_t const sb) const {
+        return internal::BitBufferSource(samples_.data(), sb * (rank_bits_ + pos_bits_)).read(rank_bits_);
+    }
+
+    inline uint64_t sb_pos(size_t const sb) const {
+        return internal::BitBufferSource(samples_.data(), sb * (rank_bits_ + pos_bits_) + rank_bits_).read(pos_bits_);
+    }
+
+    inline size_t block_class(size_t const b) const {
+        return internal::BitBufferSource(classes_.data(), b * CLASS_BITS).read(CLASS_BITS);
+    }
+
+    inline uint64_t block_bits(size_t const pos, size_t const c) const {
+        auto const w = OFFSET_BITS[c];
+        if(w == 0) return c ? (uint64_t(1) << BlockSize) - 1 : 0;
+        return Enumerative::unrank<BlockSize>(internal::BitBufferSource(offsets_.data(), pos).read(w), c);
+    }
+
+    // the number of unset bits before the given superblock, including padding bits in the last block
+    inline uint64_t sb_zeros(size_t const sb) const {
+        return sb * SUPERBLOCK_BITS - sb_rank(sb);
+    }
+
+    // locates the block containing the k-th set (or unset) bit and reports the position of the bit
+    template<bool One>
+    size_t select(size_t k) const {
+        auto const& samples = One ? select1_ : select0_;
+        auto const count = [&](size_t const sb){ return One ? sb_rank(sb) : sb_zeros(sb); };
+
+        // find the last superblock preceding the k-th bit
+        auto const i = (k - 1) / SELECT_SAMPLE;
+        size_t lo = samples[i];
+        size_t hi = i + 1 < samples.size() ? samples[i + 1] + 1 : num_superblocks();
+        while(hi - lo > 1) {
+            auto const mid = lo + (hi - lo) / 2;
+            if(count(mid) < k) lo = mid; else hi = mid;
+        }
+
+        // scan blocks
+        k -= count(lo);
+        auto b = lo * SuperblockSize;
+        auto pos = sb_pos(lo);
+        while(true) {
+            auto const c = block_class(b);
+            auto const n = One ? c : BlockSize - c;
+            if(k <= n) {
+                auto bits = block_bits(pos, c);
+                if constexpr(!One) bits = ~bits;
+                for(; k > 1; k--) bits &= bits - 1;
+                return b * BlockSize + std::countr_zero(bits);
+            }
+            k -= n;
+            pos += OFFSET_BITS[c];
+            ++b;
+        }
+    }
+
+    template<bool One>
+    void sample_select() {
+        auto& samples = One ? select1_ : select0_;
+        auto const total = One ? ones_ : size_ - ones_;
+
+        size_t sb = 0;
+        for(size_t k = 1; k <= total; k += SELECT_SAMPLE) {
+            while(sb + 1 < num_superblocks() && (One ? sb_rank(sb + 1) : sb_zeros(sb + 1)) < k) ++sb;
+            samples.push_back((uint32_t)sb);
+        }
+    }
+
+public:
+    /**
+     * \brief The number of set or unset bits between two samples used for select queries
+     */
+    static constexpr size_t SELECT_SAMPLE = 8192;
+
+    /**
+     * \brief Constructs an empty bit vector
+     */
+    RRRVector() : RRRVector((bool const*)nullptr, (bool const*)nullptr) {
+    }
+
+    /**
+     * \brief Constructs a compressed bit vector from the given bits
+     * 
+     * \tparam It the input iterator type
+     * \param begin the first bit
+     * \param end the end of the bits
+     */
+    template<std::input_iterator It>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, bool>
+    RRRVector(It begin, It const end) : size_(0), ones_(0) {
+        internal::BitBufferSink classes(classes_);
+        internal::BitBufferSink offsets(offsets_);
+        std::vector<uint64_t> sb_rank, sb_pos;
+
+        size_t b = 0;
+        while(begin != end) {
+            // gather the next block
+            uint64_t bits = 0;
+            size_t i = 0;
+            for(; i < BlockSize && begin != end; i++) {
+                if((bool)*begin++) bits |= uint64_t(1) << i;
+            }
+            size_ += i;
+
+            if(b % SuperblockSize == 0) {
+                sb_rank.push_back(ones_);
+                sb_pos.push_back(offsets.num_bits_written());
+            }
+
+            auto const c = (size_t)std::popcount(bits);
+            Binary::encode(classes, c, CLASS_UNIVERSE);
+            if(OFFSET_BITS[c]) Enumerative::encode(offsets, bits, BlockSize, c);
+            ones_ += c;
+            ++b;
+        }
+
+        // nb: the sentinel superblock simplifies the binary search for select queries
+        sb_rank.push_back(ones_);
+        sb_pos.push_back(offsets.num_bits_written());
+
+        // pack superblock samples using the minimum number of bits
+        num_superblocks_ = sb_rank.size();
+        rank_bits_ = (uint8_t)Universe(0, ones_).entropy();
+        pos_bits_ = (uint8_t)Universe(0, sb_pos.back()).entropy();
+
+        internal::BitBufferSink samples(samples_);
+        for(size_t sb = 0; sb < num_superblocks_; sb++) {
+            Binary::encode(samples, sb_rank[sb], rank_bits_);
+            Binary::encode(samples, sb_pos[sb], pos_bits_);
+        }
+
+        sample_select<true>();
+        sample_select<false>();
+    }
+
+    /**
+     * \brief Reports the number of bits
+     * 
+     * \return the number of bits
+     */
+    inline size_t size() const { return size_; }
+
+    /**
+     * \brief Reports the number of set bits
+     * 
+     * \return the number of set bits
+     */
+    inline size_t num_ones() const { return ones_; }
+
+    /**
+     * \brief Reports the value of the bit at the given position
+     * 
+     * \param i the position, less than \ref size
+     * \return the bit at position \c i
+     */
+    bool operator[](size_t const i) const {
+        assert(i < size_);
+        auto const b = i / BlockSize;
+        auto const sb = b / SuperblockSize;
+
+        auto pos = sb_pos(sb);
+        for(auto j = sb * SuperblockSize; j < b; j++) pos += OFFSET_BITS[block_class(j)];
+        return (block_bits(pos, block_class(b)) >> (i % BlockSize)) & 1;
+    }
+
+    /**
+     * \brief Counts the set bits before the given position
+     * 
+     * \param i the position, at most \ref size
+     * \return the number of set bits in the range <tt>[0, i)</tt>
+     */
+    size_t rank1(size_t const i) const {
+        assert(i <= size_);
+        auto const b = i / BlockSize;
+        auto const sb = b / SuperblockSize;
+
+        size_t r = sb_rank(sb);
+        auto pos = sb_pos(sb);
+        for(auto j = sb * SuperblockSize; j < b; j++) {
+            auto const c = block_class(j);
+            r += c;
+            pos += OFFSET_BITS[c];
+        }
+
+        auto const o = i % BlockSize;
+        if(o) r += std::popcount(block_bits(pos, block_class(b)) & ((uint64_t(1) << o) - 1));
+        return r;
+    }
+
+    /**
+     * \brief Counts the unset bits before the given position
+     * 
+     * \param i the position, at most \ref size
+     * \return the number of unset bits in the range <tt>[0, i)</tt>
+     */
+    inline size_t rank0(size_t const i) const {
+        return i - rank1(i);
+    }
+
+    /**
+     * \brief Finds the position of the k-th set bit
+     * 
+     * \param k the rank of the set bit, between one and \ref num_ones
+     * \return the position of the k-th set bit
+     */
+    inline size_t select1(size_t const k) const {
+        assert(k >= 1 && k <= ones_);
+        return select<true>(k);
+    }
+
+    /**
+     * \brief Finds the position of the k-th unset bit
+     * 
+     * \param k the rank of the unset bit, between one and the number of unset bits
+     * \return the position of the k-th unset bit
+     */
+    inline size_t select0(size_t const k) const {
+        assert(k >= 1 && k <= size_ - ones_);
+        return select<false>(k);
+    }
+
+    /**
+     * \brief Reports the total size of the encoded blocks and samples in bits
+     * 
+     * \return the size in bits
+     */
+    size_t size_in_bits() const {
+        return 64 * (classes_.size() + offsets_.size() + samples_.size()) + 32 * (select1_.size() + select0_.size());
+    }
+};
+
+}
+
+#endif
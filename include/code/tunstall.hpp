@@ -0,0 +1,113 @@
+/**
+ * code/tunstall.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_TUNSTALL_HPP
+#define _CODE_TUNSTALL_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "binary.hpp"
+#include "concepts.hpp"
+#include "tunstall_dictionary.hpp"
+
+namespace code {
+
+/**
+ * \brief Tunstall (variable-to-fixed) encoding and decoding of strings
+ * 
+ * The input is parsed into strings of a \ref code::TunstallDictionary "TunstallDictionary", and each string is encoded by its fixed-width codeword.
+ * Decoding a codeword thus requires only a single table lookup followed by copying a short string, making Tunstall codes
+ * considerably faster to decode than Huffman codes at the cost of a slightly worse compression ratio.
+ */
+class Tunstall {
+public:
+    /**
+     * \brief Encodes a string using the given Tunstall dictionary
+     * 
+     * If the input ends within a dictionary string, the codeword of an arbitrary string that continues the remainder of the input is encoded.
+     * Therefore, the decoder must know the length of the input.
+     * 
+     * The behaviour of this function is undefined if the input contains a character that is not in the dictionary's alphabet.
+     * 
+     * \tparam Sink the bit sink type
+     * \tparam It the input iterator type
+     * \tparam Char the character type
+     * \param sink the bit sink
+     * \param begin the beginning of the input
+     * \param end the end of the input
+     * \param dict the Tunstall dictionary
+     */
+    template<BitSink Sink, std::input_iterator It, std::integral Char>
+    requires std::is_convertible_v<typename std::iterator_traits<It>::value_type, Char>
+    static void encode(Sink& sink, It begin, It const end, TunstallDictionary<Char> const& dict) {
+        auto const bits = dict.bits();
+        auto const root = dict.root();
+
+        auto v = root;
+        while(begin != end) {
+            v = dict.child(v, dict.rank(*begin++));
+            if(dict.is_leaf(v)) {
+                Binary::encode(sink, dict.code(v), bits);
+                v = root;
+            }
+        }
+
+        if(v != root) {
+            // the input ended within a string, complete it arbitrarily
+            while(!dict.is_leaf(v)) v = dict.child(v, 0);
+            Binary::encode(sink, dict.code(v), bits);
+        }
+    }
+
+    /**
+     * \brief Decodes a string using the given Tunstall dictionary
+     * 
+     * \tparam Source the bit source type
+     * \tparam Char the character type
+     * \param src the bit source
+     * \param out the output, which must have space for \c num characters
+     * \param num the length of the encoded input
+     * \param dict the Tunstall dictionary
+     */
+    template<BitSource Source, std::integral Char>
+    static void decode(Source& src, Char* out, size_t num, TunstallDictionary<Char> const& dict) {
+        auto const bits = dict.bits();
+        while(num) {
+            auto const code = (uint32_t)Binary::decode(src, bits);
+            auto const len = std::min(dict.length(code), num);
+            std::memcpy(out, dict.string(code), len * sizeof(Char));
+            out += len;
+            num -= len;
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,424 @@
+/**
+ * code/tunstall_dictionary.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_TUNSTALL_DICTIONARY_HPP
+#define _CODE_TUNSTALL_DICTIONARY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "concepts.hpp"
+#include "counter.hpp"
+#include "elias_delta.hpp"
+
+namespace code {
+
+/**
+ * \brief A Tunstall dictionary
+ * 
+ * A Tunstall dictionary assigns fixed-width codewords to variable-length strings over the input alphabet.
+ * It is represented by a parse tree, in which every inner node has exactly one child for each character of the alphabet
+ * (in ascending order) and every leaf represents a dictionary string.
+ * Leaves are assigned codewords in a pre-order traversal.
+ * 
+ * For decoding, the dictionary maintains all strings in a flat array such that a codeword can be decoded using a single table lookup
+ * followed by copying the string.
+ * 
+ * \tparam Char the character type
+ */
+template<std::integral Char>
+class TunstallDictionary {
+public:
+    /**
+     * \brief The maximum width of the codewords in bits
+     * 
+     * A parse tree with \c 2^bits leaves has less than \c 2^(bits+1) nodes, which must be addressable using 32-bit indices.
+     */
+    static constexpr size_t MAX_BITS = 30;
+
+private:
+    using UChar = std::make_unsigned_t<Char>;
+
+    static constexpr uint32_t LEAF = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MAX_RESERVE = size_t(1) << 20; // the maximum number of nodes reserved in advance during construction
+
+    struct Node {
+        uint32_t first_child; // the index of the first child, or LEAF
+        uint32_t code;        // the codeword of a leaf
+    };
+
+    size_t bits_;
+
+    std::vector<Char> alphabet_;
+    std::unordered_map<Char, uint32_t> rank_;
+    std::vector<Node> nodes_;
+
+    std::vector<Char> strings_;
+    std::vector<size_t> offsets_; // nb: the strings may well exceed 2^32 characters in total
+    size_t max_length_;
+
+    void set_alphabet(std::vector<Char>&& alphabet) {
+        alphabet_ = std::move(alphabet);
+        rank_.reserve(alphabet_.size());
+        for(uint32_t i = 0; i < alphabet_.size(); i++) {
+            rank_.emplace(alphabet_[i], i);
+        }
+    }
+
+    void expand(size_t const v) {
+        nodes_[v].first_child = nodes_.size();
+        for(size_t i = 0; i < alphabet_.size(); i++) {
+            nodes_.push_back(Node { LEAF, 0 });
+        }
+    }
+
+    void assign_codes(uint32_t const v, std::vector<Char>& path) {
+        if(nodes_[v].first_child == LEAF) {
+            nodes_[v].code = offsets_.size();
+            offsets_.push_back(strings_.size());
+            strings_.insert(strings_.end(), path.begin(), path.end());
+            max_length_ = std::max(max_length_, path.size());
+        } else {
+            auto const first = nodes_[v].first_child;
+            for(size_t i = 0; i < alphabet_.size(); i++) {
+                path.push_back(alphabet_[i]);
+                assign_codes(first + i, path);
+                path.pop_back();
+            }
+        }
+    }
+
+    void assign_codes() {
+        strings_.clear();
+        offsets_.clear();
+        max_length_ = 0;
+
+        std::vector<Char> path;
+        assign_codes(0, path);
+        offsets_.push_back(strings_.size());
+    }
+
+public:
+    /**
+     * \brief Constructs an empty dictionary
+     */
+    TunstallDictionary() : bits_(0), max_length_(0) {
+    }
+
+    TunstallDictionary(TunstallDictionary&&) = default;
+    TunstallDictionary& operator=(TunstallDictionary&&) = default;
+
+    TunstallDictionary(TunstallDictionary const&) = default;
+    TunstallDictionary& operator=(TunstallDictionary const&) = default;
+
+    /**
+     * \brief Constructs the Tunstall dictionary for the given input histogram
+     * 
+     * Starting with a parse tree that contains one leaf for each character, the most probable leaf is repeatedly expanded
+     * as long as the number of leaves does not exceed \c 2^bits .
+     * Ties are broken in favour of the leaf that was created first, so the result is deterministic.
+     * 
+     * In order to bound the memory footprint and the cost of decoding a codeword for extremely skewed distributions,
+     * leaves representing strings of length \c max_length are never expanded.
+     * 
+     * If the histogram contains only one character, a second character of frequency zero is introduced.
+     * The number of distinct characters must not exceed \c 2^bits .
+     * 
+     * \tparam H the histogram type
+     * \param histogram the input histogram
+     * \param bits the width of the codewords in bits, at most \ref MAX_BITS
+     * \param max_length the maximum length of a dictionary string
+     */
+    template<Histogram<Char> H>
+    TunstallDictionary(H const& histogram, size_t const bits, size_t const max_length = 64) : bits_(bits) {
+        assert(bits > 0 && bits <= MAX_BITS);
+        assert(max_length > 0);
+
+        // gather characters in ascending order
+        std::vector<std::pair<Char, size_t>> chars;
+        chars.reserve(histogram.size() + 1);
+        for(auto e : histogram) chars.emplace_back(e.first, e.second);
+        std::sort(chars.begin(), chars.end());
+
+        if(chars.size() == 1) {
+            auto const c = chars[0].first;
+            if(c < std::numeric_limits<Char>::max()) {
+                chars.emplace_back(c + 1, 0);
+            } else {
+                chars.emplace(chars.begin(), c - 1, 0);
+            }
+        }
+
+        auto const sigma = chars.size();
+        size_t const max_leaves = size_t(1) << bits;
+        assert(sigma <= max_leaves);
+
+        std::vector<Char> alphabet;
+        alphabet.reserve(sigma);
+        double total = 0;
+        for(auto e : chars) {
+            alphabet.push_back(e.first);
+            total += e.second;
+        }
+        set_alphabet(std::move(alphabet));
+
+        // compute character probabilities
+        std::vector<double> prob;
+        prob.reserve(sigma);
+        for(auto e : chars) prob.push_back(total > 0 ? e.second / total : 1.0 / sigma);
+
+        // define max-priority queue of leaves
+        struct Leaf {
+            double prob;
+            uint32_t node;
+            uint32_t depth;
+
+            bool operator<(Leaf const& other) const {
+                return prob < other.prob || (prob == other.prob && node > other.node); // consider more probable leaves first, and then those created earlier
+            }
+        };
+        std::priority_queue<Leaf> queue;
+
+        // construct root and initial leaves
+        // nb: every expansion adds sigma nodes and sigma - 1 leaves; for wide codewords, the vector grows while expanding instead
+        size_t const max_nodes = sigma > 1 ? 1 + sigma * (1 + (max_leaves - sigma) / (sigma - 1)) : 1 + sigma;
+        nodes_.reserve(std::min(max_nodes, MAX_RESERVE));
+        nodes_.push_back(Node { LEAF, 0 });
+        expand(0);
+        for(size_t i = 0; i < sigma; i++) {
+            queue.push(Leaf { prob[i], uint32_t(1 + i), 1 });
+        }
+
+        // expand leaves
+        size_t num_leaves = sigma;
+        while(!queue.empty() && num_leaves + sigma - 1 <= max_leaves) {
+            auto const leaf = queue.top();
+            queue.pop();
+
+            if(leaf.depth < max_length) {
+                auto const first = nodes_.size();
+                expand(leaf.node);
+                for(size_t i = 0; i < sigma; i++) {
+                    queue.push(Leaf { leaf.prob * prob[i], uint32_t(first + i), leaf.depth + 1 });
+                }
+                num_leaves += sigma - 1;
+            }
+        }
+
+        assign_codes();
+    }
+
+private:
+    template<BitSource Source>
+    void decode_node(Source& src, uint32_t const v) {
+        if(!src.read()) {
+            // inner node
+            expand(v);
+            auto const first = nodes_[v].first_child;
+            for(size_t i = 0; i < alphabet_.size(); i++) {
+                decode_node(src, first + i);
+            }
+        }
+    }
+
+public:
+    /**
+     * \brief Decodes a Tunstall dictionary from the given bit source
+     * 
+     * The dictionary must have been encoded using \ref encode in order for this function to be able to decode it.
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     */
+    template<BitSource Source>
+    TunstallDictionary(Source& src) {
+        // decode codeword width
+        bits_ = Binary::decode(src, Universe::with_entropy(6)) + 1;
+        assert(bits_ <= MAX_BITS);
+
+        // decode alphabet
+        auto const sigma = EliasDelta::decode(src, Universe::umax());
+        auto const min = EliasDelta::decode(src, Universe::umax());
+        auto const max = EliasDelta::decode(src, Universe::at_least(min));
+        Universe u(min, max);
+
+        std::vector<Char> alphabet;
+        alphabet.reserve(sigma);
+        for(size_t i = 0; i < sigma; i++) {
+            alphabet.push_back((Char)(UChar)Binary::decode(src, u));
+        }
+        set_alphabet(std::move(alphabet));
+
+        // decode parse tree
+        nodes_.push_back(Node { LEAF, 0 });
+        decode_node(src, 0);
+        assign_codes();
+    }
+
+private:
+    template<BitSink Sink>
+    void encode_node(Sink& sink, uint32_t const v) const {
+        bool const leaf = nodes_[v].first_child == LEAF;
+        sink.write(leaf);
+        if(!leaf) {
+            auto const first = nodes_[v].first_child;
+            for(size_t i = 0; i < alphabet_.size(); i++) {
+                encode_node(sink, first + i);
+            }
+        }
+    }
+
+public:
+    /**
+     * \brief Encodes the dictionary to the given bit sink
+     * 
+     * The encoding starts with the codeword width and the alphabet, whose characters are binary encoded relative to the universe they span.
+     * The parse tree topology follows in pre-order, where leaves are encoded as a 1-bit and inner nodes as a 0-bit.
+     * The dictionary strings are implied by the topology and need not be encoded.
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     */
+    template<BitSink Sink>
+    void encode(Sink& sink) const {
+        // encode codeword width
+        Binary::encode(sink, bits_ - 1, Universe::with_entropy(6));
+
+        // encode alphabet
+        Range range;
+        for(auto const c : alphabet_) range.contain((UChar)c);
+        Universe u(range);
+
+        EliasDelta::encode(sink, alphabet_.size(), Universe::umax());
+        EliasDelta::encode(sink, u.min(), Universe::umax());
+        EliasDelta::encode(sink, u.max(), Universe::at_least(u.min()));
+        for(auto const c : alphabet_) {
+            Binary::encode(sink, (UChar)c, u);
+        }
+
+        // encode parse tree
+        encode_node(sink, 0);
+    }
+
+    /**
+     * \brief Reports the width of the codewords in bits
+     * 
+     * \return the width of the codewords in bits
+     */
+    size_t bits() const { return bits_; }
+
+    /**
+     * \brief Reports the number of strings in the dictionary
+     * 
+     * This equals the number of used codewords, which is at most \c 2^bits() .
+     * 
+     * \return the number of strings in the dictionary
+     */
+    size_t size() const { return offsets_.size() - 1; }
+
+    /**
+     * \brief Reports the length of the longest string in the dictionary
+     * 
+     * \return the length of the longest string in the dictionary
+     */
+    size_t max_length() const { return max_length_; }
+
+    /**
+     * \brief Reports the characters of the alphabet in ascending order
+     * 
+     * \return the alphabet
+     */
+    std::vector<Char> const& alphabet() const { return alphabet_; }
+
+    /**
+     * \brief Reports the rank of the given character in the alphabet
+     * 
+     * The behaviour of this function is undefined if the character is not in the alphabet.
+     * 
+     * \param c the character
+     * \return the rank of the character
+     */
+    uint32_t rank(Char const c) const { return rank_.at(c); }
+
+    /**
+     * \brief Reports the root of the parse tree
+     * 
+     * \return the root node index
+     */
+    uint32_t root() const { return 0; }
+
+    /**
+     * \brief Navigates from an inner node of the parse tree to the child for the character with the given rank
+     * 
+     * \param v the inner node
+     * \param r the character rank
+     * \return the child node index
+     */
+    uint32_t child(uint32_t const v, uint32_t const r) const { return nodes_[v].first_child + r; }
+
+    /**
+     * \brief Tests whether the given node of the parse tree is a leaf
+     * 
+     * \param v the node
+     * \return true iff the node is a leaf
+     */
+    bool is_leaf(uint32_t const v) const { return nodes_[v].first_child == LEAF; }
+
+    /**
+     * \brief Reports the codeword assigned to a leaf of the parse tree
+     * 
+     * \param v the leaf
+     * \return the codeword assigned to the leaf
+     */
+    uint32_t code(uint32_t const v) const { return nodes_[v].code; }
+
+    /**
+     * \brief Provides the dictionary string for the given codeword
+     * 
+     * \param code the codeword
+     * \return a pointer to the first character of the string
+     */
+    Char const* string(uint32_t const code) const { return strings_.data() + offsets_[code]; }
+
+    /**
+     * \brief Reports the length of the dictionary string for the given codeword
+     * 
+     * \param code the codeword
+     * \return the length of the string
+     */
+    size_t length(uint32_t const code) const { return offsets_[code + 1] - offsets_[code]; }
+};
+
+}
+
+#endif
@@ -28,8 +28,12 @@
 #ifndef _CODE_UNARY_HPP
 #define _CODE_UNARY_HPP
 
+#include <algorithm>
+#include <bit>
 #include <limits>
+#include <optional>
 
+#include "bit_feed.hpp"
 #include "concepts.hpp"
 
 namespace code {
@@ -107,6 +111,62 @@ public:
     inline static uintmax_t decode(Source& src, Universe u) {
         return u.abs(decode(src));
     }
+
+    /**
+     * \brief Resumable decoding of unary codes from input that arrives in chunks
+     * 
+     * The number of 1-bits read so far is kept across calls.
+     */
+    class ResumableDecoder {
+    private:
+        uintmax_t x_;
+
+    public:
+        /**
+         * \brief Constructs a decoder in the initial state
+         */
+        ResumableDecoder() : x_(0) {
+        }
+
+        /**
+         * \brief Decodes an integer using unary code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed) {
+            while(feed.available()) {
+                auto const num = std::min(feed.available(), size_t(64));
+                auto const ones = (size_t)std::countr_one(feed.peek(num));
+                if(ones < num) {
+                    feed.skip(ones + 1);
+                    auto const x = x_ + ones;
+                    x_ = 0;
+                    return x;
+                }
+                feed.skip(num);
+                x_ += num;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * \brief Decodes an integer from the given universe using unary code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \param u the universe of the integer to decode
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed, Universe u) {
+            auto const x = decode(feed);
+            return x ? std::optional<uintmax_t>(u.abs(*x)) : std::nullopt;
+        }
+
+        /**
+         * \brief Discards the partially decoded codeword
+         */
+        void reset() { x_ = 0; }
+    };
 };
 
 }
@@ -39,19 +39,43 @@
 
 namespace code {
 
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+/// \brief Defined if 128-bit integers are available as \ref code::uint128_t "uint128_t" and satisfy \c std::unsigned_integral (requires GNU extensions)
+#define CODE_HAS_UINT128
+
 /**
- * \brief Represents a universe of unsigned integers
+ * \brief The unsigned 128-bit integer type
+ */
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+template<std::unsigned_integral Int> class BasicUniverse;
+
+namespace internal {
+    template<typename T> constexpr bool is_universe = false;
+    template<typename Int> constexpr bool is_universe<BasicUniverse<Int>> = true;
+}
+
+/**
+ * \brief Represents a universe of unsigned integers of the given type
+ * 
+ * Typically, the universe of the largest standard type, \ref code::Universe "Universe", is used.
+ * The universal codes also accept universes of wider types, such as \ref code::uint128_t "uint128_t", and then encode and decode integers of that type.
+ * Universes of narrower types are implicitly converted.
  * 
+ * \tparam Int the unsigned integer type
  */
-class Universe {
+template<std::unsigned_integral Int>
+class BasicUniverse {
 private:
-    uintmax_t min_, max_, entropy_;
+    Int min_, max_;
+    uintmax_t entropy_;
 
-    inline static constexpr uintmax_t wc_entropy(uintmax_t min, uintmax_t max) {
-        return std::max(uintmax_t(1), uintmax_t(std::bit_width(max - min)));
+    inline static constexpr uintmax_t wc_entropy(Int min, Int max) {
+        return std::max(uintmax_t(1), uintmax_t(std::bit_width(Int(max - min))));
     }
 
-    inline constexpr Universe(uintmax_t min, uintmax_t max, uintmax_t entropy) : min_(min), max_(max), entropy_(entropy) {
+    inline constexpr BasicUniverse(Int min, Int max, uintmax_t entropy) : min_(min), max_(max), entropy_(entropy) {
     }
 
 public:
@@ -60,14 +84,14 @@ public:
      * 
      * \return the binary universe
      */
-    inline static constexpr Universe binary() { return Universe(0, 1); }
+    inline static constexpr BasicUniverse binary() { return BasicUniverse(0, 1); }
 
     /**
-     * \brief Returns the universe of all unsigned integers that can be represented on the system
+     * \brief Returns the universe of all unsigned integers that can be represented by the integer type
      * 
-     * \return the universe of all unsigned integers that can be represented on the system
+     * \return the universe of all unsigned integers that can be represented by the integer type
      */
-    inline static constexpr Universe umax() { return Universe(0, UINTMAX_MAX); }
+    inline static constexpr BasicUniverse umax() { return BasicUniverse(0, std::numeric_limits<Int>::max()); }
 
 
     /**
@@ -76,7 +100,7 @@ public:
      * \param min the minimum value of the universe
      * \return the universe of all unsigned integers that are at least as large as min
      */
-    inline static constexpr Universe at_least(uintmax_t min) { return Universe(min, UINTMAX_MAX); }
+    inline static constexpr BasicUniverse at_least(Int min) { return BasicUniverse(min, std::numeric_limits<Int>::max()); }
 
     /**
      * \brief Returns the universe of all integers that can be represented by the given type
@@ -89,11 +113,12 @@ public:
      * Universe::of<uint64_t>(); // universe of all unsigned 64-bit integers
      * \endcode
      * 
-     * \tparam Int the integer type
+     * \tparam T the integer type, which must not be wider than the universe's integer type
      * \return the universe of all integers that can be represented by the given type
      */
-    template<std::unsigned_integral Int>
-    inline static constexpr Universe of() { return Universe(Int(0), std::numeric_limits<Int>::max(), std::numeric_limits<Int>::digits); }
+    template<std::unsigned_integral T>
+    requires (std::numeric_limits<T>::digits <= std::numeric_limits<Int>::digits)
+    inline static constexpr BasicUniverse of() { return BasicUniverse(Int(0), Int(std::numeric_limits<T>::max()), std::numeric_limits<T>::digits); }
 
     /**
      * \brief Returns the universe of all integers that can be represented using the given number of bits
@@ -101,7 +126,7 @@ public:
      * \param entropy the worst-case entropy of the universe
      * \return the universe of all integers that can be represented using the given number of bits
      */
-    inline static constexpr Universe with_entropy(uintmax_t entropy) { return Universe(0, UINTMAX_MAX >> (std::numeric_limits<uintmax_t>::digits - entropy), entropy); }
+    inline static constexpr BasicUniverse with_entropy(uintmax_t entropy) { return BasicUniverse(0, std::numeric_limits<Int>::max() >> (std::numeric_limits<Int>::digits - entropy), entropy); }
 
     /**
      * \brief Returns the universe specified by a minimum value and the delta between maximum and minimum
@@ -112,20 +137,20 @@ public:
      * \param delta the difference between the maximum and the minimum integers of the universe
      * \return the corresponding universe
      */
-    inline static constexpr Universe with_delta(uintmax_t min, uintmax_t delta) { return Universe(min, min + delta); }
+    inline static constexpr BasicUniverse with_delta(Int min, Int delta) { return BasicUniverse(min, min + delta); }
 
     /**
      * \brief Construct an empty universe
      * 
-     * The universe's minimum is initialized as \c UINTMAX_MAX and the minimum as zero.
+     * The universe's minimum is initialized as the maximum integer and the maximum as zero.
      */
-    inline constexpr Universe() : Universe(UINTMAX_MAX, 0, 0) {
+    inline constexpr BasicUniverse() : BasicUniverse(std::numeric_limits<Int>::max(), 0, 0) {
     }
 
-    constexpr Universe(Universe const&) = default;
-    constexpr Universe(Universe&&) = default;
-    constexpr Universe& operator=(Universe const&) = default;
-    constexpr Universe& operator=(Universe&&) = default;
+    constexpr BasicUniverse(BasicUniverse const&) = default;
+    constexpr BasicUniverse(BasicUniverse&&) = default;
+    constexpr BasicUniverse& operator=(BasicUniverse const&) = default;
+    constexpr BasicUniverse& operator=(BasicUniverse&&) = default;
 
     /**
      * \brief Defines a universe for the specified unsigned integer range
@@ -135,7 +160,7 @@ public:
      * \param min the minimum integer of the universe
      * \param max the maximum integer of the universe
      */
-    inline constexpr Universe(uintmax_t const min, uintmax_t const max) : Universe(min, max, wc_entropy(min, max)) {
+    inline constexpr BasicUniverse(Int const min, Int const max) : BasicUniverse(min, max, wc_entropy(min, max)) {
     }
 
     /**
@@ -145,7 +170,7 @@ public:
      * 
      * \param range the range
      */
-    inline Universe(Range const& range) : Universe(range.min(), range.max()) {
+    inline BasicUniverse(BasicRange<Int> const& range) : BasicUniverse(range.min(), range.max()) {
     }
 
     /**
@@ -158,7 +183,8 @@ public:
      * \param minmax the pair defining the integer range
      */
     template<typename Pair>
-    inline constexpr Universe(Pair minmax) {
+    requires (!std::integral<Pair> && !internal::is_universe<Pair>)
+    inline constexpr BasicUniverse(Pair minmax) {
         auto [min, max] = minmax;
         min_ = min;
         max_ = max;
@@ -170,11 +196,22 @@ public:
      * 
      * \param max the maximum integer of the universe
      */
-    inline constexpr Universe(uintmax_t const max) : Universe(0, max) {
+    inline constexpr BasicUniverse(Int const max) : BasicUniverse(0, max) {
     }
 
-    bool operator==(Universe const& other) const = default;
-    bool operator!=(Universe const& other) const = default;
+    /**
+     * \brief Converts a universe of a narrower integer type
+     * 
+     * \tparam T the narrower integer type
+     * \param u the universe to convert
+     */
+    template<std::unsigned_integral T>
+    requires (std::numeric_limits<T>::digits < std::numeric_limits<Int>::digits)
+    inline constexpr BasicUniverse(BasicUniverse<T> const& u) : BasicUniverse(Int(u.min()), Int(u.max()), u.entropy()) {
+    }
+
+    bool operator==(BasicUniverse const& other) const = default;
+    bool operator!=(BasicUniverse const& other) const = default;
 
     /**
      * \brief Computes the absolute value of an integer relative to the universe's minimum
@@ -184,7 +221,7 @@ public:
      * \param rel the integer relative to the universe's minimum
      * \return the absolute value of the integer
      */
-    inline constexpr uintmax_t abs(uintmax_t const rel) const { return min_ + rel; }
+    inline constexpr Int abs(Int const rel) const { return min_ + rel; }
 
     /**
      * \brief Computes the relative value of an integer to the universe's minimum.
@@ -195,21 +232,21 @@ public:
      * \param abs the integer to transform
      * \return the relative value of the integer to the universe's minimum
      */
-    inline constexpr uintmax_t rel(uintmax_t const abs) const { return abs - min_; }
+    inline constexpr Int rel(Int const abs) const { return abs - min_; }
 
     /**
      * \brief Reports the minimum integer contained in the universe
      * 
      * \return the minimum integer contained in the universe
      */
-    inline constexpr uintmax_t min() const { return min_; }
+    inline constexpr Int min() const { return min_; }
 
     /**
      * \brief Reports the maximum integer contained in the universe
      * 
      * \return the maximum integer contained in the universe
      */
-    inline constexpr uintmax_t max() const { return max_; }
+    inline constexpr Int max() const { return max_; }
 
     /**
      * \brief Reports the difference between the maximum and minimum integers contained in the universe
@@ -218,7 +255,7 @@ public:
      * 
      * \return the difference between the maximum and minimum integers contained in the universe
      */
-    inline constexpr uintmax_t delta() const { return max_ - min_; }
+    inline constexpr Int delta() const { return max_ - min_; }
 
     /**
      * \brief Reports the worst-case entropy for integers from this universe in bits
@@ -230,6 +267,11 @@ public:
     inline constexpr uintmax_t entropy() const { return entropy_; }
 };
 
+/**
+ * \brief A universe of unsigned integers of the largest standard type
+ */
+using Universe = BasicUniverse<uintmax_t>;
+
 }
 
 #endif
@@ -29,9 +29,16 @@
 #define _CODE_VBYTE_HPP
 
 #include <bit>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
+#include "binary.hpp"
+#include "bit_feed.hpp"
 #include "concepts.hpp"
 
+#include "internal/bits.hpp"
+
 namespace code {
 
 /**
@@ -40,7 +47,8 @@ namespace code {
  * In vbyte coding, the integer to be encoded is split into blocks of a fixed size.
  * These blocks are encoded separately, each preceded by a bit indicating whether the block contains the integer's highest bit.
  * 
- * Instances of this class satisfy both the \ref tdc::code::IntegerEncoder "IntegerEncoder" and the \ref tdc::code::IntegerDecoder "IntegerDecoder" concepts.
+ * Instances of this class satisfy both the \ref tdc::code::IntegerEncoder "IntegerEncoder" and the \ref tdc::code::IntegerDecoder "IntegerDecoder" concepts,
+ * as well as the \ref code::Checkpointable "Checkpointable" concept.
  */
 class Vbyte {
 public:
@@ -48,23 +56,25 @@ public:
      * \brief Encodes an integer using vbyte code with the specified block size
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type
      * \param sink the bit sink
      * \param x the integer to encode
      * \param b the vbyte block size
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, uint8_t b) {
-        auto bits = std::bit_width(x);
+    template<BitSink Sink, internal::EncodableInteger Int>
+    inline static void encode(Sink& sink, Int const x, uint8_t b) {
+        internal::encoded_t<Int> v = x;
+        size_t bits = std::bit_width(v);
         while(bits > b) {
             sink.write(0);
-            sink.write(x, b);
+            Binary::encode(sink, v, b);
 
-            x >>= b;
+            v >>= b;
             bits -= b;
         }
 
         sink.write(1);
-        sink.write(x, b);
+        Binary::encode(sink, v, b);
     }
 
     /**
@@ -73,33 +83,35 @@ public:
      * This function actually encodes the value of the integer relative to the universe's minimum.
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type of the universe
      * \param sink the bit sink
      * \param x the integer to encode
      * \param b the vbyte block size
      * \param u the universe of \c x
      */
-    template<BitSink Sink>
-    inline static void encode(Sink& sink, uintmax_t x, uint8_t b, Universe u) {
+    template<BitSink Sink, std::unsigned_integral Int>
+    inline static void encode(Sink& sink, std::type_identity_t<Int> x, uint8_t b, BasicUniverse<Int> u) {
         encode(sink, u.rel(x), b);
     }
 
     /**
      * \brief Decodes an integer using rice code with the specified divisor
      * 
+     * \tparam Int the integer type
      * \tparam Source the bit source type
      * \param src the bit sink
      * \param b the vbyte block size
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, uint8_t b) {
+    template<std::unsigned_integral Int = uintmax_t, BitSource Source>
+    inline static Int decode(Source& src, uint8_t b) {
         size_t bits = 0;
-        uintmax_t x = 0;
+        Int x = 0;
         while(!src.read()) {
-            x |= src.read(b) << bits;
+            x |= Binary::decode<Int>(src, b) << bits;
             bits += b;
         }
-        x |= src.read(b) << bits;
+        x |= Binary::decode<Int>(src, b) << bits;
         return x;
     }
 
@@ -109,14 +121,15 @@ public:
      * This function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
      * 
      * \tparam Source the bit source type
+     * \tparam Int the integer type of the universe
      * \param src the bit source
      * \param b the vbyte block size
      * \param u the universe of the integer to decode
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline static uintmax_t decode(Source& src, uint8_t b, Universe u) {
-        return u.abs(decode(src, b));
+    template<BitSource Source, std::unsigned_integral Int>
+    inline static Int decode(Source& src, uint8_t b, BasicUniverse<Int> u) {
+        return u.abs(decode<Int>(src, b));
     }
 
 private:
@@ -137,12 +150,13 @@ public:
      * This function actually encodes the value of the integer relative to the universe's minimum.
      * 
      * \tparam Sink the bit sink type
+     * \tparam Int the integer type of the universe
      * \param sink the bit sink
      * \param x the integer to encode
      * \param u the universe of \c x
      */
-    template<BitSink Sink>
-    inline void encode(Sink& sink, uintmax_t x, Universe u) {
+    template<BitSink Sink, std::unsigned_integral Int>
+    inline void encode(Sink& sink, std::type_identity_t<Int> x, BasicUniverse<Int> u) {
         encode(sink, x, block_, u);
     }
 
@@ -152,12 +166,13 @@ public:
      * This function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
      * 
      * \tparam Source the bit source type
+     * \tparam Int the integer type of the universe
      * \param src the bit source
      * \param u the universe of the integer to decode
      * \return the decoded integer
      */
-    template<BitSource Source>
-    inline uintmax_t decode(Source& src, Universe u) {
+    template<BitSource Source, std::unsigned_integral Int>
+    inline Int decode(Source& src, BasicUniverse<Int> u) {
         return decode(src, block_, u);
     }
 
@@ -167,6 +182,94 @@ public:
      * \return the vbyte block size
      */
     uint8_t block() const { return block_; }
+
+    /**
+     * \brief Saves the block size of this coder
+     * 
+     * \param state the state words to append to
+     */
+    void save_state(std::vector<uint64_t>& state) const { state.push_back(block_); }
+
+    /**
+     * \brief Restores the block size of this coder
+     * 
+     * \param state the state words, which are advanced past the restored state
+     */
+    void load_state(uint64_t const*& state) { block_ = (uint8_t)*state++; }
+
+    /**
+     * \brief Resumable decoding of vbyte codes from input that arrives in chunks
+     * 
+     * The blocks read so far, as well as a partially read block, are kept across calls.
+     */
+    class ResumableDecoder {
+    private:
+        uint8_t b_;
+        Binary::ResumableDecoder block_;
+        size_t bits_;
+        uintmax_t x_;
+        bool in_block_;
+        bool last_;
+
+    public:
+        /**
+         * \brief Constructs a decoder for the specified block size
+         * 
+         * \param b the vbyte block size
+         */
+        ResumableDecoder(uint8_t b) : b_(b), block_(b), bits_(0), x_(0), in_block_(false), last_(false) {
+        }
+
+        /**
+         * \brief Decodes an integer using vbyte code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed) {
+            while(true) {
+                if(!in_block_) {
+                    if(!feed.available()) return std::nullopt;
+                    last_ = feed.read();
+                    in_block_ = true;
+                }
+
+                auto const block = block_.decode(feed);
+                if(!block) return std::nullopt;
+
+                x_ |= *block << bits_;
+                bits_ += b_;
+                in_block_ = false;
+                if(last_) {
+                    auto const x = x_;
+                    reset();
+                    return x;
+                }
+            }
+        }
+
+        /**
+         * \brief Decodes an integer from the given universe using vbyte code as far as the available input permits
+         * 
+         * \param feed the bit feed
+         * \param u the universe of the integer to decode
+         * \return the decoded integer, or nothing if the feed has run out of bits before the codeword was complete
+         */
+        std::optional<uintmax_t> decode(BitFeed& feed, Universe u) {
+            auto const x = decode(feed);
+            return x ? std::optional<uintmax_t>(u.abs(*x)) : std::nullopt;
+        }
+
+        /**
+         * \brief Discards the partially decoded codeword
+         */
+        void reset() {
+            block_.reset();
+            bits_ = 0;
+            x_ = 0;
+            in_block_ = false;
+        }
+    };
 };
 
 }
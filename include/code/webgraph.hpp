@@ -0,0 +1,346 @@
+/**
+ * code/webgraph.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_WEBGRAPH_HPP
+#define _CODE_WEBGRAPH_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "elias_fano.hpp"
+#include "elias_gamma.hpp"
+#include "zeta.hpp"
+
+#include "internal/bit_buffer.hpp"
+
+namespace code {
+
+/**
+ * \brief Parameters for the compression of graphs using \ref code::WebGraph "WebGraph"
+ */
+struct WebGraphOptions {
+    /// \brief The number of preceding nodes whose successor lists are considered as references, or zero to disable referencing
+    size_t window = 7;
+
+    /// \brief The maximum length of a chain of references, which bounds the time for decoding a successor list
+    size_t max_ref_chain = 3;
+
+    /// \brief The minimum length of a run of consecutive successors to be encoded as an interval, or zero to disable intervals
+    size_t min_interval = 4;
+
+    /// \brief The parameter of the zeta code used for residuals
+    uint8_t zeta_k = 3;
+};
+
+/**
+ * \brief A compressed directed graph following the WebGraph framework by Boldi and Vigna
+ * 
+ * The successor list of each node is encoded as follows, where all numbers are encoded using \ref code::EliasGamma "EliasGamma" codes unless stated otherwise:
+ * - the outdegree,
+ * - the reference \c r, i.e., the successor list of node <tt>x - r</tt> is used as a reference (omitted if referencing is disabled),
+ * - if <tt>r > 0</tt>, the copy blocks: the reference list is split into alternating runs of successors that are copied and skipped, starting with a (possibly empty) copied run, and the lengths of all runs but the last one are encoded,
+ * - the intervals of consecutive successors among the remaining successors, each given by its left extreme as a gap and its length,
+ * - the residuals, i.e., the remaining successors, as gaps using \ref code::Zeta "Zeta" codes.
+ * 
+ * For each node, the reference minimizing the size of its encoding is chosen among the \ref WebGraphOptions::window "window" preceding nodes.
+ * The bit offset of each successor list is stored in an \ref code::EliasFano "EliasFano" sequence, so successor lists can be decoded in random order.
+ */
+class WebGraph {
+private:
+    static constexpr Universe NAT = Universe::umax();
+
+    inline static uint64_t int2nat(int64_t const v) {
+        return v >= 0 ? uint64_t(v) << 1 : ((uint64_t(-(v + 1)) << 1) | 1);
+    }
+
+    inline static int64_t nat2int(uint64_t const n) {
+        return (n & 1) ? -int64_t(n >> 1) - 1 : int64_t(n >> 1);
+    }
+
+    size_t num_nodes_;
+    size_t num_edges_;
+    WebGraphOptions options_;
+    std::vector<uint64_t> bits_;
+    EliasFano offsets_;
+
+    template<BitSink Sink>
+    void encode_node(Sink& sink, uint64_t const x, std::vector<uint64_t> const& succ, std::vector<uint64_t> const* ref, size_t const r) const {
+        auto const d = succ.size();
+        EliasGamma::encode(sink, d, NAT);
+        if(d == 0) return;
+
+        if(options_.window > 0) EliasGamma::encode(sink, r, NAT);
+
+        // copy blocks
+        std::vector<uint64_t> extras;
+        if(r > 0) {
+            std::vector<size_t> blocks;
+            bool copying = true;
+            size_t run = 0;
+            size_t j = 0;
+            for(auto const y : *ref) {
+                while(j < d && succ[j] < y) extras.push_back(succ[j++]);
+                bool const copy = (j < d && succ[j] == y);
+                if(copy) ++j;
+
+                if(copy == copying) {
+                    ++run;
+                } else {
+                    blocks.push_back(run);
+                    copying = !copying;
+                    run = 1;
+                }
+            }
+            while(j < d) extras.push_back(succ[j++]);
+
+            // nb: the last run is implicit
+            EliasGamma::encode(sink, blocks.size(), NAT);
+            for(size_t k = 0; k < blocks.size(); k++) {
+                EliasGamma::encode(sink, k == 0 ? blocks[k] : blocks[k] - 1, NAT); // nb: only the first run may be empty
+            }
+        } else {
+            extras = succ;
+        }
+
+        // intervals
+        std::vector<uint64_t> residuals;
+        if(options_.min_interval > 0) {
+            std::vector<std::pair<uint64_t, size_t>> intervals;
+            for(size_t i = 0; i < extras.size();) {
+                auto j = i + 1;
+                while(j < extras.size() && extras[j] == extras[j - 1] + 1) ++j;
+                if(j - i >= options_.min_interval) {
+                    intervals.emplace_back(extras[i], j - i);
+                } else {
+                    residuals.insert(residuals.end(), extras.begin() + i, extras.begin() + j);
+                }
+                i = j;
+            }
+
+            EliasGamma::encode(sink, intervals.size(), NAT);
+            uint64_t prev_right = 0;
+            for(size_t k = 0; k < intervals.size(); k++) {
+                auto const [left, len] = intervals[k];
+                // nb: intervals are maximal, so there is at least one integer between two intervals
+                EliasGamma::encode(sink, k == 0 ? int2nat(int64_t(left - x)) : left - prev_right - 2, NAT);
+                EliasGamma::encode(sink, len - options_.min_interval, NAT);
+                prev_right = left + len - 1;
+            }
+        } else {
+            residuals = std::move(extras);
+        }
+
+        // residuals
+        for(size_t k = 0; k < residuals.size(); k++) {
+            Zeta::encode(sink, k == 0 ? int2nat(int64_t(residuals[k] - x)) : residuals[k] - residuals[k - 1] - 1, options_.zeta_k, NAT);
+        }
+    }
+
+    void decode_node(uint64_t const x, std::vector<uint64_t>& out) const {
+        internal::BitBufferSource src(bits_.data(), offsets_[x]);
+        out.clear();
+
+        auto const d = (size_t)EliasGamma::decode(src, NAT);
+        if(d == 0) return;
+
+        auto const r = options_.window > 0 ? (size_t)EliasGamma::decode(src, NAT) : 0;
+
+        // copy blocks
+        std::vector<uint64_t> copied;
+        if(r > 0) {
+            std::vector<uint64_t> ref;
+            decode_node(x - r, ref);
+
+            auto const num_blocks = (size_t)EliasGamma::decode(src, NAT);
+            bool copying = true;
+            size_t pos = 0;
+            for(size_t k = 0; k < num_blocks; k++) {
+                auto const len = (size_t)EliasGamma::decode(src, NAT) + (k > 0);
+                if(copying) copied.insert(copied.end(), ref.begin() + pos, ref.begin() + pos + len);
+                pos += len;
+                copying = !copying;
+            }
+            if(copying) copied.insert(copied.end(), ref.begin() + pos, ref.end());
+        }
+
+        // intervals
+        std::vector<uint64_t> intervals;
+        if(options_.min_interval > 0) {
+            auto const num_intervals = (size_t)EliasGamma::decode(src, NAT);
+            uint64_t prev_right = 0;
+            for(size_t k = 0; k < num_intervals; k++) {
+                auto const v = EliasGamma::decode(src, NAT);
+                auto const left = k == 0 ? uint64_t(int64_t(x) + nat2int(v)) : prev_right + 2 + v;
+                auto const len = (size_t)EliasGamma::decode(src, NAT) + options_.min_interval;
+                for(size_t i = 0; i < len; i++) intervals.push_back(left + i);
+                prev_right = left + len - 1;
+            }
+        }
+
+        // residuals
+        auto const num_residuals = d - copied.size() - intervals.size();
+        std::vector<uint64_t> residuals;
+        residuals.reserve(num_residuals);
+        for(size_t k = 0; k < num_residuals; k++) {
+            auto const v = Zeta::decode(src, options_.zeta_k, NAT);
+            residuals.push_back(k == 0 ? uint64_t(int64_t(x) + nat2int(v)) : residuals.back() + 1 + v);
+        }
+
+        // merge
+        std::vector<uint64_t> tmp;
+        tmp.reserve(copied.size() + intervals.size());
+        std::merge(copied.begin(), copied.end(), intervals.begin(), intervals.end(), std::back_inserter(tmp));
+        out.reserve(d);
+        std::merge(tmp.begin(), tmp.end(), residuals.begin(), residuals.end(), std::back_inserter(out));
+    }
+
+public:
+    /**
+     * \brief Constructs an empty graph
+     */
+    WebGraph() : num_nodes_(0), num_edges_(0) {
+    }
+
+    /**
+     * \brief Compresses a graph
+     * 
+     * \tparam Successors the successor function type
+     * \param num_nodes the number of nodes
+     * \param successors a function that, given a node, returns a range containing its successors in strictly increasing order
+     * \param options the compression parameters
+     */
+    template<typename Successors>
+    requires std::invocable<Successors&, uint64_t>
+    WebGraph(size_t const num_nodes, Successors successors, WebGraphOptions const& options = WebGraphOptions())
+        : num_nodes_(num_nodes), num_edges_(0), options_(options) {
+
+        internal::BitBufferSink sink(bits_);
+        std::vector<uint64_t> offsets(num_nodes + 1);
+        std::vector<size_t> chain(num_nodes, 0);
+        std::vector<std::vector<uint64_t>> cache(options.window + 1); // successor lists of the nodes in the window
+
+        for(uint64_t x = 0; x < num_nodes; x++) {
+            auto& cur = cache[x % cache.size()];
+            cur.clear();
+            for(auto const y : successors(x)) {
+                assert(cur.empty() || y > cur.back());
+                cur.push_back(y);
+            }
+            num_edges_ += cur.size();
+
+            // choose the best reference
+            size_t best_r = 0;
+            if(!cur.empty() && options.max_ref_chain > 0) {
+                internal::BitCounter counter;
+                encode_node(counter, x, cur, nullptr, 0);
+                auto best_cost = counter.num_bits_written();
+
+                for(size_t r = 1; r <= std::min(options.window, size_t(x)); r++) {
+                    auto const& ref = cache[(x - r) % cache.size()];
+                    if(ref.empty() || chain[x - r] >= options.max_ref_chain) continue;
+
+                    internal::BitCounter counter;
+                    encode_node(counter, x, cur, &ref, r);
+                    if(counter.num_bits_written() < best_cost) {
+                        best_r = r;
+                        best_cost = counter.num_bits_written();
+                    }
+                }
+            }
+            chain[x] = best_r ? chain[x - best_r] + 1 : 0;
+
+            offsets[x] = sink.num_bits_written();
+            encode_node(sink, x, cur, best_r ? &cache[(x - best_r) % cache.size()] : nullptr, best_r);
+        }
+
+        offsets[num_nodes] = sink.num_bits_written();
+        offsets_ = EliasFano(offsets.begin(), offsets.end(), offsets[num_nodes]);
+    }
+
+    /**
+     * \brief Reports the number of nodes
+     * 
+     * \return the number of nodes
+     */
+    inline size_t num_nodes() const { return num_nodes_; }
+
+    /**
+     * \brief Reports the number of edges
+     * 
+     * \return the number of edges
+     */
+    inline size_t num_edges() const { return num_edges_; }
+
+    /**
+     * \brief Reports the compression parameters
+     * 
+     * \return the compression parameters
+     */
+    inline WebGraphOptions const& options() const { return options_; }
+
+    /**
+     * \brief Reports the number of successors of the given node
+     * 
+     * \param x the node
+     * \return the outdegree of \c x
+     */
+    size_t outdegree(uint64_t const x) const {
+        assert(x < num_nodes_);
+        internal::BitBufferSource src(bits_.data(), offsets_[x]);
+        return (size_t)EliasGamma::decode(src, NAT);
+    }
+
+    /**
+     * \brief Decodes the successors of the given node
+     * 
+     * \param x the node
+     * \return the successors of \c x in increasing order
+     */
+    std::vector<uint64_t> successors(uint64_t const x) const {
+        assert(x < num_nodes_);
+        std::vector<uint64_t> out;
+        decode_node(x, out);
+        return out;
+    }
+
+    /**
+     * \brief Reports the total size of the encoded successor lists and the offsets in bits
+     * 
+     * \return the size in bits
+     */
+    inline size_t size_in_bits() const {
+        return 64 * bits_.size() + offsets_.size_in_bits();
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * code/zero_run_length.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_ZERO_RUN_LENGTH_HPP
+#define _CODE_ZERO_RUN_LENGTH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace code {
+
+/**
+ * \brief Run-length encoding of zeros as done by bzip2
+ * 
+ * Runs of zeros, which dominate the output of the \ref code::MoveToFront "MoveToFront" transform of typical inputs,
+ * are replaced by the bijective base-2 representation of their lengths using the two symbols \ref RUNA and \ref RUNB, least significant digit first.
+ * Every non-zero rank \c r is represented by the symbol <tt>r+1</tt>.
+ * The output thus consists of symbols in the range from 0 to 256 and is well suited for entropy coding, e.g., using \ref code::Huffman "Huffman" codes.
+ */
+class ZeroRunLength {
+public:
+    /**
+     * \brief The symbol representing a digit of value one in a run length
+     */
+    static constexpr uint16_t RUNA = 0;
+
+    /**
+     * \brief The symbol representing a digit of value two in a run length
+     */
+    static constexpr uint16_t RUNB = 1;
+
+    /**
+     * \brief The size of the output alphabet
+     */
+    static constexpr size_t ALPHABET_SIZE = 257;
+
+private:
+    template<std::output_iterator<uint16_t> Out>
+    static Out encode_run(size_t run, Out out) {
+        while(run) {
+            if(run & 1) {
+                *out++ = RUNA;
+                run = (run - 1) >> 1;
+            } else {
+                *out++ = RUNB;
+                run = (run - 2) >> 1;
+            }
+        }
+        return out;
+    }
+
+public:
+    /**
+     * \brief Encodes the given ranks
+     * 
+     * \tparam Out the output iterator type
+     * \param in the input ranks
+     * \param num the number of ranks
+     * \param out the output
+     * \return the output iterator following the last written symbol
+     */
+    template<std::output_iterator<uint16_t> Out>
+    static Out encode(uint8_t const* in, size_t num, Out out) {
+        size_t run = 0;
+        while(num--) {
+            auto const r = *in++;
+            if(r == 0) {
+                ++run;
+            } else {
+                out = encode_run(run, out);
+                run = 0;
+                *out++ = uint16_t(r + 1);
+            }
+        }
+        return encode_run(run, out);
+    }
+
+    /**
+     * \brief Decodes the given symbols
+     * 
+     * \tparam Out the output iterator type
+     * \param in the input symbols
+     * \param num the number of symbols
+     * \param out the output
+     * \return the output iterator following the last written rank
+     */
+    template<std::output_iterator<uint8_t> Out>
+    static Out decode(uint16_t const* in, size_t num, Out out) {
+        size_t run = 0;
+        size_t digit = 1;
+        while(num--) {
+            auto const sym = *in++;
+            if(sym <= RUNB) {
+                run += (size_t(sym) + 1) * digit;
+                digit <<= 1;
+            } else {
+                for(; run; --run) *out++ = 0;
+                digit = 1;
+                *out++ = uint8_t(sym - 1);
+            }
+        }
+        for(; run; --run) *out++ = 0;
+        return out;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * code/zeta.hpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _CODE_ZETA_HPP
+#define _CODE_ZETA_HPP
+
+#include <bit>
+#include <cassert>
+#include <vector>
+
+#include "unary.hpp"
+#include "binary.hpp"
+
+namespace code {
+
+/**
+ * \brief Boldi and Vigna's zeta encoding and decoding of integers
+ * 
+ * For a parameter \c k, the zeta code of an integer <tt>x >= 1</tt> is defined as follows. Let \c h be such that <tt>2^(hk) <= x < 2^((h+1)k)</tt>.
+ * Then \c h is encoded in unary, followed by the minimal binary code of <tt>x - 2^(hk)</tt> in the interval <tt>[0, 2^((h+1)k) - 2^(hk))</tt>.
+ * Zeta codes are well suited for power law distributions, such as the gaps between the successors of nodes in web graphs.
+ * For <tt>k = 1</tt>, the zeta code has the same lengths as the gamma code.
+ * 
+ * Minimal binary codes are usually defined in MSBF order. Since this library writes bits LSBF, the minimal binary code of \c z
+ * in an interval of size \c n is defined such that its first <tt>s - 1</tt> bits, where <tt>s = ceil(log2 n)</tt>, determine whether another bit follows.
+ * 
+ * Note that the zeta code is not defined for zero.
+ * 
+ * Instances of this class satisfy both the \ref code::IntegerEncoder "IntegerEncoder" and the \ref code::IntegerDecoder "IntegerDecoder" concepts,
+ * as well as the \ref code::Checkpointable "Checkpointable" concept.
+ */
+class Zeta {
+private:
+    // computes 2^(hk), where 2^64 and beyond are represented as zero
+    inline static constexpr uint64_t interval_begin(size_t const h, uint8_t const k) {
+        return h * k >= 64 ? 0 : uint64_t(1) << (h * k);
+    }
+
+    template<BitSink Sink>
+    inline static void encode_minimal_binary(Sink& sink, uint64_t const z, uint64_t const n) {
+        auto const s = (size_t)std::bit_width(n - 1);
+        if(s == 0) return;
+
+        auto const cutoff = (s == 64 ? 0 : (uint64_t(1) << s)) - n;
+        if(z < cutoff) {
+            Binary::encode(sink, z, s - 1);
+        } else {
+            auto const y = z + cutoff;
+            Binary::encode(sink, y >> 1, s - 1);
+            sink.write(bool(y & 1));
+        }
+    }
+
+    template<BitSource Source>
+    inline static uint64_t decode_minimal_binary(Source& src, uint64_t const n) {
+        auto const s = (size_t)std::bit_width(n - 1);
+        if(s == 0) return 0;
+
+        auto const cutoff = (s == 64 ? 0 : (uint64_t(1) << s)) - n;
+        auto const v = (uint64_t)Binary::decode(src, s - 1);
+        if(v < cutoff) return v;
+        return ((v << 1) | uint64_t(src.read())) - cutoff;
+    }
+
+public:
+    /**
+     * \brief Encodes an integer using zeta code
+     * 
+     * Beware that the zeta code for zero is not defined, and trying to encode zero using this function causes undefined behaviour!
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param x the integer to encode
+     * \param k the parameter of the zeta code, at least one
+     */
+    template<BitSink Sink>
+    inline static void encode(Sink& sink, uintmax_t x, uint8_t k) {
+        assert(x > 0);
+        assert(k > 0);
+        auto const h = (size_t)(std::bit_width(x) - 1) / k;
+        auto const lo = interval_begin(h, k);
+        Unary::encode(sink, h);
+        encode_minimal_binary(sink, x - lo, interval_begin(h + 1, k) - lo);
+    }
+
+    /**
+     * \brief Encodes an integer from the given universe using zeta code
+     * 
+     * This function actually encodes one plus the value of the integer relative to the universe's minimum.
+     * Note that therefore, trying to encode \c UINTMAX_MAX is undefined.
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param x the integer to encode
+     * \param k the parameter of the zeta code, at least one
+     * \param u the universe of \c x
+     */
+    template<BitSink Sink>
+    inline static void encode(Sink& sink, uintmax_t x, uint8_t k, Universe u) {
+        assert(u.rel(x) < UINTMAX_MAX);
+        encode(sink, u.rel(x) + 1, k);
+    }
+
+    /**
+     * \brief Decodes an integer using zeta code
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param k the parameter of the zeta code, at least one
+     * \return the decoded integer
+     */
+    template<BitSource Source>
+    inline static uintmax_t decode(Source& src, uint8_t k) {
+        auto const h = (size_t)Unary::decode(src);
+        auto const lo = interval_begin(h, k);
+        return lo + decode_minimal_binary(src, interval_begin(h + 1, k) - lo);
+    }
+
+    /**
+     * \brief Decodes an integer from the given universe using zeta code
+     * 
+     * This function actually decodes the value of the integer relative to the universe's minimum and adds it afterwards.
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param k the parameter of the zeta code, at least one
+     * \param u the universe of the integer to decode
+     * \return the decoded integer
+     */
+    template<BitSource Source>
+    inline static uintmax_t decode(Source& src, uint8_t k, Universe u) {
+        return u.abs(decode(src, k)) - 1;
+    }
+
+private:
+    uint8_t k_;
+
+public:
+    /**
+     * \brief Constructs a zeta coder with a fixed parameter
+     * 
+     * \param k the parameter of the zeta code, at least one
+     */
+    inline constexpr Zeta(uint8_t k) : k_(k) {
+    }
+
+    /**
+     * \brief Encodes an integer from the given universe using zeta code
+     * 
+     * \tparam Sink the bit sink type
+     * \param sink the bit sink
+     * \param x the integer to encode
+     * \param u the universe of \c x
+     */
+    template<BitSink Sink>
+    inline void encode(Sink& sink, uintmax_t x, Universe u) {
+        encode(sink, x, k_, u);
+    }
+
+    /**
+     * \brief Decodes an integer from the given universe using zeta code
+     * 
+     * \tparam Source the bit source type
+     * \param src the bit source
+     * \param u the universe of the integer to decode
+     * \return the decoded integer
+     */
+    template<BitSource Source>
+    inline uintmax_t decode(Source& src, Universe u) {
+        return decode(src, k_, u);
+    }
+
+    /**
+     * \brief Reports the parameter of the zeta code used by this coder
+     * 
+     * \return the parameter \c k
+     */
+    uint8_t k() const { return k_; }
+
+    /**
+     * \brief Saves the parameter of this coder
+     * 
+     * \param state the state words to append to
+     */
+    void save_state(std::vector<uint64_t>& state) const { state.push_back(k_); }
+
+    /**
+     * \brief Restores the parameter of this coder
+     * 
+     * \param state the state words, which are advanced past the restored state
+     */
+    void load_state(uint64_t const*& state) { k_ = (uint8_t)*state++; }
+};
+
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace code::test {
 
@@ -25,6 +26,21 @@ struct SimpleUint64BitSink {
     inline size_t num_bits_written() const { return 0; }
 };
 
+struct BitVectorSink {
+    std::vector<bool> bits;
+
+    inline void write(bool b) {
+        bits.push_back(b);
+    }
+
+    inline void write(uint64_t bits, size_t num) {
+        for(size_t i = 0; i < num; i++) write(i < 64 && ((bits >> i) & 1));
+    }
+
+    inline void flush() {}
+    inline size_t num_bits_written() const { return bits.size(); }
+};
+
 struct SimpleUint64BitSource {
     uint64_t value;
 
@@ -0,0 +1,232 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/bit_feed.hpp>
+#include <code/elias_delta.hpp>
+#include <code/huffman.hpp>
+#include <code/rice.hpp>
+#include <code/vbyte.hpp>
+#include <code/internal/bit_buffer.hpp>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+std::vector<uint8_t> to_bytes(std::vector<uint64_t> const& words, size_t const num_bits) {
+    std::vector<uint8_t> bytes((num_bits + 7) / 8);
+    std::memcpy(bytes.data(), words.data(), bytes.size()); // nb: assuming little endian
+    return bytes;
+}
+
+// pushes the input in chunks of the given sizes and decodes as many integers as possible after each chunk
+template<typename Decoder>
+std::vector<uintmax_t> decode_chunked(std::vector<uint8_t> const& bytes, size_t const num, size_t const max_chunk, Decoder& decoder) {
+    std::mt19937_64 gen(max_chunk);
+    BitFeed feed;
+    std::vector<uintmax_t> out;
+    size_t pos = 0;
+    while(pos < bytes.size()) {
+        auto const chunk = std::min(bytes.size() - pos, 1 + gen() % max_chunk);
+        feed.push(bytes.data() + pos, chunk);
+        pos += chunk;
+
+        while(out.size() < num) {
+            auto const x = decoder.decode(feed);
+            if(!x) {
+                CHECK(feed.available() == 0); // nb: a decoder only gives up if it has consumed all input
+                break;
+            }
+            out.push_back(*x);
+        }
+    }
+    CHECK(feed.available() < 8);
+    return out;
+}
+
+template<typename Encode, typename MakeDecoder>
+void test_resumable(std::vector<uintmax_t> const& values, Encode encode, MakeDecoder make_decoder) {
+    std::vector<uint64_t> words;
+    internal::BitBufferSink sink(words);
+    for(auto const x : values) encode(sink, x);
+    auto const bytes = to_bytes(words, sink.num_bits_written());
+
+    for(size_t const max_chunk : {1, 2, 3, 8, 13, 100}) {
+        auto decoder = make_decoder();
+        CHECK(decode_chunked(bytes, values.size(), max_chunk, decoder) == values);
+    }
+}
+
+std::vector<uintmax_t> test_values(bool const positive) {
+    std::vector<uintmax_t> values;
+    for(uintmax_t x = 0; x < 200; x++) values.push_back(x);
+
+    std::mt19937_64 gen(95);
+    for(size_t i = 0; i < 2'000; i++) values.push_back(gen() >> (gen() % 64));
+    for(size_t k = 0; k < 64; k++) values.push_back(uintmax_t(1) << k);
+    values.push_back(UINTMAX_MAX);
+
+    if(positive) {
+        for(auto& x : values) x = std::max(x, uintmax_t(1));
+    }
+    return values;
+}
+
+TEST_SUITE("code::BitFeed") {
+    TEST_CASE("BitFeed") {
+        BitFeed feed;
+        CHECK(feed.available() == 0);
+
+        uint8_t const bytes[] = { 0b1010'0101, 0xFF, 0x00, 0x3C };
+        feed.push(bytes, 2);
+        CHECK(feed.available() == 16);
+        CHECK(feed.read() == true);
+        CHECK(feed.read() == false);
+        CHECK(feed.peek(6) == 0b101001);
+        CHECK(feed.read(10) == 0b11'1110'1001);
+        CHECK(feed.available() == 4);
+
+        feed.push(bytes + 2, 2);
+        feed.push_bits(0b101, 3);
+        CHECK(feed.available() == 23);
+        CHECK(feed.read(23) == (0b101ULL << 20 | 0x3C00ULL << 4 | 0xF));
+        CHECK(feed.available() == 0);
+
+        // read across many words
+        std::mt19937_64 gen(96);
+        std::vector<uint64_t> expected;
+        for(size_t i = 0; i < 1'000; i++) {
+            auto const w = gen();
+            expected.push_back(w);
+            feed.push((uint8_t const*)&w, 8);
+            if(i % 2) CHECK(feed.read(64) == expected[i / 2]);
+        }
+        for(size_t i = 500; i < 1'000; i++) {
+            CHECK(feed.read(32) == (expected[i] & UINT32_MAX));
+            CHECK(feed.read(32) == (expected[i] >> 32));
+        }
+        CHECK(feed.available() == 0);
+    }
+
+    TEST_CASE("Unary") {
+        std::vector<uintmax_t> values;
+        for(uintmax_t x = 0; x < 300; x++) values.push_back(x);
+        test_resumable(values, [](auto& sink, uintmax_t x){ Unary::encode(sink, x); }, [](){ return Unary::ResumableDecoder(); });
+    }
+
+    TEST_CASE("Binary") {
+        for(size_t const bits : {1, 7, 8, 13, 33, 64}) {
+            auto values = test_values(false);
+            for(auto& x : values) if(bits < 64) x &= (uintmax_t(1) << bits) - 1;
+            test_resumable(values, [&](auto& sink, uintmax_t x){ Binary::encode(sink, x, bits); }, [&](){ return Binary::ResumableDecoder(bits); });
+        }
+    }
+
+    TEST_CASE("EliasGamma") {
+        test_resumable(test_values(true), [](auto& sink, uintmax_t x){ EliasGamma::encode(sink, x); }, [](){ return EliasGamma::ResumableDecoder(); });
+    }
+
+    TEST_CASE("EliasDelta") {
+        test_resumable(test_values(true), [](auto& sink, uintmax_t x){ EliasDelta::encode(sink, x); }, [](){ return EliasDelta::ResumableDecoder(); });
+    }
+
+    TEST_CASE("Rice") {
+        for(uint8_t const p : {1, 5, 17, 40, 63}) {
+            test_resumable(test_values(false), [&](auto& sink, uintmax_t x){ Rice::encode(sink, x, p); }, [&](){ return Rice::ResumableDecoder(p); });
+        }
+    }
+
+    TEST_CASE("Vbyte") {
+        for(uint8_t const b : {1, 3, 7, 8, 16}) {
+            test_resumable(test_values(false), [&](auto& sink, uintmax_t x){ Vbyte::encode(sink, x, b); }, [&](){ return Vbyte::ResumableDecoder(b); });
+        }
+    }
+
+    TEST_CASE("Huffman") {
+        std::string const text = "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Vivamus aliquet in turpis vitae mattis.";
+        HuffmanTree<char> tree(text.begin(), text.end());
+        auto const table = tree.table();
+
+        // encode the tree followed by the text
+        std::vector<uint64_t> words;
+        internal::BitBufferSink sink(words);
+        tree.encode(sink);
+        for(auto const c : text) Huffman::encode(sink, (unsigned char)c, table);
+        auto const bytes = to_bytes(words, sink.num_bits_written());
+
+        for(size_t const max_chunk : {1, 2, 5, 100}) {
+            std::mt19937_64 gen(max_chunk);
+            BitFeed feed;
+            HuffmanTree<char>::ResumableDecoder tree_decoder;
+            std::optional<HuffmanTree<char>> decoded_tree;
+            std::optional<Huffman::ResumableDecoder<HuffmanTree<char>::Node>> decoder;
+            std::string decoded;
+
+            size_t pos = 0;
+            while(pos < bytes.size()) {
+                auto const chunk = std::min(bytes.size() - pos, 1 + gen() % max_chunk);
+                feed.push(bytes.data() + pos, chunk);
+                pos += chunk;
+
+                if(!decoded_tree) {
+                    decoded_tree = tree_decoder.decode(feed);
+                    if(!decoded_tree) continue;
+                    decoder.emplace(decoded_tree->root());
+                }
+                while(decoded.size() < text.size()) {
+                    auto const c = decoder->decode(feed);
+                    if(!c) break;
+                    decoded.push_back((char)*c);
+                }
+            }
+
+            REQUIRE(decoded_tree);
+            CHECK(decoded_tree->size() == tree.size());
+            for(auto const c : text) CHECK((*decoded_tree)[c] == tree[c]);
+            CHECK(decoded == text);
+        }
+    }
+
+    TEST_CASE("HuffmanTree from topology") {
+        // a tree with leaves a (depth 1), b and c (depth 2)
+        HuffmanTree<char> tree({ false, true, false, true, true }, { 'a', 'b', 'c' });
+        CHECK(tree.size() == 5);
+        CHECK(tree['a'] == HuffmanCode{ 0b0U, 1 });
+        CHECK(tree['b'] == HuffmanCode{ 0b01U, 2 });
+        CHECK(tree['c'] == HuffmanCode{ 0b11U, 2 });
+
+        HuffmanTree<char> empty({ true }, {});
+        CHECK(empty.size() == 0);
+    }
+}
+
+}
@@ -0,0 +1,173 @@
+/**
+ * test_bwt.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/bwt.hpp>
+#include <code/bwt_compressor.hpp>
+#include <iopp/util/bit_packer.hpp>
+#include <iopp/util/bit_unpacker.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+std::string make_random(size_t const num, size_t const sigma, uint64_t x = 1) {
+    std::string s;
+    for(size_t i = 0; i < num; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        s.push_back(char('a' + (x >> 33) % sigma));
+    }
+    return s;
+}
+
+std::string make_text(size_t const num_words) {
+    static char const* words[] = {
+        "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "vivamus", "aliquet", "in", "turpis", "vitae",
+        "mattis", "etiam", "nunc", "nibh", "ornare", "tincidunt", "quis", "iaculis", "eget", "orci", "morbi", "viverra", "maximus",
+        "quam", "vel", "feugiat"
+    };
+
+    std::string text;
+    uint64_t x = 1;
+    for(size_t i = 0; i < num_words; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        if(i) text.push_back(' ');
+        text.append(words[(x >> 33) % 29]);
+    }
+    return text;
+}
+
+TEST_SUITE("code::BWT") {
+    TEST_CASE("suffix_array") {
+        auto check = [](std::string const& s){
+            std::vector<int32_t> expected(s.size());
+            std::iota(expected.begin(), expected.end(), 0);
+            std::sort(expected.begin(), expected.end(), [&](int32_t a, int32_t b){ return s.compare(a, std::string::npos, s, b, std::string::npos) < 0; });
+            CHECK(internal::sais((uint8_t const*)s.data(), s.size(), 256) == expected);
+        };
+
+        check("");
+        check("a");
+        check("ab");
+        check("ba");
+        check("banana");
+        check("mississippi");
+        check(std::string(1000, 'x'));
+        for(size_t sigma : { 1, 2, 3, 4, 26 }) {
+            for(uint64_t seed = 1; seed <= 10; seed++) {
+                check(make_random(seed * 97, sigma, seed));
+            }
+        }
+        check(make_text(500));
+    }
+
+    TEST_CASE("transform") {
+        std::string const banana = "banana";
+        std::string bwt(banana.size(), 0);
+        auto const primary = BWT::forward((uint8_t const*)banana.data(), banana.size(), (uint8_t*)bwt.data());
+        CHECK(bwt == "annbaa");
+        CHECK(primary == 4);
+
+        auto roundtrip = [](std::string const& s){
+            std::string bwt(s.size(), 0);
+            auto const primary = BWT::forward((uint8_t const*)s.data(), s.size(), (uint8_t*)bwt.data());
+
+            std::string inv(s.size(), 0);
+            BWT::inverse((uint8_t const*)bwt.data(), bwt.size(), primary, (uint8_t*)inv.data());
+            CHECK(inv == s);
+        };
+
+        roundtrip("");
+        roundtrip("a");
+        roundtrip("banana");
+        roundtrip("mississippi");
+        roundtrip(std::string(1000, 'x'));
+        roundtrip(make_random(10'000, 2));
+        roundtrip(make_random(10'000, 26));
+        roundtrip(make_text(10'000));
+    }
+}
+
+TEST_SUITE("code::BWTCompressor") {
+    size_t roundtrip(std::string const& input, BWTOptions const& options) {
+        std::vector<uint64_t> buffer;
+        size_t bits;
+        {
+            auto sink = iopp::BitPacker(std::back_inserter(buffer));
+            BWTCompressor::encode(sink, (uint8_t const*)input.data(), input.size(), options);
+            bits = sink.num_bits_written();
+        }
+
+        std::vector<uint8_t> decoded;
+        {
+            auto src = iopp::BitUnpacker(buffer.data());
+            BWTCompressor::decode(src, decoded, options);
+        }
+        CHECK(std::string(decoded.begin(), decoded.end()) == input);
+        return bits;
+    }
+
+    TEST_CASE("roundtrip") {
+        auto const text = make_text(50'000);
+
+        for(size_t threads : { 1, 3 }) {
+            for(size_t block_size : { size_t(1), size_t(1000), size_t(65536), text.size() }) {
+                BWTOptions options;
+                options.block_size = block_size;
+                options.threads = threads;
+
+                roundtrip("", options);
+                roundtrip("x", options);
+                roundtrip(std::string(5000, 'x'), options);
+                if(block_size > 1) roundtrip(text, options);
+            }
+        }
+    }
+
+    TEST_CASE("ratio") {
+        // larger blocks yield better compression
+        auto const text = make_text(50'000);
+
+        BWTOptions options;
+        options.block_size = 4096;
+        auto const small = roundtrip(text, options);
+
+        options.block_size = text.size();
+        auto const large = roundtrip(text, options);
+        CHECK(large < small);
+        CHECK(large < text.size() * 8 / 3);
+    }
+}
+
+}
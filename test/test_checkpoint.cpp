@@ -0,0 +1,210 @@
+/**
+ * test_checkpoint.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/checkpoint.hpp>
+#include <code/elias_gamma.hpp>
+#include <code/file_bit_source.hpp>
+#include <code/gorilla.hpp>
+#include <code/internal/bit_buffer.hpp>
+#include <code/move_to_front.hpp>
+#include <code/rice.hpp>
+#include <code/vbyte.hpp>
+#include <code/zeta.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+static_assert(Checkpointable<Rice>);
+static_assert(Checkpointable<Vbyte>);
+static_assert(Checkpointable<Zeta>);
+static_assert(Checkpointable<Gorilla>);
+static_assert(Checkpointable<MoveToFront>);
+static_assert(SeekableBitSource<internal::BitBufferSource>);
+
+struct Record {
+    GorillaPoint point;
+    uint64_t gamma;
+    uint64_t rice;
+};
+
+std::vector<Record> generate_records(size_t const num) {
+    std::mt19937_64 gen(97);
+    std::vector<Record> records;
+    int64_t t = 1'700'000'000;
+    double v = 20.0;
+    for(size_t i = 0; i < num; i++) {
+        t += 60 + int64_t(gen() % 5) - 2;
+        if(gen() % 4) v += double(int64_t(gen() % 21) - 10) / 8.0;
+        records.push_back(Record { GorillaPoint { t, v }, 1 + gen() % 1000, gen() % 100'000 });
+    }
+    return records;
+}
+
+template<BitSource Source>
+void check_records(Source& src, Gorilla& gorilla, Rice& rice, std::vector<Record> const& records, size_t const begin, size_t const end) {
+    for(size_t i = begin; i < end; i++) {
+        auto const p = gorilla.decode(src);
+        CHECK(p.timestamp == records[i].point.timestamp);
+        CHECK(p.value == records[i].point.value);
+        CHECK(EliasGamma::decode(src) == records[i].gamma);
+        CHECK(rice.decode(src, Universe::umax()) == records[i].rice);
+    }
+}
+
+TEST_SUITE("code::Checkpoint") {
+    TEST_CASE("serialize") {
+        Checkpoint cp;
+        cp.pos = 123'456'789;
+        cp.state = { 0, 1, UINT64_MAX, 42 };
+
+        std::vector<uint64_t> words;
+        {
+            internal::BitBufferSink sink(words);
+            cp.encode(sink);
+            Checkpoint{}.encode(sink);
+        }
+        internal::BitBufferSource src(words.data());
+        CHECK(Checkpoint::decode(src) == cp);
+        CHECK(Checkpoint::decode(src) == Checkpoint{});
+    }
+
+    TEST_CASE("resume") {
+        auto const records = generate_records(20'000);
+        auto const half = records.size() / 2;
+
+        // encode
+        std::vector<uint64_t> words;
+        size_t num_bits;
+        {
+            internal::BitBufferSink sink(words);
+            Gorilla gorilla;
+            Rice rice(7);
+            for(auto const& r : records) {
+                gorilla.encode(sink, r.point);
+                EliasGamma::encode(sink, r.gamma);
+                rice.encode(sink, r.rice, Universe::umax());
+            }
+            num_bits = sink.num_bits_written();
+        }
+
+        // decode the first half and take a checkpoint, which we serialize
+        std::vector<uint64_t> cp_words;
+        {
+            internal::BitBufferSource src(words.data());
+            Gorilla gorilla;
+            Rice rice(7);
+            check_records(src, gorilla, rice, records, 0, half);
+
+            internal::BitBufferSink sink(cp_words);
+            make_checkpoint(src, gorilla, rice).encode(sink);
+        }
+
+        internal::BitBufferSource cp_src(cp_words.data());
+        auto const cp = Checkpoint::decode(cp_src);
+        CHECK(cp.pos < num_bits);
+
+        SUBCASE("buffer") {
+            internal::BitBufferSource src(words.data());
+            Gorilla gorilla;
+            Rice rice(3); // nb: the exponent is restored from the checkpoint
+            restore_checkpoint(cp, src, gorilla, rice);
+            CHECK(rice.exponent() == 7);
+            check_records(src, gorilla, rice, records, half, records.size());
+        }
+
+        SUBCASE("file") {
+            auto const path = (std::filesystem::temp_directory_path() / "code-test-checkpoint").string();
+            {
+                std::ofstream out(path, std::ios::binary);
+                out.write((char const*)words.data(), (num_bits + 7) / 8); // nb: assuming little endian
+            }
+            {
+                FileBitSource src(path.c_str(), FileBitSourceOptions { .block_size = 4096 });
+                REQUIRE(src.is_open());
+                Gorilla gorilla;
+                Rice rice(3);
+                restore_checkpoint(cp, src, gorilla, rice);
+                check_records(src, gorilla, rice, records, half, records.size());
+                CHECK(!src.error());
+            }
+            std::remove(path.c_str());
+        }
+    }
+
+    TEST_CASE("move_to_front") {
+        std::mt19937_64 gen(97);
+        std::vector<uint8_t> input;
+        for(size_t i = 0; i < 10'000; i++) input.push_back(uint8_t(gen() % 16 + 'a'));
+
+        MoveToFront encoder;
+        std::vector<uint8_t> ranks(input.size());
+        encoder.encode(input.data(), input.size(), ranks.data());
+
+        // decode the first half and resume decoding the second half in a fresh transform
+        auto const half = input.size() / 2;
+        std::vector<uint8_t> output(input.size());
+        std::vector<uint64_t> state;
+        {
+            MoveToFront decoder;
+            decoder.decode(ranks.data(), half, output.data());
+            decoder.save_state(state);
+        }
+        {
+            MoveToFront decoder;
+            uint64_t const* p = state.data();
+            decoder.load_state(p);
+            CHECK(p == state.data() + state.size());
+            decoder.decode(ranks.data() + half, input.size() - half, output.data() + half);
+        }
+        CHECK(output == input);
+    }
+
+    TEST_CASE("parameters") {
+        std::vector<uint64_t> state;
+        Vbyte(5).save_state(state);
+        Zeta(4).save_state(state);
+
+        Vbyte vbyte(1);
+        Zeta zeta(1);
+        uint64_t const* p = state.data();
+        vbyte.load_state(p);
+        zeta.load_state(p);
+        CHECK(vbyte.block() == 5);
+        CHECK(zeta.k() == 4);
+    }
+}
+
+}
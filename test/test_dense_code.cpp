@@ -0,0 +1,220 @@
+/**
+ * test_dense_code.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/dense_code.hpp>
+#include <code/dense_vocabulary.hpp>
+#include <iopp/util/bit_packer.hpp>
+#include <iopp/util/bit_unpacker.hpp>
+
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::DenseCode") {
+    TEST_CASE("end_tagged") {
+        auto const etdc = DenseCode::end_tagged();
+        CHECK(etdc.stoppers() == 128);
+        CHECK(etdc.continuers() == 128);
+
+        auto codeword_of = [&](uintmax_t rank){
+            uint8_t buf[16];
+            auto const end = etdc.encode(buf, rank);
+            CHECK(size_t(end - buf) == etdc.length(rank));
+            return std::vector<uint8_t>(buf, end);
+        };
+
+        CHECK(codeword_of(0) == std::vector<uint8_t>{0});
+        CHECK(codeword_of(127) == std::vector<uint8_t>{127});
+        CHECK(codeword_of(128) == std::vector<uint8_t>{128, 0});
+        CHECK(codeword_of(255) == std::vector<uint8_t>{128, 127});
+        CHECK(codeword_of(256) == std::vector<uint8_t>{129, 0});
+        CHECK(codeword_of(128 + 128 * 128 - 1) == std::vector<uint8_t>{255, 127});
+        CHECK(codeword_of(128 + 128 * 128) == std::vector<uint8_t>{128, 128, 0});
+    }
+
+    TEST_CASE("roundtrip") {
+        std::vector<uintmax_t> ranks;
+        for(uintmax_t x = 0; x < 70'000; x++) ranks.push_back(x);
+        for(uintmax_t x = 1; x < UINTMAX_MAX / 3; x *= 3) ranks.push_back(x);
+        ranks.push_back(UINTMAX_MAX);
+
+        for(uint16_t s : {1, 2, 100, 128, 200, 254}) {
+            DenseCode code(s);
+
+            size_t total = 0;
+            for(auto const x : ranks) total += code.length(x);
+
+            std::vector<uint8_t> buffer(total);
+            auto const end = code.encode_bulk(buffer.data(), ranks.begin(), ranks.end());
+            CHECK(end == buffer.data() + total);
+
+            // decode one by one
+            uint8_t const* in = buffer.data();
+            for(auto const x : ranks) CHECK(code.decode(in) == x);
+            CHECK(in == buffer.data() + total);
+
+            // decode in bulk
+            std::vector<uintmax_t> decoded(ranks.size());
+            CHECK(code.decode_bulk(buffer.data(), decoded.begin(), decoded.size()) == buffer.data() + total);
+            CHECK(decoded == ranks);
+        }
+    }
+
+    TEST_CASE("optimal") {
+        // naively compute the encoding size for all choices of s
+        auto cost = [](std::vector<size_t> const& freqs, DenseCode const& code){
+            size_t c = 0;
+            for(size_t i = 0; i < freqs.size(); i++) c += freqs[i] * code.length(i);
+            return c;
+        };
+
+        auto check = [&](std::vector<size_t> const& freqs){
+            auto const opt = DenseCode::optimal(freqs.begin(), freqs.end());
+            auto const opt_cost = cost(freqs, opt);
+            for(uint16_t s = 1; s < 256; s++) CHECK(opt_cost <= cost(freqs, DenseCode(s)));
+            return opt;
+        };
+
+        // few symbols can all be encoded using a single byte
+        {
+            std::vector<size_t> freqs(200, 1);
+            CHECK(cost(freqs, check(freqs)) == 200);
+        }
+
+        // Zipf-like distributions
+        for(size_t n : {256, 1'000, 20'000, 100'000}) {
+            std::vector<size_t> freqs;
+            for(size_t i = 0; i < n; i++) freqs.push_back(1'000'000 / (i + 1));
+            check(freqs);
+        }
+
+        // uniform distribution
+        {
+            std::vector<size_t> freqs(40'000, 5);
+            check(freqs);
+        }
+    }
+}
+
+TEST_SUITE("code::DenseVocabulary") {
+    // a stream of word IDs with a skewed distribution
+    std::vector<uint32_t> make_text() {
+        std::vector<uint32_t> text;
+        uint64_t x = 1;
+        for(size_t i = 0; i < 50'000; i++) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            auto const r = (x >> 33) % 10'000;
+            text.push_back(1'000'000 + uint32_t(100'000'000 / (r * r + 1000))); // nb: word IDs are not ranks
+        }
+        return text;
+    }
+
+    TEST_CASE("roundtrip") {
+        auto const text = make_text();
+        for(bool end_tagged : {false, true}) {
+            DenseVocabulary<uint32_t> voc(text.begin(), text.end(), end_tagged);
+            if(end_tagged) CHECK(voc.code().stoppers() == 128);
+
+            // the most frequent symbols are encoded using single bytes
+            CHECK(voc.code().length(voc.rank(voc.symbol(0))) == 1);
+
+            std::vector<uint8_t> buffer(text.size() * 4);
+            auto const end = voc.encode_bulk(buffer.data(), text.begin(), text.end());
+
+            // bulk encoding equals encoding one by one
+            {
+                std::vector<uint8_t> buffer2(text.size() * 4);
+                uint8_t* out = buffer2.data();
+                for(auto const c : text) out = voc.encode(out, c);
+                CHECK(size_t(out - buffer2.data()) == size_t(end - buffer.data()));
+                CHECK(std::equal(buffer.data(), end, buffer2.data()));
+            }
+
+            // decode one by one
+            {
+                uint8_t const* in = buffer.data();
+                for(auto const c : text) CHECK(voc.decode(in) == c);
+                CHECK(in == end);
+            }
+
+            // decode in bulk
+            {
+                std::vector<uint32_t> decoded(text.size());
+                CHECK(voc.decode_bulk(buffer.data(), decoded.data(), decoded.size()) == end);
+                CHECK(decoded == text);
+            }
+        }
+    }
+
+    TEST_CASE("encoding") {
+        auto const text = make_text();
+        DenseVocabulary<uint32_t> voc(text.begin(), text.end());
+
+        uintmax_t out[8192]; // "large enough"
+        {
+            auto sink = iopp::BitPacker(out);
+            voc.encode(sink);
+        }
+        {
+            auto src = iopp::BitUnpacker(out);
+            DenseVocabulary<uint32_t> decoded(src);
+            CHECK(decoded.code().stoppers() == voc.code().stoppers());
+            CHECK(decoded.size() == voc.size());
+            for(size_t i = 0; i < voc.size(); i++) CHECK(decoded.symbol(i) == voc.symbol(i));
+        }
+    }
+
+    TEST_CASE("find") {
+        auto const text = make_text();
+        DenseVocabulary<uint32_t> voc(text.begin(), text.end());
+
+        std::vector<uint8_t> buffer(text.size() * 4);
+        auto const* begin = buffer.data();
+        auto const* end = voc.encode_bulk(buffer.data(), text.begin(), text.end());
+
+        // search symbols of various ranks and verify the number of occurrences
+        for(uintmax_t r : {0, 1, 5, 200, 1000}) {
+            if(r >= voc.size()) continue;
+            auto const c = voc.symbol(r);
+            auto const expected = size_t(std::count(text.begin(), text.end(), c));
+
+            size_t found = 0;
+            for(auto it = voc.find(begin, end, c); it != end; it = voc.find(it + 1, end, c)) {
+                auto const* p = it;
+                CHECK(voc.decode(p) == c);
+                ++found;
+            }
+            CHECK(found == expected);
+        }
+    }
+}
+
+}
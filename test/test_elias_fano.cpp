@@ -0,0 +1,103 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/elias_fano.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+void test_elias_fano(std::vector<uint64_t> const& values, uint64_t universe) {
+    EliasFano ef(values.begin(), values.end(), universe);
+    REQUIRE(ef.size() == values.size());
+    CHECK(ef.universe() == universe);
+
+    for(size_t i = 0; i < values.size(); i++) CHECK(ef[i] == values[i]);
+
+    std::mt19937_64 gen(universe);
+    for(size_t i = 0; i < 1'000; i++) {
+        auto const x = universe ? gen() % (universe + 1) : 0;
+        auto const expected = (size_t)(std::lower_bound(values.begin(), values.end(), x) - values.begin());
+        CHECK(ef.lower_bound(x) == expected);
+    }
+}
+
+TEST_SUITE("code::EliasFano") {
+    TEST_CASE("empty") {
+        test_elias_fano({}, 0);
+        test_elias_fano({}, 1'000);
+    }
+
+    TEST_CASE("small") {
+        test_elias_fano({0}, 0);
+        test_elias_fano({5}, 5);
+        test_elias_fano({0, 0, 0, 1, 1, 7, 7, 8}, 8);
+        test_elias_fano({3, 9, 27, 81, 243}, 1'000);
+    }
+
+    TEST_CASE("random") {
+        std::mt19937_64 gen(92);
+        for(uint64_t const universe : {uint64_t(1'000), uint64_t(1'000'000), uint64_t(1) << 40}) {
+            for(size_t const n : {10, 1'000, 10'000}) {
+                std::vector<uint64_t> values;
+                for(size_t i = 0; i < n; i++) values.push_back(gen() % (universe + 1));
+                std::sort(values.begin(), values.end());
+                test_elias_fano(values, universe);
+            }
+        }
+    }
+
+    TEST_CASE("dense") {
+        // nb: long runs of set and unset bits span many select samples
+        test_elias_fano(std::vector<uint64_t>(1'000, 7), 7);
+        test_elias_fano(std::vector<uint64_t>(1'000, 0), 100'000);
+
+        std::vector<uint64_t> values;
+        for(uint64_t x = 0; x < 10'000; x++) values.push_back(x);
+        test_elias_fano(values, values.back());
+    }
+
+    TEST_CASE("compression") {
+        std::mt19937_64 gen(93);
+        uint64_t const universe = 100'000'000;
+        size_t const n = 100'000;
+
+        std::vector<uint64_t> values;
+        for(size_t i = 0; i < n; i++) values.push_back(gen() % (universe + 1));
+        std::sort(values.begin(), values.end());
+
+        EliasFano ef(values.begin(), values.end(), universe);
+        CHECK(ef.size_in_bits() < 16 * n); // nb: 2 + log2(1000) < 12 bits per integer plus overhead
+    }
+}
+
+}
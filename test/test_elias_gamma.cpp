@@ -31,6 +31,9 @@
 #include <code/elias_gamma.hpp>
 #include "helpers.hpp"
 
+#include <random>
+#include <vector>
+
 namespace code::test {
 
 TEST_SUITE("code::EliasGamma") {
@@ -65,6 +68,28 @@ TEST_SUITE("code::EliasGamma") {
         { SimpleUint64BitSource src(0b1111'01111); CHECK(EliasGamma::decode(src) == 31); }
         // ...
     }
+
+    TEST_CASE("encode_bulk") {
+        std::vector<uint64_t> values;
+        for(uint64_t x = 1; x < 1'000; x++) values.push_back(x);
+
+        std::mt19937_64 gen(147);
+        for(size_t i = 0; i < 10'000; i++) values.push_back(std::max(uint64_t(1), gen() >> (gen() % 64)));
+        for(size_t k = 1; k < 64; k++) values.push_back(uint64_t(1) << k);
+        values.push_back(UINT64_MAX);
+        std::vector<uint32_t> values32;
+        for(auto const x : values) values32.push_back(std::max(uint32_t(1), uint32_t(x)));
+
+        BitVectorSink expected, expected32;
+        for(auto const x : values) EliasGamma::encode(expected, x);
+        for(auto const x : values32) EliasGamma::encode(expected32, x);
+
+        BitVectorSink bulk, bulk32;
+        EliasGamma::encode_bulk(bulk, values.data(), values.size());
+        EliasGamma::encode_bulk(bulk32, values32.data(), values32.size());
+        CHECK(bulk.bits == expected.bits);
+        CHECK(bulk32.bits == expected32.bits);
+    }
 }
 
 }
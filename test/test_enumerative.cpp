@@ -0,0 +1,151 @@
+/**
+ * test_enumerative.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/enumerative.hpp>
+#include <code/internal/bit_buffer.hpp>
+
+#include <bit>
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+template<size_t N>
+void test_table() {
+    for(uint64_t x = 0; x < (uint64_t(1) << N); x++) {
+        auto const k = (size_t)std::popcount(x);
+        REQUIRE(Enumerative::unrank<N>(Enumerative::rank(x), k) == x);
+    }
+}
+
+template<size_t N>
+void test_bulk(uint64_t const seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<uint64_t> patterns;
+    for(size_t i = 0; i < 10'000; i++) {
+        // nb: draw the class uniformly so that sparse and dense patterns occur
+        auto const k = gen() % (N + 1);
+        uint64_t x = 0;
+        while((size_t)std::popcount(x) < k) x |= uint64_t(1) << (gen() % N);
+        patterns.push_back(x);
+    }
+
+    std::vector<uint64_t> words;
+    {
+        internal::BitBufferSink sink(words);
+        for(auto const x : patterns) Enumerative::encode(sink, x, N);
+    }
+
+    std::vector<uint64_t> decoded(patterns.size());
+    internal::BitBufferSource src(words.data());
+    Enumerative::decode_bulk<N>(src, decoded.data(), decoded.size());
+    CHECK(decoded == patterns);
+
+    internal::BitBufferSource src2(words.data());
+    for(auto const x : patterns) CHECK(Enumerative::decode(src2, N) == x);
+    CHECK(src2.pos() == src.pos());
+}
+
+TEST_SUITE("code::Enumerative") {
+    TEST_CASE("rank") {
+        // the offsets of the patterns of each class are exactly [0, binomial(n, k))
+        for(size_t n = 1; n <= 12; n++) {
+            std::vector<std::vector<bool>> seen(n + 1);
+            for(size_t k = 0; k <= n; k++) seen[k].resize(Enumerative::num_patterns(n, k), false);
+
+            for(uint64_t x = 0; x < (uint64_t(1) << n); x++) {
+                auto const k = (size_t)std::popcount(x);
+                auto const offset = Enumerative::rank(x);
+                REQUIRE(offset < seen[k].size());
+                CHECK(!seen[k][offset]);
+                seen[k][offset] = true;
+                CHECK(Enumerative::unrank(offset, n, k) == x);
+            }
+        }
+    }
+
+    TEST_CASE("offset_bits") {
+        CHECK(Enumerative::offset_bits(15, 0) == 0);
+        CHECK(Enumerative::offset_bits(15, 15) == 0);
+        CHECK(Enumerative::offset_bits(15, 1) == 4);
+        CHECK(Enumerative::offset_bits(15, 7) == 13); // nb: binomial(15, 7) = 6435
+        CHECK(Enumerative::offset_bits(63, 31) == 60);
+    }
+
+    TEST_CASE("table") {
+        test_table<1>();
+        test_table<7>();
+        test_table<15>();
+        test_table<16>();
+    }
+
+    TEST_CASE("unrank") {
+        std::mt19937_64 gen(99);
+        for(size_t n : {31, 40, 63}) {
+            for(size_t i = 0; i < 10'000; i++) {
+                auto const x = gen() & ((uint64_t(1) << n) - 1);
+                auto const k = (size_t)std::popcount(x);
+                CHECK(Enumerative::unrank(Enumerative::rank(x), n, k) == x);
+            }
+        }
+        CHECK(Enumerative::unrank<63>(Enumerative::num_patterns(63, 62) - 1, 62) == (UINT64_MAX >> 1) - 1); // nb: the largest pattern lacks only the lowest bit
+    }
+
+    TEST_CASE("bulk") {
+        test_bulk<15>(15);
+        test_bulk<31>(31);
+        test_bulk<63>(63);
+    }
+
+    TEST_CASE("subset") {
+        Universe const u(100, 130);
+        std::vector<uintmax_t> const subsets[] = { {}, { 100 }, { 130 }, { 101, 105, 117, 129 } };
+
+        std::vector<uint64_t> words;
+        size_t num_bits;
+        {
+            internal::BitBufferSink sink(words);
+            for(auto const& s : subsets) Enumerative::encode_subset(sink, s.begin(), s.end(), u);
+            num_bits = sink.num_bits_written();
+        }
+
+        // nb: each subset takes 5 bits for its class and ceil(log2(binomial(31, k))) bits for its offset
+        CHECK(num_bits == 4 * 5 + 0 + 5 + 5 + Enumerative::offset_bits(31, 4));
+
+        internal::BitBufferSource src(words.data());
+        for(auto const& s : subsets) {
+            std::vector<uintmax_t> decoded;
+            Enumerative::decode_subset(src, std::back_inserter(decoded), u);
+            CHECK(decoded == s);
+        }
+    }
+}
+
+}
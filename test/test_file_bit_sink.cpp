@@ -0,0 +1,201 @@
+/**
+ * test_file_bit_sink.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/elias_gamma.hpp>
+#include <code/file_bit_sink.hpp>
+#include <code/file_bit_source.hpp>
+#include <code/huffman.hpp>
+#include <code/huffman_tree.hpp>
+#include <code/internal/bit_buffer.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace code::test {
+
+static_assert(BitSink<FileBitSink>);
+
+struct TempPath {
+    std::string path;
+
+    TempPath(char const* name) {
+        path = (std::filesystem::temp_directory_path() / name).string();
+        std::remove(path.c_str());
+    }
+
+    ~TempPath() {
+        std::remove(path.c_str());
+    }
+};
+
+TEST_SUITE("code::FileBitSink") {
+    TEST_CASE("missing") {
+        FileBitSink sink("/nonexistent/code-test-file", FileBitSinkOptions { .append = true });
+        CHECK(!sink.is_open());
+    }
+
+    TEST_CASE("too_short") {
+        TempPath file("code-test-file-bit-sink-short");
+        {
+            FileBitSink sink(file.path.c_str());
+            REQUIRE(sink.is_open());
+            sink.write(UINT64_MAX, 12);
+        }
+        CHECK(std::filesystem::file_size(file.path) == 2);
+        CHECK(FileBitSink(file.path.c_str(), FileBitSinkOptions { .append = true, .num_bits = 16 }).is_open());
+        CHECK(!FileBitSink(file.path.c_str(), FileBitSinkOptions { .append = true, .num_bits = 17 }).is_open());
+    }
+
+    TEST_CASE("append") {
+        // write random bits in batches, reopening the file for each batch
+        std::mt19937_64 gen(98);
+        TempPath file("code-test-file-bit-sink-append");
+
+        std::vector<uint64_t> expected_words;
+        internal::BitBufferSink expected(expected_words);
+
+        uint64_t num_bits = 0;
+        for(size_t batch = 0; batch < 50; batch++) {
+            // nb: use a tiny buffer so that it is drained within a batch
+            FileBitSink sink(file.path.c_str(), FileBitSinkOptions { .append = batch > 0, .num_bits = num_bits, .buffer_size = 64 });
+            REQUIRE(sink.is_open());
+            CHECK(sink.num_bits_written() == num_bits);
+
+            auto const num = gen() % 200;
+            for(size_t i = 0; i < num; i++) {
+                auto const bits = gen();
+                auto const w = gen() % 65;
+                sink.write(bits, w);
+                expected.write(bits, w);
+            }
+            num_bits = sink.num_bits_written();
+            CHECK(num_bits == expected.num_bits_written());
+            CHECK(!sink.error());
+        }
+        CHECK(std::filesystem::file_size(file.path) == (num_bits + 7) / 8);
+
+        FileBitSource src(file.path.c_str(), FileBitSourceOptions { .block_size = 4096 });
+        internal::BitBufferSource expected_src(expected_words.data());
+        for(uint64_t pos = 0; pos < num_bits; pos += 64) {
+            auto const num = std::min(uint64_t(64), num_bits - pos);
+            CHECK(src.read(num) == expected_src.read(num));
+        }
+        CHECK(!src.error());
+    }
+
+    TEST_CASE("overwrite_tail") {
+        // appending truncates whatever follows the stream, e.g., data written after the stream's length was last recorded
+        TempPath file("code-test-file-bit-sink-tail");
+        {
+            FileBitSink sink(file.path.c_str());
+            sink.write(0b101, 3);
+            sink.write(UINT64_MAX, 64);
+        }
+        {
+            FileBitSink sink(file.path.c_str(), FileBitSinkOptions { .append = true, .num_bits = 3 });
+            sink.write(0b00, 2);
+        }
+        CHECK(std::filesystem::file_size(file.path) == 1);
+
+        FileBitSource src(file.path.c_str());
+        CHECK(src.read(8) == 0b00101);
+    }
+
+    TEST_CASE("huffman") {
+        // the stream begins with a Huffman tree that is reused for encoding each batch of appended characters
+        std::string_view const batches[] = {
+            "lorem ipsum dolor sit amet",
+            ", consectetur adipiscing elit",
+            ", sed do eiusmod tempor incididunt",
+            " ut labore et dolore magna aliqua"
+        };
+
+        std::string text;
+        for(auto const b : batches) text.append(b);
+
+        TempPath file("code-test-file-bit-sink-huffman");
+        uint64_t num_bits;
+        {
+            FileBitSink sink(file.path.c_str());
+            HuffmanTree<char> tree(text.begin(), text.end());
+            tree.encode(sink);
+            num_bits = sink.num_bits_written();
+        }
+
+        for(auto const b : batches) {
+            HuffmanTree<char> tree;
+            {
+                FileBitSource src(file.path.c_str());
+                tree = HuffmanTree<char>(src);
+            }
+
+            FileBitSink sink(file.path.c_str(), FileBitSinkOptions { .append = true, .num_bits = num_bits });
+            auto const table = tree.table();
+            for(char const c : b) Huffman::encode(sink, c, table);
+            num_bits = sink.num_bits_written();
+        }
+
+        FileBitSource src(file.path.c_str());
+        HuffmanTree<char> tree(src);
+        std::string decoded;
+        for(size_t i = 0; i < text.size(); i++) decoded.push_back((char)Huffman::decode(src, tree.root()));
+        CHECK(decoded == text);
+        CHECK(src.pos() == num_bits);
+    }
+}
+
+TEST_SUITE("code::internal::BitBufferSink") {
+    TEST_CASE("append") {
+        std::vector<uint64_t> values;
+        for(uint64_t x = 1; x <= 1000; x++) values.push_back(x * x);
+
+        std::vector<uint64_t> words;
+        size_t num_bits = 0;
+        for(size_t i = 0; i < values.size(); i += 100) {
+            words.push_back(UINT64_MAX); // nb: garbage after the stream, which is discarded
+            internal::BitBufferSink sink(words, num_bits);
+            for(size_t j = i; j < i + 100; j++) EliasGamma::encode(sink, values[j]);
+            num_bits = sink.num_bits_written();
+        }
+        CHECK(words.size() == (num_bits + 63) / 64 + 1); // nb: including the padding word
+        CHECK(words.back() == 0);
+
+        internal::BitBufferSource src(words.data());
+        for(auto const x : values) CHECK(EliasGamma::decode(src) == x);
+        CHECK(src.pos() == num_bits);
+    }
+
+}
+
+}
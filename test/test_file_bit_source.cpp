@@ -0,0 +1,165 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/elias_gamma.hpp>
+#include <code/file_bit_source.hpp>
+#include <code/internal/bit_buffer.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+static_assert(PeekableBitSource<FileBitSource>);
+static_assert(SeekableBitSource<FileBitSource>);
+
+struct TempFile {
+    std::string path;
+
+    TempFile(std::vector<uint64_t> const& words, size_t const num_bytes) {
+        path = (std::filesystem::temp_directory_path() / ("code-test-file-bit-source-" + std::to_string(num_bytes))).string();
+        std::ofstream out(path, std::ios::binary);
+        out.write((char const*)words.data(), num_bytes); // nb: assuming little endian
+    }
+
+    ~TempFile() {
+        std::remove(path.c_str());
+    }
+};
+
+std::vector<FileBitSourceOptions> test_options() {
+    std::vector<FileBitSourceOptions> options;
+    for(auto const backend : {FileReadBackend::io_uring, FileReadBackend::threads}) {
+        for(bool const direct : {false, true}) {
+            for(size_t const depth : {1, 3, 8}) {
+                options.push_back(FileBitSourceOptions { .block_size = 4096, .queue_depth = depth, .direct = direct, .backend = backend, .num_threads = 2 });
+            }
+        }
+    }
+    return options;
+}
+
+TEST_SUITE("code::FileBitSource") {
+    TEST_CASE("missing") {
+        FileBitSource src("/nonexistent/code-test-file");
+        CHECK(!src.is_open());
+    }
+
+    TEST_CASE("empty") {
+        TempFile file({}, 0);
+        FileBitSource src(file.path.c_str());
+        REQUIRE(src.is_open());
+        CHECK(src.file_size() == 0);
+        CHECK(src.read() == false);
+        CHECK(src.read(64) == 0);
+        CHECK(!src.error());
+    }
+
+    TEST_CASE("raw") {
+        // random words, read using random widths
+        std::mt19937_64 gen(96);
+        std::vector<uint64_t> words;
+        for(size_t i = 0; i < 10'000; i++) words.push_back(gen());
+        size_t const num_bytes = 8 * words.size() - 3; // nb: not a multiple of the block size
+        TempFile file(words, num_bytes);
+
+        for(auto const& options : test_options()) {
+            FileBitSource src(file.path.c_str(), options);
+            REQUIRE(src.is_open());
+            CHECK(src.file_size() == num_bytes);
+
+            internal::BitBufferSource expected(words.data());
+            size_t pos = 0;
+            while(pos < 8 * num_bytes) {
+                auto const num = std::min(size_t(gen() % 65), 8 * num_bytes - pos);
+                if(num == 1) {
+                    CHECK(src.read() == expected.read());
+                } else {
+                    CHECK(src.peek(num) == expected.peek(num));
+                    CHECK(src.read(num) == expected.read(num));
+                }
+                pos += num;
+                CHECK(src.pos() == pos);
+            }
+            CHECK(src.read(64) == 0); // nb: beyond the end of the file
+            CHECK(!src.error());
+        }
+    }
+
+    TEST_CASE("seek") {
+        // random words, read at random positions
+        std::mt19937_64 gen(97);
+        std::vector<uint64_t> words;
+        for(size_t i = 0; i < 10'000; i++) words.push_back(gen());
+        size_t const num_bits = 64 * words.size();
+        TempFile file(words, 8 * words.size());
+
+        for(auto const& options : test_options()) {
+            FileBitSource src(file.path.c_str(), options);
+            REQUIRE(src.is_open());
+            for(size_t i = 0; i < 200; i++) {
+                // nb: alternate between short jumps within a block and arbitrary jumps
+                auto const pos = (i % 2) ? std::min(src.pos() + gen() % 1024, num_bits - 128) : gen() % (num_bits - 128);
+                src.seek(pos);
+                CHECK(src.pos() == pos);
+
+                internal::BitBufferSource expected(words.data(), pos);
+                CHECK(src.read(64) == expected.read(64));
+                CHECK(src.read(17) == expected.read(17));
+            }
+            CHECK(!src.error());
+        }
+    }
+
+    TEST_CASE("decode") {
+        std::mt19937_64 gen(97);
+        std::vector<uint64_t> values;
+        for(size_t i = 0; i < 50'000; i++) values.push_back(1 + (gen() >> (gen() % 63 + 1)));
+
+        std::vector<uint64_t> words;
+        internal::BitBufferSink sink(words);
+        for(auto const x : values) EliasGamma::encode(sink, x);
+        TempFile file(words, (sink.num_bits_written() + 7) / 8);
+
+        for(auto const& options : test_options()) {
+            FileBitSource src(file.path.c_str(), options);
+            REQUIRE(src.is_open());
+            if(options.backend == FileReadBackend::threads) CHECK(!src.uses_io_uring());
+            for(auto const x : values) CHECK(EliasGamma::decode(src) == x);
+            CHECK(!src.error());
+        }
+    }
+}
+
+}
@@ -0,0 +1,114 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/front_coded_dictionary.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+void test_front_coded_dictionary(std::vector<std::string> const& strings, size_t bucket_size, bool huffman) {
+    FrontCodedDictionary dict(strings.begin(), strings.end(), bucket_size, huffman);
+    REQUIRE(dict.size() == strings.size());
+
+    for(size_t i = 0; i < strings.size(); i++) {
+        CHECK(dict.extract(i) == strings[i]);
+        CHECK(dict.locate(strings[i]) == i);
+    }
+
+    // strings that are not contained
+    std::mt19937_64 gen(bucket_size);
+    for(size_t i = 0; i < std::min(strings.size(), size_t(1'000)); i++) {
+        auto s = strings[gen() % strings.size()];
+        s.push_back('\x7f');
+        if(!std::binary_search(strings.begin(), strings.end(), s)) CHECK(dict.locate(s) == dict.size());
+    }
+    CHECK(dict.locate("") == (strings.empty() || !strings[0].empty() ? dict.size() : 0));
+}
+
+// generates sorted strings with long common prefixes, like the terms of a dictionary or URLs
+std::vector<std::string> random_terms(size_t n, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<std::string> prefixes = { "", "http://www.", "inter", "pre", "com", "de", "un" };
+    std::vector<std::string> strings;
+    for(size_t i = 0; i < n; i++) {
+        auto s = prefixes[gen() % prefixes.size()];
+        auto const len = 1 + gen() % 12;
+        for(size_t j = 0; j < len; j++) s.push_back('a' + (char)(gen() % (j < 3 ? 4 : 26)));
+        strings.push_back(s);
+    }
+    std::sort(strings.begin(), strings.end());
+    strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+    return strings;
+}
+
+TEST_SUITE("code::FrontCodedDictionary") {
+    TEST_CASE("empty") {
+        FrontCodedDictionary dict;
+        CHECK(dict.size() == 0);
+        CHECK(dict.locate("abc") == 0);
+        test_front_coded_dictionary({}, 4, false);
+        test_front_coded_dictionary({}, 4, true);
+    }
+
+    TEST_CASE("small") {
+        std::vector<std::string> const strings = { "", "a", "aa", "aab", "ab", "abracadabra", "b", "banana", "bandana", "x" };
+        for(size_t const bucket_size : {1, 2, 3, 4, 16}) {
+            test_front_coded_dictionary(strings, bucket_size, false);
+            test_front_coded_dictionary(strings, bucket_size, true);
+        }
+        test_front_coded_dictionary({ "single" }, 4, true);
+        test_front_coded_dictionary({ "aaaa", "aaaaaaaa" }, 4, true); // nb: single-character alphabet
+    }
+
+    TEST_CASE("random") {
+        auto const strings = random_terms(20'000, 93);
+        for(size_t const bucket_size : {1, 8, 16, 64}) {
+            test_front_coded_dictionary(strings, bucket_size, false);
+            test_front_coded_dictionary(strings, bucket_size, true);
+        }
+    }
+
+    TEST_CASE("compression") {
+        auto const strings = random_terms(50'000, 94);
+        size_t total = 0;
+        for(auto const& s : strings) total += 8 * s.size();
+
+        FrontCodedDictionary plain(strings.begin(), strings.end(), 16, false);
+        FrontCodedDictionary huffman(strings.begin(), strings.end(), 16, true);
+        CHECK(plain.size_in_bits() < total);
+        CHECK(huffman.size_in_bits() < plain.size_in_bits());
+    }
+}
+
+}
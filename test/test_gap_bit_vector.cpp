@@ -0,0 +1,123 @@
+/**
+ * test_gap_bit_vector.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/gap_bit_vector.hpp>
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+void test_gap_bit_vector(std::vector<bool> const& bits, GapCoding coding, size_t sampling) {
+    std::vector<uint64_t> positions;
+    for(size_t i = 0; i < bits.size(); i++) {
+        if(bits[i]) positions.push_back(i);
+    }
+
+    GapBitVector bv(positions.begin(), positions.end(), bits.size(), coding, sampling);
+    REQUIRE(bv.size() == bits.size());
+    CHECK(bv.num_ones() == positions.size());
+    CHECK(bv.coding() == coding);
+
+    std::vector<uint64_t> decoded;
+    bv.positions(std::back_inserter(decoded));
+    CHECK(decoded == positions);
+
+    bool ok = true;
+    size_t ones = 0;
+    for(size_t i = 0; i < bits.size(); i++) {
+        ok = ok && bv[i] == bits[i] && bv.rank1(i) == ones && bv.rank0(i) == i - ones;
+        ones += bits[i];
+    }
+    ok = ok && bv.rank1(bits.size()) == ones;
+    CHECK(ok);
+
+    for(size_t k = 1; k <= positions.size(); k++) ok = ok && bv.select1(k) == positions[k - 1];
+    CHECK(ok);
+
+    size_t next = bits.size();
+    for(size_t i = bits.size(); i-- > 0;) {
+        if(bits[i]) next = i;
+        ok = ok && bv.next_set_bit(i) == next;
+    }
+    ok = ok && bv.next_set_bit(bits.size()) == bits.size();
+    CHECK(ok);
+}
+
+std::vector<bool> random_bits(size_t n, double density, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::bernoulli_distribution dist(density);
+    std::vector<bool> bits(n);
+    for(size_t i = 0; i < n; i++) bits[i] = dist(gen);
+    return bits;
+}
+
+TEST_SUITE("code::GapBitVector") {
+    TEST_CASE("queries") {
+        for(size_t n : {0, 1, 100, 20'000}) {
+            for(double density : {0.0, 0.001, 0.05, 0.5, 1.0}) {
+                auto const bits = random_bits(n, density, n + 1);
+                for(size_t sampling : {1, 2, 64}) {
+                    test_gap_bit_vector(bits, GapCoding::elias_delta, sampling);
+                    test_gap_bit_vector(bits, GapCoding::rice, sampling);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("rice_exponent") {
+        std::vector<uint64_t> positions;
+        for(uint64_t i = 0; i < 10'000; i++) positions.push_back(i * 1000);
+
+        GapBitVector bv(positions.begin(), positions.end(), positions.back() + 1, GapCoding::rice);
+        CHECK(bv.rice_exponent() == 10); // a gap of 1000 takes 11 bits (quotient zero), compared to 12 bits for an exponent of 9
+        CHECK(bv.size_in_bits() < 13 * positions.size());
+
+        GapBitVector delta(positions.begin(), positions.end(), positions.back() + 1, GapCoding::elias_delta);
+        CHECK(bv.size_in_bits() < delta.size_in_bits());
+
+        // nb: the mean gap must not overflow when estimating the exponent
+        std::vector<uint64_t> sparse;
+        for(uint64_t i = 0; i < 16; i++) sparse.push_back(i << 59);
+
+        GapBitVector large(sparse.begin(), sparse.end(), sparse.back() + 1, GapCoding::rice);
+        CHECK(large.rice_exponent() == 59); // a gap of 2^59 is encoded as 2^59 - 1, which takes 60 bits (quotient zero)
+    }
+
+    TEST_CASE("empty") {
+        GapBitVector bv;
+        CHECK(bv.size() == 0);
+        CHECK(bv.rank1(0) == 0);
+        CHECK(bv.next_set_bit(0) == 0);
+    }
+}
+
+}
@@ -0,0 +1,141 @@
+/**
+ * test_golomb_coded_set.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/golomb_coded_set.hpp>
+#include <code/internal/bit_buffer.hpp>
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::GolombCodedSet") {
+    TEST_CASE("membership") {
+        std::mt19937_64 gen(147);
+        std::vector<uint64_t> keys(20'000);
+        for(auto& k : keys) k = gen();
+
+        for(uint8_t p : {4, 8, 10}) {
+            for(size_t sampling : {1, 7, 64, 256}) {
+                GolombCodedSet<uint64_t> set(keys.begin(), keys.end(), p, sampling);
+                CHECK(set.p() == p);
+                CHECK(set.sampling() == sampling);
+
+                // no false negatives
+                bool all = true;
+                for(auto const k : keys) all = all && set.contains(k);
+                CHECK(all);
+
+                // false positive rate close to 2^-p
+                size_t const num_queries = 100'000;
+                size_t fp = 0;
+                for(size_t i = 0; i < num_queries; i++) fp += set.contains(gen());
+                CHECK(double(fp) / num_queries < 1.5 / double(uint64_t(1) << p));
+            }
+        }
+    }
+
+    TEST_CASE("size") {
+        std::vector<uint64_t> keys(100'000);
+        for(size_t i = 0; i < keys.size(); i++) keys[i] = i; // nb: consecutive integers, which std::hash does not spread
+
+        uint8_t const p = 10;
+        GolombCodedSet<uint64_t> set(keys.begin(), keys.end(), p, 128);
+        CHECK(set.size() > keys.size() - keys.size() / 500); // few hash collisions
+        CHECK(set.size_in_bits() < (p + 3) * keys.size());
+        CHECK(set.size_in_bits() < 1.44 * p * keys.size());
+    }
+
+    TEST_CASE("batch") {
+        std::mt19937_64 gen(147);
+        std::vector<uint64_t> keys(50'000);
+        for(auto& k : keys) k = gen();
+        GolombCodedSet<uint64_t> set(keys.begin(), keys.end(), 6, 32);
+
+        std::vector<uint64_t> queries;
+        for(size_t i = 0; i < 20'000; i++) queries.push_back(i % 2 ? keys[gen() % keys.size()] : gen());
+
+        std::vector<bool> batch;
+        set.contains(queries.begin(), queries.end(), std::back_inserter(batch));
+        REQUIRE(batch.size() == queries.size());
+
+        bool equal = true;
+        for(size_t i = 0; i < queries.size(); i++) equal = equal && (batch[i] == set.contains(queries[i]));
+        CHECK(equal);
+    }
+
+    TEST_CASE("strings") {
+        std::vector<std::string> words = { "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit" };
+        GolombCodedSet<std::string> set(words.begin(), words.end(), 16, 4);
+        for(auto const& w : words) CHECK(set.contains(w));
+        CHECK(!set.contains("sed"));
+        CHECK(!set.contains("eiusmod"));
+    }
+
+    TEST_CASE("empty") {
+        std::vector<uint64_t> keys;
+        GolombCodedSet<uint64_t> set(keys.begin(), keys.end(), 8);
+        CHECK(set.size() == 0);
+        CHECK(!set.contains(0));
+        CHECK(!set.contains(12345));
+
+        std::vector<bool> batch;
+        std::vector<uint64_t> queries = { 1, 2, 3 };
+        set.contains(queries.begin(), queries.end(), std::back_inserter(batch));
+        CHECK(batch == std::vector<bool>{ false, false, false });
+
+        GolombCodedSet<uint64_t> default_set;
+        CHECK(!default_set.contains(0));
+    }
+}
+
+TEST_SUITE("code::internal::BitBufferSource") {
+    TEST_CASE("padding") {
+        // nb: peeking beyond the end of the stream must stay within the vector
+        for(size_t num_bits = 0; num_bits <= 256; num_bits++) {
+            std::vector<uint64_t> words;
+            internal::BitBufferSink sink(words);
+            for(size_t i = 0; i < num_bits; i++) sink.write(bool(i % 3));
+            CHECK(words.size() == (num_bits + 63) / 64 + 1);
+
+            for(size_t pos = 0; pos <= num_bits; pos++) {
+                internal::BitBufferSource src(words.data(), pos);
+                auto const bits = src.peek(64);
+                for(size_t i = 0; i < 64; i++) {
+                    CHECK(((bits >> i) & 1) == (pos + i < num_bits && (pos + i) % 3));
+                }
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,136 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/gorilla.hpp>
+#include <code/internal/bit_buffer.hpp>
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+size_t test_gorilla(std::vector<GorillaPoint> const& points) {
+    std::vector<uint64_t> buffer;
+    internal::BitBufferSink sink(buffer);
+    {
+        Gorilla gorilla;
+        for(auto const& p : points) gorilla.encode(sink, p);
+    }
+
+    internal::BitBufferSource src(buffer.data());
+    Gorilla gorilla;
+    for(auto const& p : points) {
+        auto const q = gorilla.decode(src);
+        CHECK(q.timestamp == p.timestamp);
+        CHECK(std::bit_cast<uint64_t>(q.value) == std::bit_cast<uint64_t>(p.value)); // nb: compare bits because of NaN
+    }
+    CHECK(src.pos() == sink.num_bits_written());
+    return sink.num_bits_written();
+}
+
+TEST_SUITE("code::Gorilla") {
+    TEST_CASE("encode") {
+        std::vector<uint64_t> buffer;
+        internal::BitBufferSink sink(buffer);
+        Gorilla gorilla;
+
+        gorilla.encode(sink, 1000, 12.0);
+        CHECK(sink.num_bits_written() == 128); // first point verbatim
+
+        gorilla.encode(sink, 1060, 12.0); // delta 60 in the 7-bit bucket, repeated value
+        CHECK(sink.num_bits_written() == 128 + 2 + 7 + 1);
+
+        gorilla.encode(sink, 1120, 12.0); // delta-of-delta zero, repeated value
+        CHECK(sink.num_bits_written() == 128 + 10 + 1 + 1);
+
+        gorilla.encode(sink, 1180, 24.0); // XOR with a single meaningful bit
+        CHECK(sink.num_bits_written() == 128 + 10 + 2 + 1 + 2 + 5 + 6 + 1);
+
+        gorilla.encode(sink, 1240, 12.0); // same XOR, reuse window
+        CHECK(sink.num_bits_written() == 128 + 10 + 2 + 15 + 1 + 2 + 1);
+
+        gorilla.encode(sink, 1240 + 60 + 300, 12.0); // delta-of-delta 300 in the 12-bit bucket
+        CHECK(sink.num_bits_written() == 128 + 10 + 2 + 15 + 4 + 4 + 12 + 1);
+    }
+
+    TEST_CASE("roundtrip") {
+        test_gorilla({});
+        test_gorilla({{ 5, 1.5 }});
+        test_gorilla({{ 0, 0.0 }, { 0, -0.0 }, { 0, 0.0 }});
+
+        // special values and extreme timestamps
+        auto const inf = std::numeric_limits<double>::infinity();
+        auto const nan = std::numeric_limits<double>::quiet_NaN();
+        test_gorilla({
+            { INT64_MIN, 1.0 }, { INT64_MAX, inf }, { 0, -inf }, { -1, nan }, { INT64_MIN, std::numeric_limits<double>::denorm_min() },
+            { 100, std::numeric_limits<double>::max() }, { 163, std::numeric_limits<double>::lowest() }, { 226, 0.0 }, { 226, 0.0 }
+        });
+
+        // delta-of-delta at all bucket boundaries
+        std::vector<GorillaPoint> points;
+        int64_t t = 0, delta = 0;
+        points.push_back({ t, 0.0 });
+        for(int64_t const dod : {-63, 64, -64, 65, -255, 256, -256, 257, -2047, 2048, -2048, 2049, 0, 1, -1}) {
+            delta += dod;
+            t += delta;
+            points.push_back({ t, double(dod) });
+        }
+        test_gorilla(points);
+
+        // random
+        std::mt19937_64 gen(94);
+        points.clear();
+        for(size_t i = 0; i < 100'000; i++) {
+            points.push_back({ (int64_t)gen(), std::bit_cast<double>(gen()) });
+        }
+        test_gorilla(points);
+    }
+
+    TEST_CASE("compression") {
+        // a typical metric: regular timestamps with occasional jitter and a slowly changing value
+        std::mt19937_64 gen(95);
+        std::vector<GorillaPoint> points;
+        int64_t t = 1'700'000'000;
+        double v = 100.0;
+        for(size_t i = 0; i < 100'000; i++) {
+            t += 60 + (gen() % 10 == 0 ? int64_t(gen() % 5) - 2 : 0);
+            if(gen() % 4 == 0) v += double(int64_t(gen() % 21) - 10) * 0.5;
+            points.push_back({ t, v });
+        }
+
+        auto const bits = test_gorilla(points);
+        CHECK(bits < 16 * points.size()); // much less than the 128 bits per point of the raw data
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+/**
+ * test_group_varint.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/group_varint.hpp>
+
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::GroupVarint") {
+    TEST_CASE("layout") {
+        uint32_t const in[] = { 1, 0x1234, 0x56789A, 0xDEADBEEF, 0, 300 };
+        uint8_t buf[GroupVarint::max_size(6)];
+        auto const end = GroupVarint::encode(buf, in, 6);
+
+        std::vector<uint8_t> const expected = {
+            0b11'10'01'00, 0x01, 0x34, 0x12, 0x9A, 0x78, 0x56, 0xEF, 0xBE, 0xAD, 0xDE,
+            0b00'00'01'00, 0x00, 0x2C, 0x01, 0x00, 0x00,
+        };
+        CHECK(std::vector<uint8_t>(buf, end) == expected);
+        CHECK(GroupVarint::size(buf, 6) == expected.size());
+
+        uint32_t out[6];
+        CHECK(GroupVarint::decode(buf, out, 6) == end);
+        CHECK(std::equal(in, in + 6, out));
+    }
+
+    TEST_CASE("roundtrip") {
+        std::mt19937 gen(147);
+        for(size_t num : {0, 1, 2, 3, 4, 5, 11, 12, 13, 15, 16, 17, 100, 1000, 10'001}) {
+            std::vector<uint32_t> in(num);
+            for(auto& x : in) x = gen() >> (gen() % 32); // nb: mix of byte lengths
+
+            // use an exactly-sized buffer so out-of-bounds reads are detected by sanitizers
+            std::vector<uint8_t> tmp(GroupVarint::max_size(num));
+            auto const size = GroupVarint::encode(tmp.data(), in.data(), num) - tmp.data();
+            std::vector<uint8_t> buf(tmp.begin(), tmp.begin() + size);
+            CHECK(GroupVarint::size(buf.data(), num) == size_t(size));
+
+            std::vector<uint32_t> out(num);
+            CHECK(GroupVarint::decode(buf.data(), out.data(), num) == buf.data() + size);
+            CHECK(out == in);
+        }
+    }
+
+    TEST_CASE("small") {
+        // all groups have minimum size, which is the tightest case for the vectorized decoder
+        std::vector<uint32_t> in(37);
+        for(size_t i = 0; i < in.size(); i++) in[i] = i % 256;
+
+        std::vector<uint8_t> buf(GroupVarint::max_size(in.size()));
+        auto const size = GroupVarint::encode(buf.data(), in.data(), in.size()) - buf.data();
+        CHECK(size_t(size) == 10 * 5);
+        buf.resize(size);
+        buf.shrink_to_fit();
+
+        std::vector<uint32_t> out(in.size());
+        GroupVarint::decode(buf.data(), out.data(), in.size());
+        CHECK(out == in);
+    }
+}
+
+}
@@ -28,6 +28,7 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
+#include <code/alphabetic_tree.hpp>
 #include <code/huffman.hpp>
 #include <iopp/util/bit_packer.hpp>
 #include <iopp/util/bit_unpacker.hpp>
@@ -166,6 +167,193 @@ TEST_SUITE("code::Huffman") {
             CHECK(decoded == lorem_ipsum);
         }
     }
+
+    TEST_CASE("packed_table") {
+        // a 16-bit input over the alphabet [1000, 1099] with a skewed distribution
+        std::vector<uint16_t> input;
+        for(uint16_t c = 0; c < 100; c++) {
+            for(size_t i = 0; i <= c; i++) input.push_back(1000 + (c * 37) % 100);
+        }
+
+        HuffmanTree<uint16_t> tree(input.begin(), input.end());
+        auto const table = tree.packed_table();
+        CHECK(table.min() == 1000);
+        CHECK(table.size() == 100);
+        CHECK(!table.has_long_codes());
+        for(auto const c : input) CHECK(table[c] == tree[c]);
+
+        // the default table for 16-bit characters should be packed as well
+        auto const default_table = tree.table();
+        static_assert(std::same_as<std::remove_cvref_t<decltype(default_table)>, HuffmanPackedTable>);
+        for(auto const c : input) CHECK(default_table[c] == tree[c]);
+
+        // copies share the same entries
+        auto const copy = table;
+        CHECK(copy.data() == table.data());
+
+        // roundtrip
+        uintmax_t out[2048]; // "large enough"
+        {
+            auto sink = iopp::BitPacker(out);
+            tree.encode(sink);
+            for(auto const c : input) Huffman::encode(sink, c, table);
+        }
+        {
+            auto src = iopp::BitUnpacker(out);
+            HuffmanTree<uint16_t> decoded_tree(src);
+            bool all_equal = true;
+            for(auto const c : input) all_equal = all_equal && (Huffman::decode(src, decoded_tree.root()) == c);
+            CHECK(all_equal);
+        }
+    }
+
+    TEST_CASE("encode_bulk") {
+        auto check_bulk = [](auto const& tree, auto const& input){
+            auto const table = tree.packed_table();
+
+            std::vector<uintmax_t> expected(input.size()), actual(input.size()); // "large enough"
+            {
+                auto sink = iopp::BitPacker(expected.data());
+                for(auto const c : input) Huffman::encode(sink, c, table);
+            }
+            {
+                auto sink = iopp::BitPacker(actual.data());
+                Huffman::encode_bulk(sink, input.data(), input.size(), table);
+            }
+            CHECK(expected == actual);
+        };
+
+        SUBCASE("8-bit") {
+            HuffmanTree<char> tree(lorem_ipsum.begin(), lorem_ipsum.end());
+            check_bulk(tree, lorem_ipsum);
+        }
+        SUBCASE("16-bit") {
+            std::vector<uint16_t> input;
+            for(size_t i = 0; i < 1000; i++) input.push_back(4000 + (i * i) % 333);
+            HuffmanTree<uint16_t> tree(input.begin(), input.end());
+            check_bulk(tree, input);
+        }
+        SUBCASE("32-bit") {
+            std::vector<uint32_t> input;
+            for(size_t i = 0; i < 1000; i++) input.push_back(1'000'000 + (i * 7) % 41);
+            HuffmanTree<uint32_t> tree(input.begin(), input.end());
+            check_bulk(tree, input);
+        }
+        SUBCASE("long codes") {
+            // Fibonacci frequencies produce long codewords, which require the scalar fallback
+            Counter<uint16_t> histogram;
+            size_t f0 = 1, f1 = 1;
+            for(uint16_t c = 0; c < 32; c++) {
+                histogram.set(c, f0);
+                auto const f2 = f0 + f1;
+                f0 = f1;
+                f1 = f2;
+            }
+            HuffmanTree<uint16_t> tree(histogram);
+
+            std::vector<uint16_t> input;
+            for(size_t i = 0; i < 1000; i++) input.push_back(31 - (i * i) % 32);
+            check_bulk(tree, input);
+        }
+    }
+
+    TEST_CASE("packed_table_long_codes") {
+        // Fibonacci frequencies lead to a degenerate Huffman tree with codewords exceeding the packed entry width
+        Counter<uint16_t> histogram;
+        size_t f0 = 1, f1 = 1;
+        for(uint16_t c = 0; c < 32; c++) {
+            histogram.set(c, f0);
+            auto const f2 = f0 + f1;
+            f0 = f1;
+            f1 = f2;
+        }
+
+        HuffmanTree<uint16_t> tree(histogram);
+        auto const table = tree.packed_table();
+        CHECK(table.has_long_codes());
+        for(uint16_t c = 0; c < 32; c++) CHECK(table[c] == tree[c]);
+    }
+
+    TEST_CASE("AlphabeticTree") {
+        // cost of an optimal alphabetic tree for the given weights, computed naively
+        auto optimal_cost = [](std::vector<size_t> const& w){
+            auto const n = w.size();
+            std::vector<std::vector<size_t>> cost(n, std::vector<size_t>(n, 0));
+            std::vector<size_t> prefix(n + 1, 0);
+            for(size_t i = 0; i < n; i++) prefix[i + 1] = prefix[i] + w[i];
+            for(size_t len = 2; len <= n; len++) {
+                for(size_t i = 0; i + len <= n; i++) {
+                    auto const j = i + len - 1;
+                    auto best = SIZE_MAX;
+                    for(size_t k = i; k < j; k++) best = std::min(best, cost[i][k] + cost[k + 1][j]);
+                    cost[i][j] = best + prefix[j + 1] - prefix[i];
+                }
+            }
+            return cost[0][n - 1];
+        };
+
+        auto check = [&](std::vector<size_t> const& w){
+            Counter<uint16_t> histogram;
+            for(size_t i = 0; i < w.size(); i++) histogram.set(uint16_t(100 + 3 * i), w[i]);
+
+            AlphabeticTree<uint16_t> tree(histogram);
+            CHECK(tree.size() == 2 * w.size() - 1);
+
+            size_t cost = 0;
+            for(size_t i = 0; i < w.size(); i++) cost += w[i] * tree[uint16_t(100 + 3 * i)].length;
+            CHECK(cost == optimal_cost(w));
+
+            // codewords must be ordered lexicographically (nb: LSBF)
+            auto reversed = [](HuffmanCode const& code){
+                uintmax_t r = 0;
+                for(size_t i = 0; i < code.length; i++) r |= ((code.word >> i) & 1) << (63 - i);
+                return r;
+            };
+            for(size_t i = 1; i < w.size(); i++) {
+                CHECK(reversed(tree[uint16_t(100 + 3 * (i - 1))]) < reversed(tree[uint16_t(100 + 3 * i)]));
+            }
+        };
+
+        check({1, 1});
+        check({5, 1, 5});
+        check({1, 2, 3, 4, 5, 6, 7, 8});
+        check({8, 7, 6, 5, 4, 3, 2, 1});
+        check({10, 1, 1, 10, 1, 1, 10});
+        check({3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3});
+        check({1, 0, 0, 7, 2, 0, 9, 1, 1, 13, 4, 4, 2});
+        check({34, 21, 13, 8, 5, 3, 2, 1, 1, 1, 2, 3, 5, 8, 13, 21, 34});
+        for(size_t seed = 1; seed <= 20; seed++) {
+            std::vector<size_t> w;
+            size_t x = seed;
+            for(size_t i = 0; i < 5 + seed; i++) {
+                x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+                w.push_back((x >> 33) % 50);
+            }
+            check(w);
+        }
+
+        // roundtrip lorem ipsum
+        uintmax_t out[800]; // "large enough"
+        {
+            AlphabeticTree<char> tree(lorem_ipsum.begin(), lorem_ipsum.end());
+            auto sink = iopp::BitPacker(out);
+            tree.encode(sink);
+
+            auto table = tree.table();
+            for(char const c : lorem_ipsum) Huffman::encode(sink, c, table);
+        }
+        {
+            std::string decoded;
+            decoded.reserve(lorem_ipsum.length());
+
+            auto src = iopp::BitUnpacker(out);
+            AlphabeticTree<char> tree(src);
+            for(size_t i = 0; i < lorem_ipsum.length(); i++) {
+                decoded.push_back((char)Huffman::decode(src, tree.root()));
+            }
+            CHECK(decoded == lorem_ipsum);
+        }
+    }
 }
 
 }
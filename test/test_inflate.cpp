@@ -0,0 +1,547 @@
+/**
+ * test_inflate.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/canonical_huffman.hpp>
+#include <code/inflate.hpp>
+
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::CanonicalHuffman") {
+    TEST_CASE("codes") {
+        // example from RFC 1951, section 3.2.2
+        uint8_t const lengths[] = { 3, 3, 3, 3, 3, 2, 4, 4 };
+        auto const codes = CanonicalHuffman::codes(lengths, lengths + 8);
+        REQUIRE(codes.size() == 8);
+
+        // nb: LSBF
+        CHECK(codes[0] == HuffmanCode{0b010U, 3});
+        CHECK(codes[1] == HuffmanCode{0b110U, 3});
+        CHECK(codes[2] == HuffmanCode{0b001U, 3});
+        CHECK(codes[3] == HuffmanCode{0b101U, 3});
+        CHECK(codes[4] == HuffmanCode{0b011U, 3});
+        CHECK(codes[5] == HuffmanCode{0b00U, 2});
+        CHECK(codes[6] == HuffmanCode{0b0111U, 4});
+        CHECK(codes[7] == HuffmanCode{0b1111U, 4});
+    }
+
+    TEST_CASE("decoder") {
+        // a degenerate code with long codewords that need secondary tables
+        std::vector<uint8_t> lengths;
+        for(uint8_t i = 1; i <= 14; i++) lengths.push_back(i);
+        lengths.push_back(14);
+        lengths.push_back(0);
+        auto const codes = CanonicalHuffman::codes(lengths.begin(), lengths.end());
+
+        for(size_t primary_bits : { 1, 4, 9, 14 }) {
+            CanonicalHuffmanDecoder decoder(lengths.begin(), lengths.end(), primary_bits);
+            CHECK(decoder.valid());
+            CHECK(decoder.complete());
+            CHECK(decoder.max_length() == 14);
+            for(uint32_t c = 0; c < lengths.size(); c++) {
+                if(!lengths[c]) continue;
+                auto const [sym, len] = decoder.lookup(codes[c].word | (uintmax_t(0b1011) << codes[c].length)); // nb: trailing garbage
+                CHECK(len == codes[c].length);
+                CHECK(sym == c);
+            }
+        }
+
+        // an over-subscribed code
+        uint8_t const over[] = { 1, 1, 1 };
+        CHECK(!CanonicalHuffmanDecoder(over, over + 3).valid());
+
+        // an incomplete code
+        uint8_t const incomplete[] = { 1, 0, 2 };
+        CanonicalHuffmanDecoder decoder(incomplete, incomplete + 3);
+        CHECK(decoder.valid());
+        CHECK(!decoder.complete());
+        CHECK(decoder.lookup(0b00).second == 1);
+        CHECK(decoder.lookup(0b01).second == 2);
+        CHECK(decoder.lookup(0b11).second == 0);
+    }
+}
+
+TEST_SUITE("code::Inflate") {
+    // the test vectors below have been generated using zlib
+    std::string make_text() {
+        static char const* words[] = {
+            "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "vivamus", "aliquet", "in", "turpis", "vitae",
+            "mattis", "etiam", "nunc", "nibh", "ornare", "tincidunt", "quis", "iaculis", "eget", "orci", "morbi", "viverra", "maximus",
+            "quam", "vel", "feugiat"
+        };
+
+        std::string text;
+        uint64_t x = 1;
+        for(size_t i = 0; i < 600; i++) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            if(i) text.push_back(' ');
+            text.append(words[(x >> 33) % 29]);
+        }
+        return text;
+    }
+
+    std::string make_runs() {
+        std::string runs(1000, 'a');
+        for(size_t i = 0; i < 300; i++) runs.append("ab");
+        for(size_t k = 0; k < 2; k++) {
+            for(size_t i = 0; i < 256; i++) runs.push_back(char(i));
+        }
+        return runs;
+    }
+
+    uint8_t const DYNAMIC[] = {
+        0x75, 0x57, 0xED, 0x92, 0xDB, 0x30, 0x08, 0x7C, 0x15, 0xBF, 0x9A, 0xCE, 0xE7, 0xA6, 0x9A, 0x89,
+        0x95, 0x4B, 0x62, 0x67, 0xFA, 0xF8, 0x95, 0x96, 0xAF, 0x45, 0xC9, 0xFD, 0x68, 0x7A, 0x96, 0x01,
+        0xC1, 0x02, 0x0B, 0x2E, 0xFB, 0x76, 0x2C, 0xEB, 0xAD, 0x3D, 0xB7, 0xF5, 0xD8, 0x8E, 0xF3, 0xB1,
+        0xF4, 0x7F, 0x3F, 0xF5, 0xB9, 0xBC, 0xEA, 0xAB, 0xEC, 0xE7, 0x73, 0xB9, 0x3D, 0xD6, 0xBA, 0x94,
+        0xEF, 0xDA, 0xCF, 0xD6, 0xDA, 0x2E, 0xFC, 0xE7, 0x6B, 0xBB, 0x2E, 0xDB, 0xA5, 0xAB, 0x87, 0xCA,
+        0xF6, 0x78, 0x14, 0x9C, 0x43, 0x6D, 0x2F, 0xFF, 0xEA, 0xB0, 0xE1, 0x82, 0xD7, 0xDB, 0x63, 0xDB,
+        0x97, 0x67, 0xED, 0x2A, 0xB5, 0xAD, 0xF5, 0xFB, 0x6C, 0x47, 0x17, 0x3A, 0x8E, 0xAE, 0x5C, 0x9B,
+        0xE8, 0xD4, 0x9F, 0xE7, 0xB9, 0x2F, 0xDB, 0xB5, 0x9A, 0x74, 0xB9, 0xD6, 0xFB, 0xD9, 0x75, 0x5F,
+        0xF5, 0x28, 0xDB, 0x52, 0x76, 0x37, 0xA3, 0x8A, 0xEC, 0xC1, 0xE4, 0xC8, 0xB8, 0x08, 0x96, 0xFE,
+        0x6C, 0xE7, 0xA5, 0x96, 0x63, 0xB2, 0x85, 0xFB, 0x86, 0x0C, 0xFB, 0xC9, 0xF1, 0x91, 0x19, 0xB9,
+        0xF2, 0x7E, 0x96, 0x5D, 0x95, 0x4D, 0xC7, 0x4D, 0x0F, 0xC7, 0xBE, 0x6F, 0x5D, 0xAE, 0xDB, 0x6D,
+        0xE5, 0xB1, 0x2D, 0xED, 0x6C, 0x6B, 0x42, 0xD6, 0x44, 0xB7, 0xA3, 0x76, 0x33, 0x13, 0x90, 0x66,
+        0xAF, 0xE3, 0xA0, 0x51, 0x40, 0x3F, 0x30, 0x76, 0xC0, 0xE4, 0x7E, 0x76, 0x4E, 0xC1, 0x06, 0x1C,
+        0x7C, 0xA1, 0xE1, 0x14, 0xD1, 0x59, 0x56, 0x11, 0x88, 0xBE, 0xBE, 0x3D, 0xBE, 0x2A, 0x65, 0xC6,
+        0x0C, 0x4B, 0x2C, 0xAC, 0x24, 0x92, 0x43, 0xA6, 0x96, 0xF5, 0xBC, 0x56, 0x31, 0xA9, 0x59, 0xDA,
+        0x01, 0xAB, 0x08, 0x8A, 0xD2, 0xF0, 0xD2, 0x42, 0x36, 0x05, 0x4B, 0x40, 0x2A, 0x38, 0x8F, 0x0C,
+        0x71, 0xC8, 0xBD, 0x08, 0x5E, 0x43, 0x4A, 0x37, 0xAA, 0x77, 0xA9, 0x04, 0x02, 0x33, 0x39, 0x76,
+        0x3F, 0x54, 0xD8, 0x94, 0x01, 0x64, 0xAB, 0x5F, 0x7F, 0xD3, 0xFD, 0x0E, 0xB1, 0xA7, 0x00, 0x25,
+        0x28, 0xBF, 0x6F, 0x85, 0x55, 0x34, 0x49, 0x16, 0x89, 0x64, 0xC9, 0x2F, 0x1C, 0x41, 0xDF, 0xCF,
+        0xDF, 0x22, 0xA5, 0xC4, 0xBA, 0xC5, 0xA1, 0x01, 0x9F, 0x04, 0x5E, 0x29, 0x0E, 0x73, 0x65, 0x84,
+        0x0E, 0x73, 0x5A, 0x53, 0xAA, 0x95, 0xEB, 0xD8, 0x40, 0x56, 0x19, 0x8F, 0xBA, 0xD9, 0x09, 0xFB,
+        0x20, 0xF0, 0x1A, 0x22, 0xA8, 0x03, 0x89, 0x14, 0x3E, 0x74, 0x1D, 0x78, 0x87, 0x07, 0xB4, 0x0E,
+        0x7E, 0x70, 0x26, 0x9A, 0x40, 0x4A, 0xED, 0x3A, 0x06, 0x43, 0x5A, 0xBA, 0x5E, 0xCE, 0x53, 0x0F,
+        0x4D, 0xB5, 0xC3, 0xCE, 0x98, 0x1B, 0xF2, 0x36, 0x41, 0x22, 0x47, 0x5E, 0xBB, 0x06, 0x3C, 0xA5,
+        0x06, 0xDD, 0x4D, 0xDE, 0xF8, 0xB3, 0xE1, 0x11, 0xB8, 0xAC, 0x6E, 0xDC, 0x6E, 0x14, 0x97, 0x53,
+        0x31, 0x21, 0x52, 0x14, 0xC3, 0x15, 0xA8, 0x77, 0x64, 0xD8, 0xD7, 0x0F, 0x89, 0xE4, 0x23, 0xCE,
+        0x18, 0xE7, 0x19, 0x8D, 0x01, 0x92, 0x41, 0x40, 0x1D, 0x60, 0x93, 0x8C, 0xBA, 0xA7, 0x2C, 0x90,
+        0xBA, 0x16, 0xF7, 0x6F, 0x44, 0x8C, 0xB2, 0xB0, 0x08, 0xD2, 0x03, 0x37, 0x14, 0x90, 0x49, 0x41,
+        0x03, 0x22, 0x3B, 0x91, 0x4B, 0x0D, 0xA8, 0x77, 0xCF, 0x04, 0x13, 0xB5, 0x9B, 0x9A, 0x24, 0xD5,
+        0x3D, 0xB3, 0x32, 0xC2, 0xF4, 0x51, 0x80, 0x5C, 0xF6, 0xA0, 0xBD, 0x05, 0x51, 0x53, 0xA8, 0x71,
+        0x78, 0xA3, 0xB1, 0x6A, 0xD5, 0x43, 0xD7, 0x79, 0x0F, 0x56, 0xDF, 0x2F, 0x15, 0xC6, 0x06, 0x36,
+        0x56, 0x6F, 0x43, 0x50, 0x94, 0x8D, 0x87, 0x04, 0x08, 0xCA, 0x83, 0x52, 0xB7, 0xB6, 0x06, 0xC2,
+        0x06, 0x68, 0x11, 0xAB, 0xD4, 0x37, 0x21, 0x6C, 0xB7, 0xDA, 0xFF, 0x12, 0xA0, 0xB3, 0xF8, 0x85,
+        0x6E, 0xFA, 0x7D, 0x40, 0x4E, 0x23, 0x49, 0x2E, 0x31, 0xDE, 0xB2, 0x2C, 0xB4, 0xD9, 0x65, 0x45,
+        0x02, 0xF9, 0x02, 0x34, 0x76, 0xAB, 0xC9, 0xA9, 0x05, 0x6B, 0xDA, 0x8C, 0x7A, 0x6E, 0xAB, 0x6C,
+        0x40, 0x9B, 0x7D, 0x40, 0xA2, 0x0C, 0x37, 0x01, 0x10, 0x93, 0xC0, 0x54, 0xD4, 0xA7, 0xB9, 0x00,
+        0x47, 0x74, 0x26, 0x92, 0x79, 0x57, 0x0C, 0xC9, 0x64, 0xFA, 0x44, 0x5B, 0xC8, 0x45, 0x14, 0x1D,
+        0x22, 0xF1, 0x6A, 0xD7, 0xE1, 0x46, 0x86, 0x72, 0xB2, 0x83, 0x49, 0xB4, 0x04, 0x99, 0x02, 0x91,
+        0x52, 0x09, 0xD8, 0x2A, 0x6B, 0x14, 0x9C, 0xD2, 0x46, 0x93, 0x9B, 0x09, 0x56, 0x22, 0xAD, 0xA0,
+        0xC4, 0xE1, 0x69, 0x84, 0x89, 0xB0, 0x61, 0x05, 0x7F, 0x09, 0x99, 0xCC, 0x1D, 0x36, 0x4F, 0x67,
+        0x1A, 0x10, 0xF3, 0xA8, 0x81, 0xD7, 0xE6, 0xAF, 0x50, 0x44, 0x5C, 0x86, 0x67, 0x6E, 0x24, 0x25,
+        0x5D, 0x67, 0x24, 0xA6, 0x19, 0xDA, 0x88, 0xE0, 0xB4, 0x0A, 0xD8, 0x48, 0x0C, 0xE6, 0x0E, 0xEF,
+        0xA4, 0xA5, 0x8C, 0xE8, 0xA0, 0xA0, 0xDB, 0x88, 0x7A, 0xFB, 0xBE, 0x9B, 0xE0, 0x12, 0x1D, 0xF2,
+        0x71, 0xCC, 0x51, 0x49, 0xFB, 0xA9, 0x63, 0x69, 0x05, 0x12, 0x6B, 0xDD, 0x97, 0x70, 0x97, 0x97,
+        0x44, 0xAD, 0xCF, 0x6B, 0x34, 0xF4, 0x1B, 0xB0, 0xF0, 0x9F, 0xF6, 0x02, 0xDB, 0xDC, 0xF0, 0x52,
+        0xFC, 0xBF, 0x78, 0xF3, 0x0B, 0x00, 0xA9, 0x15, 0x12, 0xC9, 0xC4, 0x52, 0x99, 0x89, 0x20, 0xD8,
+        0xCA, 0xF7, 0x86, 0x62, 0x20, 0x8B, 0x7C, 0x4A, 0xA2, 0xBE, 0xF5, 0x8E, 0x6A, 0x33, 0x93, 0xA4,
+        0x2D, 0xCB, 0x3A, 0x95, 0xD3, 0x9E, 0xCD, 0x01, 0x16, 0xAB, 0x0C, 0x5F, 0x9E, 0xA1, 0x9C, 0x70,
+        0xD4, 0xDC, 0xEC, 0x3E, 0xF8, 0xCD, 0x7B, 0xDE, 0x47, 0x9D, 0x91, 0x86, 0x58, 0xEC, 0x09, 0x36,
+        0x26, 0xA6, 0xA1, 0x36, 0xAD, 0x96, 0xBC, 0x0C, 0xD3, 0x5E, 0x27, 0xCB, 0x98, 0xCC, 0x2F, 0xE6,
+        0x71, 0xA7, 0x65, 0xAC, 0x2F, 0xCC, 0xD1, 0xEF, 0x8B, 0x00, 0x2F, 0x71, 0x5E, 0x80, 0xB1, 0xB8,
+        0x11, 0x23, 0xF3, 0xCA, 0x99, 0x17, 0x9D, 0x58, 0x37, 0x6D, 0xD1, 0x2A, 0x7B, 0x6E, 0x0B, 0x6E,
+        0x9A, 0x32, 0x7F, 0xD9, 0x4C, 0xAD, 0x6B, 0xB6, 0x69, 0x24, 0x27, 0xF0, 0xF8, 0xFB, 0xE2, 0xD3,
+        0xA4, 0xF7, 0x31, 0x2D, 0x8F, 0x33, 0xD6, 0x00, 0x65, 0x5E, 0x78, 0xD2, 0xF2, 0xD3, 0xD2, 0x26,
+        0xA8, 0x5C, 0xC7, 0x2D, 0x21, 0x86, 0x01, 0xCA, 0x40, 0xCA, 0x3D, 0x1F, 0xCD, 0x2D, 0x1C, 0xE7,
+        0x47, 0x9F, 0x17, 0xEA, 0x79, 0x11, 0x9E, 0x9F, 0x43, 0x32, 0x11, 0xA8, 0xD4, 0xCE, 0xF8, 0xA1,
+        0xAF, 0x31, 0xBC, 0x89, 0xE5, 0x50, 0xF2, 0x10, 0x7B, 0xA2, 0x85, 0xFF, 0x61, 0x7E, 0x4E, 0x9F,
+        0x21, 0xB1, 0x9E, 0xA6, 0x8F, 0x06, 0x2B, 0x0E, 0xF9, 0x0A, 0x6C, 0xD1, 0xE3, 0xB4, 0x03, 0xC5,
+        0x37, 0xC9, 0xFB, 0x67, 0x4E, 0xC2, 0xCC, 0x47, 0x86, 0x35, 0x12, 0x46, 0x31, 0x03, 0x38, 0x0F,
+        0x77, 0xE6, 0x9B, 0x69, 0x62, 0xBA, 0x2F, 0x6A, 0xF5, 0x33, 0x0D, 0xFE, 0x07,
+    };
+    uint8_t const FIXED[] = {
+        0x4B, 0xCC, 0x4D, 0x2D, 0x51, 0x48, 0xCE, 0xCF, 0x2B, 0x4E, 0x4D, 0x2E, 0x49, 0x2D, 0x29, 0x2D,
+        0x52, 0x00, 0xE2, 0x82, 0xCC, 0x62, 0x85, 0xB2, 0xCC, 0xB2, 0xC4, 0xDC, 0xD2, 0x62, 0x85, 0xFC,
+        0xA2, 0xE4, 0x4C, 0x85, 0xC4, 0x94, 0x4C, 0xA0, 0x58, 0x72, 0x66, 0x5E, 0x3A, 0x32, 0xB3, 0x2C,
+        0x35, 0x47, 0x21, 0x35, 0x1D, 0xA8, 0x1D, 0xA1, 0x25, 0xB5, 0xA8, 0x28, 0x11, 0x2C, 0x0E, 0xD6,
+        0x96, 0x9B, 0x58, 0x91, 0x09, 0x32, 0x03, 0xAE, 0x30, 0x27, 0xBF, 0x28, 0x35, 0x57, 0xA1, 0x38,
+        0x13, 0xA8, 0x25, 0x33, 0x2F, 0x39, 0x33, 0xA5, 0x34, 0xAF, 0x04, 0xA8, 0xA8, 0xA4, 0x04, 0xA8,
+        0x39, 0x33, 0x0F, 0xA2, 0x27, 0xB3, 0xA0, 0xB8, 0x34, 0x57, 0x21, 0x35, 0x27, 0x13, 0xA6, 0x3A,
+        0x31, 0x27, 0xB3, 0xB0, 0x14, 0xA8, 0xB7, 0x2C, 0xB3, 0x24, 0x31, 0x55, 0x21, 0x31, 0x17, 0x6E,
+        0x0C, 0x54, 0x23, 0xB2, 0x0B, 0xD0, 0x1C, 0x02, 0xB2, 0x08, 0x6C, 0x52, 0x5A, 0x6A, 0x69, 0x7A,
+        0x66, 0x62, 0x09, 0x9A, 0x59, 0x60, 0xFB, 0x40, 0x6A, 0x90, 0xDD, 0x89, 0xEC, 0x3F, 0x24, 0x63,
+        0x20, 0x56, 0x16, 0x96, 0x26, 0xE6, 0x42, 0x35, 0xC3, 0xF4, 0xC0, 0x8D, 0x06, 0x39, 0x2C, 0x25,
+        0x1F, 0xA8, 0x0E, 0x68, 0x6E, 0x5E, 0x62, 0x51, 0xAA, 0x42, 0x5E, 0x69, 0x5E, 0x32, 0x4A, 0xC8,
+        0xC2, 0x94, 0xA6, 0x96, 0x64, 0x02, 0x8D, 0x41, 0x0B, 0x48, 0x98, 0x79, 0xC0, 0x70, 0x80, 0xFA,
+        0x02, 0xAC, 0x1F, 0x11, 0xC6, 0xF0, 0x00, 0x83, 0xD8, 0x8F, 0xEC, 0x38, 0x68, 0x60, 0x83, 0x83,
+        0x03, 0xD9, 0x42, 0x58, 0x38, 0x21, 0x7C, 0x07, 0x8B, 0x55, 0xB0, 0x47, 0xA0, 0xD2, 0xF9, 0x45,
+        0x49, 0x99, 0x48, 0x31, 0x03, 0x33, 0x18, 0xE2, 0x17, 0x64, 0x4D, 0x10, 0x95, 0x20, 0x35, 0x99,
+        0x89, 0xC9, 0xA5, 0x39, 0x99, 0x10, 0x23, 0xA1, 0xB1, 0x94, 0x0B, 0x0E, 0x56, 0x88, 0x42, 0x88,
+        0x26, 0x90, 0x2B, 0x61, 0x5E, 0x86, 0x69, 0x80, 0x45, 0x00, 0x4A, 0x82, 0x83, 0xFB, 0x0C, 0xEC,
+        0x0F, 0x88, 0xBD, 0x60, 0xCF, 0x43, 0xBD, 0x84, 0x62, 0x23, 0xD4, 0x75, 0x28, 0x49, 0x00, 0x11,
+        0x66, 0x10, 0x61, 0xB8, 0x3B, 0xA0, 0x8A, 0x61, 0x9A, 0xC1, 0x01, 0x99, 0x97, 0x99, 0x94, 0x81,
+        0x62, 0x3F, 0x3C, 0x88, 0xE1, 0x51, 0x00, 0x4E, 0x82, 0x10, 0x12, 0x23, 0x61, 0x25, 0x42, 0x23,
+        0x09, 0xE6, 0x13, 0x48, 0x2C, 0xC1, 0x2D, 0x04, 0x79, 0xBA, 0xB0, 0x14, 0x97, 0x4F, 0x91, 0x22,
+        0x16, 0x6E, 0x22, 0x48, 0x07, 0xD8, 0x4D, 0x90, 0xE0, 0x85, 0x24, 0x0E, 0x98, 0x53, 0x40, 0x5E,
+        0x07, 0x1B, 0x07, 0x4D, 0x53, 0x50, 0x5D, 0xA8, 0xE9, 0x18, 0x16, 0xC8, 0x50, 0x35, 0x70, 0x5F,
+        0xE7, 0xC1, 0x44, 0x90, 0xDD, 0x00, 0x09, 0x5E, 0x58, 0x88, 0x80, 0xD3, 0x01, 0xC4, 0xA7, 0x60,
+        0x37, 0x00, 0xF5, 0x80, 0x5D, 0x07, 0xE6, 0x80, 0xB3, 0x0E, 0x98, 0x00, 0x8B, 0x41, 0x74, 0x82,
+        0x43, 0x0A, 0x6A, 0x2E, 0x3C, 0x0C, 0x40, 0xAA, 0x21, 0xB9, 0x1E, 0x22, 0x8E, 0x92, 0x87, 0xD0,
+        0xD2, 0x0E, 0xB2, 0x63, 0x60, 0xCE, 0x80, 0xC8, 0xA2, 0x04, 0x09, 0x44, 0x08, 0x9E, 0x76, 0x61,
+        0x01, 0x8F, 0x14, 0x35, 0xE0, 0xDC, 0x8D, 0xE4, 0x1A, 0x38, 0x1F, 0x16, 0x1E, 0x88, 0x70, 0x49,
+        0x86, 0x1B, 0x0E, 0xB3, 0x11, 0xE2, 0x64, 0x94, 0xC4, 0x04, 0xF6, 0x29, 0x38, 0x31, 0xE4, 0x80,
+        0x43, 0x1D, 0x18, 0x32, 0xC8, 0x6E, 0xC5, 0x12, 0x91, 0xC8, 0x42, 0xC8, 0x31, 0x86, 0x1C, 0xCF,
+        0xE0, 0x8C, 0x01, 0x2E, 0x64, 0xC0, 0x1E, 0x02, 0x06, 0x30, 0x4C, 0x25, 0x22, 0xDD, 0x23, 0xC5,
+        0x02, 0x92, 0x76, 0x68, 0xE2, 0xC6, 0x55, 0x10, 0x83, 0x93, 0x05, 0xCC, 0x07, 0x28, 0x1C, 0xE4,
+        0x0C, 0x05, 0x0E, 0x19, 0x14, 0x4F, 0x83, 0x83, 0x08, 0x26, 0x02, 0xB1, 0x14, 0x16, 0x50, 0x98,
+        0x2E, 0x83, 0x84, 0x09, 0xD4, 0x5C, 0x94, 0x4C, 0x82, 0x92, 0xEE, 0x91, 0x4B, 0x65, 0xB0, 0x37,
+        0xE1, 0x55, 0x01, 0x38, 0x2E, 0x81, 0x9E, 0x86, 0x67, 0x41, 0x70, 0x9A, 0x02, 0xA7, 0x71, 0xB0,
+        0x6B, 0xA0, 0x7E, 0x85, 0xA6, 0x7A, 0xB0, 0x5E, 0x78, 0xB9, 0x07, 0x36, 0x15, 0xD3, 0x52, 0x48,
+        0x89, 0x0D, 0x0E, 0x1B, 0x58, 0x7A, 0x03, 0x29, 0x84, 0x68, 0x86, 0x95, 0x43, 0x90, 0x80, 0x40,
+        0x8A, 0x07, 0x68, 0xD1, 0x0D, 0xCD, 0x1A, 0x60, 0x6F, 0x83, 0x03, 0x0D, 0xE1, 0x57, 0x48, 0xFA,
+        0x46, 0x0A, 0x61, 0x98, 0xAD, 0x30, 0x1A, 0xE2, 0x41, 0x78, 0x29, 0x9E, 0x8E, 0x64, 0x13, 0xEE,
+        0x0A, 0x12, 0xAD, 0x4A, 0x82, 0x58, 0x02, 0x2B, 0xB7, 0x60, 0xB1, 0x90, 0x87, 0xEE, 0x64, 0x68,
+        0x48, 0x80, 0xE3, 0x0B, 0x1C, 0x34, 0x30, 0x5B, 0x61, 0xEA, 0xA0, 0x26, 0xC0, 0x32, 0x2D, 0x6A,
+        0xA8, 0xA3, 0x66, 0x2B, 0x54, 0x03, 0xA0, 0x99, 0x1D, 0x14, 0x24, 0xD0, 0x12, 0x0E, 0x2D, 0x00,
+        0x10, 0x35, 0x01, 0x4C, 0x0B, 0xD4, 0x4D, 0xE8, 0x09, 0x10, 0xE4, 0x3B, 0x98, 0x12, 0xD4, 0x72,
+        0x17, 0x62, 0x10, 0xA4, 0x66, 0xC2, 0x56, 0x6C, 0x81, 0xE3, 0x02, 0x91, 0xE8, 0xC0, 0x3E, 0x81,
+        0xA7, 0x76, 0x68, 0xE5, 0x86, 0x64, 0x10, 0x6A, 0x64, 0x23, 0x4A, 0x12, 0x68, 0x12, 0x44, 0x2E,
+        0x02, 0xC1, 0x51, 0x0A, 0xF1, 0x30, 0x2C, 0x65, 0x81, 0x12, 0x1C, 0xB4, 0xD8, 0xC8, 0x83, 0xD8,
+        0x8C, 0x14, 0xAC, 0x48, 0x85, 0x16, 0xA2, 0x48, 0x04, 0xB9, 0x14, 0xE1, 0x4D, 0xB0, 0xB7, 0xC1,
+        0xA6, 0x80, 0x59, 0x90, 0xC2, 0x04, 0x3D, 0x87, 0xA1, 0xD7, 0xCE, 0x48, 0x15, 0x04, 0x7A, 0x55,
+        0x03, 0x76, 0x35, 0xCC, 0xBD, 0x90, 0x22, 0x02, 0x61, 0x19, 0x98, 0x8F, 0x9C, 0x91, 0xA0, 0x85,
+        0x2E, 0xBC, 0x44, 0x42, 0x2E, 0x66, 0x90, 0x5A, 0x44, 0x60, 0x47, 0x43, 0x15, 0xC0, 0xAA, 0x44,
+        0x44, 0xC9, 0x8D, 0x70, 0x1D, 0x24, 0x4B, 0xC1, 0x0A, 0x3A, 0xB0, 0x06, 0x68, 0x6B, 0x04, 0xEA,
+        0x5A, 0xCC, 0xB6, 0x09, 0xD8, 0x12, 0x68, 0x25, 0x8F, 0x10, 0x46, 0xF6, 0x15, 0x24, 0xFB, 0x41,
+        0x1D, 0x86, 0xD2, 0x04, 0x82, 0x98, 0x06, 0x74, 0x0B, 0xC2, 0xB9, 0xC8, 0x8D, 0x44, 0x68, 0xFA,
+        0xCC, 0x41, 0x64, 0x68, 0x8C, 0x80, 0x05, 0xBB, 0x1F, 0xA9, 0x5D, 0x00, 0x6B, 0xB9, 0x81, 0x25,
+        0x21, 0xEE, 0x4F, 0x87, 0x67, 0x7E, 0x48, 0x00, 0xA0, 0x64, 0x05, 0x94, 0x42, 0x06, 0xD1, 0xA8,
+        0x44, 0x2D, 0x08, 0x10, 0xA5, 0x15, 0xBC, 0xDD, 0x90, 0x08, 0x0B, 0x64, 0x88, 0x7A, 0x94, 0x48,
+        0x84, 0xCA, 0xC2, 0x73, 0x54, 0x1E, 0x7A, 0x49, 0x82, 0xD2, 0xCA, 0x82, 0xE5, 0x54, 0xE4, 0x68,
+        0x47, 0x35, 0x0E, 0x1C, 0x2C, 0xB0, 0x94, 0x01, 0x6F, 0x3C, 0x83, 0x35, 0xA3, 0x84, 0x23, 0x34,
+        0x6E, 0x72, 0xE1, 0x15, 0x3F, 0xCC, 0xF5, 0xC8, 0xED, 0x51, 0x78, 0x89, 0x04, 0x52, 0x86, 0x68,
+        0x27, 0xC0, 0xAA, 0x09, 0xB4, 0x4A, 0x0D, 0xAD, 0x69, 0x89, 0xDC, 0x18, 0x46, 0x6A, 0xD7, 0x41,
+        0x1A, 0x63, 0x90, 0xFA, 0x0B, 0xB9, 0x1C, 0x87, 0x17, 0xCB, 0xE0, 0xE6, 0x0B, 0x72, 0x19, 0x8D,
+        0xD9, 0x10, 0x40, 0x6E, 0xC4, 0xC1, 0x13, 0x20, 0xA2, 0xE1, 0x86, 0x54, 0x22, 0x23, 0x37, 0x39,
+        0x51, 0x1B, 0x3A, 0x88, 0xE6, 0x26, 0xAC, 0xA1, 0x95, 0x98, 0x8B, 0x9A, 0x2D, 0x90, 0x33, 0x4D,
+        0x22, 0x7A, 0xCF, 0x06, 0x2D, 0xEB, 0xC2, 0xCC, 0x46, 0xAA, 0x92, 0x51, 0x02, 0x0F, 0xB9, 0x7F,
+        0x81, 0xAD, 0xA6, 0x87, 0x57, 0xD3, 0x10, 0x2E, 0x7A, 0x58, 0x83, 0x03, 0x05, 0xBD, 0xC1, 0x83,
+        0xD2, 0xF8, 0xC9, 0x43, 0x69, 0x09, 0x42, 0xCB, 0x3A, 0xE4, 0x2C, 0x01, 0x31, 0x18, 0x1C, 0x28,
+        0xA0, 0x90, 0x82, 0xBB, 0x1C, 0x94, 0xB9, 0x21, 0x65, 0x1C, 0x5C, 0x08, 0x7B, 0x83, 0x1A, 0xBD,
+        0x21, 0x8C, 0xCE, 0x47, 0xA8, 0x44, 0x29, 0x40, 0x21, 0x69, 0x07, 0x44, 0x20, 0xF5, 0xC6, 0xC0,
+        0x32, 0x88, 0xC6, 0x21, 0x24, 0x1E, 0x10, 0xED, 0x44, 0x98, 0xF7, 0xB1, 0xD4, 0x9F, 0x68, 0xDD,
+        0x10, 0x44, 0xF3, 0x14, 0xA5, 0xD3, 0x00, 0x4B, 0x1C, 0x90, 0x5E, 0x60, 0x1E, 0x22, 0x8F, 0x23,
+        0xB5, 0x81, 0x10, 0x7D, 0x12, 0xCC, 0x6E, 0x0E, 0x4A, 0x98, 0xC1, 0xAB, 0x0C, 0x58, 0x46, 0x02,
+        0x57, 0xC5, 0xC8, 0x01, 0x88, 0x5E, 0xB9, 0x23, 0x97, 0x37, 0x68, 0x35, 0x26, 0xDC, 0x2D, 0x50,
+        0x53, 0xB1, 0x17, 0x83, 0x00,
+    };
+    uint8_t const STORED[] = {
+        0x01, 0x2C, 0x01, 0xD3, 0xFE, 0x61, 0x6D, 0x65, 0x74, 0x20, 0x63, 0x6F, 0x6E, 0x73, 0x65, 0x63,
+        0x74, 0x65, 0x74, 0x75, 0x72, 0x20, 0x74, 0x75, 0x72, 0x70, 0x69, 0x73, 0x20, 0x76, 0x69, 0x76,
+        0x61, 0x6D, 0x75, 0x73, 0x20, 0x6F, 0x72, 0x63, 0x69, 0x20, 0x61, 0x64, 0x69, 0x70, 0x69, 0x73,
+        0x63, 0x69, 0x6E, 0x67, 0x20, 0x61, 0x64, 0x69, 0x70, 0x69, 0x73, 0x63, 0x69, 0x6E, 0x67, 0x20,
+        0x76, 0x65, 0x6C, 0x20, 0x65, 0x67, 0x65, 0x74, 0x20, 0x74, 0x75, 0x72, 0x70, 0x69, 0x73, 0x20,
+        0x76, 0x69, 0x76, 0x65, 0x72, 0x72, 0x61, 0x20, 0x76, 0x65, 0x6C, 0x20, 0x6F, 0x72, 0x63, 0x69,
+        0x20, 0x6D, 0x61, 0x78, 0x69, 0x6D, 0x75, 0x73, 0x20, 0x76, 0x65, 0x6C, 0x20, 0x65, 0x67, 0x65,
+        0x74, 0x20, 0x6C, 0x6F, 0x72, 0x65, 0x6D, 0x20, 0x73, 0x69, 0x74, 0x20, 0x74, 0x69, 0x6E, 0x63,
+        0x69, 0x64, 0x75, 0x6E, 0x74, 0x20, 0x6D, 0x61, 0x74, 0x74, 0x69, 0x73, 0x20, 0x69, 0x6E, 0x20,
+        0x6F, 0x72, 0x63, 0x69, 0x20, 0x69, 0x70, 0x73, 0x75, 0x6D, 0x20, 0x65, 0x6C, 0x69, 0x74, 0x20,
+        0x6C, 0x6F, 0x72, 0x65, 0x6D, 0x20, 0x61, 0x6C, 0x69, 0x71, 0x75, 0x65, 0x74, 0x20, 0x76, 0x69,
+        0x74, 0x61, 0x65, 0x20, 0x61, 0x6D, 0x65, 0x74, 0x20, 0x6C, 0x6F, 0x72, 0x65, 0x6D, 0x20, 0x6D,
+        0x61, 0x74, 0x74, 0x69, 0x73, 0x20, 0x65, 0x67, 0x65, 0x74, 0x20, 0x74, 0x75, 0x72, 0x70, 0x69,
+        0x73, 0x20, 0x74, 0x75, 0x72, 0x70, 0x69, 0x73, 0x20, 0x76, 0x69, 0x76, 0x65, 0x72, 0x72, 0x61,
+        0x20, 0x73, 0x69, 0x74, 0x20, 0x65, 0x6C, 0x69, 0x74, 0x20, 0x66, 0x65, 0x75, 0x67, 0x69, 0x61,
+        0x74, 0x20, 0x61, 0x6C, 0x69, 0x71, 0x75, 0x65, 0x74, 0x20, 0x76, 0x69, 0x74, 0x61, 0x65, 0x20,
+        0x6F, 0x72, 0x63, 0x69, 0x20, 0x73, 0x69, 0x74, 0x20, 0x6D, 0x61, 0x78, 0x69, 0x6D, 0x75, 0x73,
+        0x20, 0x76, 0x65, 0x6C, 0x20, 0x61, 0x64, 0x69, 0x70, 0x69, 0x73, 0x63, 0x69, 0x6E, 0x67, 0x20,
+        0x76, 0x69, 0x76, 0x65, 0x72, 0x72, 0x61, 0x20, 0x73, 0x69, 0x74, 0x20, 0x6C, 0x6F, 0x72, 0x65,
+        0x6D,
+    };
+    uint8_t const ZLIB[] = {
+        0x78, 0x9C, 0x75, 0x57, 0xED, 0x92, 0xDB, 0x30, 0x08, 0x7C, 0x15, 0xBF, 0x9A, 0xCE, 0xE7, 0xA6,
+        0x9A, 0x89, 0x95, 0x4B, 0x62, 0x67, 0xFA, 0xF8, 0x95, 0x96, 0xAF, 0x45, 0xC9, 0xFD, 0x68, 0x7A,
+        0x96, 0x01, 0xC1, 0x02, 0x0B, 0x2E, 0xFB, 0x76, 0x2C, 0xEB, 0xAD, 0x3D, 0xB7, 0xF5, 0xD8, 0x8E,
+        0xF3, 0xB1, 0xF4, 0x7F, 0x3F, 0xF5, 0xB9, 0xBC, 0xEA, 0xAB, 0xEC, 0xE7, 0x73, 0xB9, 0x3D, 0xD6,
+        0xBA, 0x94, 0xEF, 0xDA, 0xCF, 0xD6, 0xDA, 0x2E, 0xFC, 0xE7, 0x6B, 0xBB, 0x2E, 0xDB, 0xA5, 0xAB,
+        0x87, 0xCA, 0xF6, 0x78, 0x14, 0x9C, 0x43, 0x6D, 0x2F, 0xFF, 0xEA, 0xB0, 0xE1, 0x82, 0xD7, 0xDB,
+        0x63, 0xDB, 0x97, 0x67, 0xED, 0x2A, 0xB5, 0xAD, 0xF5, 0xFB, 0x6C, 0x47, 0x17, 0x3A, 0x8E, 0xAE,
+        0x5C, 0x9B, 0xE8, 0xD4, 0x9F, 0xE7, 0xB9, 0x2F, 0xDB, 0xB5, 0x9A, 0x74, 0xB9, 0xD6, 0xFB, 0xD9,
+        0x75, 0x5F, 0xF5, 0x28, 0xDB, 0x52, 0x76, 0x37, 0xA3, 0x8A, 0xEC, 0xC1, 0xE4, 0xC8, 0xB8, 0x08,
+        0x96, 0xFE, 0x6C, 0xE7, 0xA5, 0x96, 0x63, 0xB2, 0x85, 0xFB, 0x86, 0x0C, 0xFB, 0xC9, 0xF1, 0x91,
+        0x19, 0xB9, 0xF2, 0x7E, 0x96, 0x5D, 0x95, 0x4D, 0xC7, 0x4D, 0x0F, 0xC7, 0xBE, 0x6F, 0x5D, 0xAE,
+        0xDB, 0x6D, 0xE5, 0xB1, 0x2D, 0xED, 0x6C, 0x6B, 0x42, 0xD6, 0x44, 0xB7, 0xA3, 0x76, 0x33, 0x13,
+        0x90, 0x66, 0xAF, 0xE3, 0xA0, 0x51, 0x40, 0x3F, 0x30, 0x76, 0xC0, 0xE4, 0x7E, 0x76, 0x4E, 0xC1,
+        0x06, 0x1C, 0x7C, 0xA1, 0xE1, 0x14, 0xD1, 0x59, 0x56, 0x11, 0x88, 0xBE, 0xBE, 0x3D, 0xBE, 0x2A,
+        0x65, 0xC6, 0x0C, 0x4B, 0x2C, 0xAC, 0x24, 0x92, 0x43, 0xA6, 0x96, 0xF5, 0xBC, 0x56, 0x31, 0xA9,
+        0x59, 0xDA, 0x01, 0xAB, 0x08, 0x8A, 0xD2, 0xF0, 0xD2, 0x42, 0x36, 0x05, 0x4B, 0x40, 0x2A, 0x38,
+        0x8F, 0x0C, 0x71, 0xC8, 0xBD, 0x08, 0x5E, 0x43, 0x4A, 0x37, 0xAA, 0x77, 0xA9, 0x04, 0x02, 0x33,
+        0x39, 0x76, 0x3F, 0x54, 0xD8, 0x94, 0x01, 0x64, 0xAB, 0x5F, 0x7F, 0xD3, 0xFD, 0x0E, 0xB1, 0xA7,
+        0x00, 0x25, 0x28, 0xBF, 0x6F, 0x85, 0x55, 0x34, 0x49, 0x16, 0x89, 0x64, 0xC9, 0x2F, 0x1C, 0x41,
+        0xDF, 0xCF, 0xDF, 0x22, 0xA5, 0xC4, 0xBA, 0xC5, 0xA1, 0x01, 0x9F, 0x04, 0x5E, 0x29, 0x0E, 0x73,
+        0x65, 0x84, 0x0E, 0x73, 0x5A, 0x53, 0xAA, 0x95, 0xEB, 0xD8, 0x40, 0x56, 0x19, 0x8F, 0xBA, 0xD9,
+        0x09, 0xFB, 0x20, 0xF0, 0x1A, 0x22, 0xA8, 0x03, 0x89, 0x14, 0x3E, 0x74, 0x1D, 0x78, 0x87, 0x07,
+        0xB4, 0x0E, 0x7E, 0x70, 0x26, 0x9A, 0x40, 0x4A, 0xED, 0x3A, 0x06, 0x43, 0x5A, 0xBA, 0x5E, 0xCE,
+        0x53, 0x0F, 0x4D, 0xB5, 0xC3, 0xCE, 0x98, 0x1B, 0xF2, 0x36, 0x41, 0x22, 0x47, 0x5E, 0xBB, 0x06,
+        0x3C, 0xA5, 0x06, 0xDD, 0x4D, 0xDE, 0xF8, 0xB3, 0xE1, 0x11, 0xB8, 0xAC, 0x6E, 0xDC, 0x6E, 0x14,
+        0x97, 0x53, 0x31, 0x21, 0x52, 0x14, 0xC3, 0x15, 0xA8, 0x77, 0x64, 0xD8, 0xD7, 0x0F, 0x89, 0xE4,
+        0x23, 0xCE, 0x18, 0xE7, 0x19, 0x8D, 0x01, 0x92, 0x41, 0x40, 0x1D, 0x60, 0x93, 0x8C, 0xBA, 0xA7,
+        0x2C, 0x90, 0xBA, 0x16, 0xF7, 0x6F, 0x44, 0x8C, 0xB2, 0xB0, 0x08, 0xD2, 0x03, 0x37, 0x14, 0x90,
+        0x49, 0x41, 0x03, 0x22, 0x3B, 0x91, 0x4B, 0x0D, 0xA8, 0x77, 0xCF, 0x04, 0x13, 0xB5, 0x9B, 0x9A,
+        0x24, 0xD5, 0x3D, 0xB3, 0x32, 0xC2, 0xF4, 0x51, 0x80, 0x5C, 0xF6, 0xA0, 0xBD, 0x05, 0x51, 0x53,
+        0xA8, 0x71, 0x78, 0xA3, 0xB1, 0x6A, 0xD5, 0x43, 0xD7, 0x79, 0x0F, 0x56, 0xDF, 0x2F, 0x15, 0xC6,
+        0x06, 0x36, 0x56, 0x6F, 0x43, 0x50, 0x94, 0x8D, 0x87, 0x04, 0x08, 0xCA, 0x83, 0x52, 0xB7, 0xB6,
+        0x06, 0xC2, 0x06, 0x68, 0x11, 0xAB, 0xD4, 0x37, 0x21, 0x6C, 0xB7, 0xDA, 0xFF, 0x12, 0xA0, 0xB3,
+        0xF8, 0x85, 0x6E, 0xFA, 0x7D, 0x40, 0x4E, 0x23, 0x49, 0x2E, 0x31, 0xDE, 0xB2, 0x2C, 0xB4, 0xD9,
+        0x65, 0x45, 0x02, 0xF9, 0x02, 0x34, 0x76, 0xAB, 0xC9, 0xA9, 0x05, 0x6B, 0xDA, 0x8C, 0x7A, 0x6E,
+        0xAB, 0x6C, 0x40, 0x9B, 0x7D, 0x40, 0xA2, 0x0C, 0x37, 0x01, 0x10, 0x93, 0xC0, 0x54, 0xD4, 0xA7,
+        0xB9, 0x00, 0x47, 0x74, 0x26, 0x92, 0x79, 0x57, 0x0C, 0xC9, 0x64, 0xFA, 0x44, 0x5B, 0xC8, 0x45,
+        0x14, 0x1D, 0x22, 0xF1, 0x6A, 0xD7, 0xE1, 0x46, 0x86, 0x72, 0xB2, 0x83, 0x49, 0xB4, 0x04, 0x99,
+        0x02, 0x91, 0x52, 0x09, 0xD8, 0x2A, 0x6B, 0x14, 0x9C, 0xD2, 0x46, 0x93, 0x9B, 0x09, 0x56, 0x22,
+        0xAD, 0xA0, 0xC4, 0xE1, 0x69, 0x84, 0x89, 0xB0, 0x61, 0x05, 0x7F, 0x09, 0x99, 0xCC, 0x1D, 0x36,
+        0x4F, 0x67, 0x1A, 0x10, 0xF3, 0xA8, 0x81, 0xD7, 0xE6, 0xAF, 0x50, 0x44, 0x5C, 0x86, 0x67, 0x6E,
+        0x24, 0x25, 0x5D, 0x67, 0x24, 0xA6, 0x19, 0xDA, 0x88, 0xE0, 0xB4, 0x0A, 0xD8, 0x48, 0x0C, 0xE6,
+        0x0E, 0xEF, 0xA4, 0xA5, 0x8C, 0xE8, 0xA0, 0xA0, 0xDB, 0x88, 0x7A, 0xFB, 0xBE, 0x9B, 0xE0, 0x12,
+        0x1D, 0xF2, 0x71, 0xCC, 0x51, 0x49, 0xFB, 0xA9, 0x63, 0x69, 0x05, 0x12, 0x6B, 0xDD, 0x97, 0x70,
+        0x97, 0x97, 0x44, 0xAD, 0xCF, 0x6B, 0x34, 0xF4, 0x1B, 0xB0, 0xF0, 0x9F, 0xF6, 0x02, 0xDB, 0xDC,
+        0xF0, 0x52, 0xFC, 0xBF, 0x78, 0xF3, 0x0B, 0x00, 0xA9, 0x15, 0x12, 0xC9, 0xC4, 0x52, 0x99, 0x89,
+        0x20, 0xD8, 0xCA, 0xF7, 0x86, 0x62, 0x20, 0x8B, 0x7C, 0x4A, 0xA2, 0xBE, 0xF5, 0x8E, 0x6A, 0x33,
+        0x93, 0xA4, 0x2D, 0xCB, 0x3A, 0x95, 0xD3, 0x9E, 0xCD, 0x01, 0x16, 0xAB, 0x0C, 0x5F, 0x9E, 0xA1,
+        0x9C, 0x70, 0xD4, 0xDC, 0xEC, 0x3E, 0xF8, 0xCD, 0x7B, 0xDE, 0x47, 0x9D, 0x91, 0x86, 0x58, 0xEC,
+        0x09, 0x36, 0x26, 0xA6, 0xA1, 0x36, 0xAD, 0x96, 0xBC, 0x0C, 0xD3, 0x5E, 0x27, 0xCB, 0x98, 0xCC,
+        0x2F, 0xE6, 0x71, 0xA7, 0x65, 0xAC, 0x2F, 0xCC, 0xD1, 0xEF, 0x8B, 0x00, 0x2F, 0x71, 0x5E, 0x80,
+        0xB1, 0xB8, 0x11, 0x23, 0xF3, 0xCA, 0x99, 0x17, 0x9D, 0x58, 0x37, 0x6D, 0xD1, 0x2A, 0x7B, 0x6E,
+        0x0B, 0x6E, 0x9A, 0x32, 0x7F, 0xD9, 0x4C, 0xAD, 0x6B, 0xB6, 0x69, 0x24, 0x27, 0xF0, 0xF8, 0xFB,
+        0xE2, 0xD3, 0xA4, 0xF7, 0x31, 0x2D, 0x8F, 0x33, 0xD6, 0x00, 0x65, 0x5E, 0x78, 0xD2, 0xF2, 0xD3,
+        0xD2, 0x26, 0xA8, 0x5C, 0xC7, 0x2D, 0x21, 0x86, 0x01, 0xCA, 0x40, 0xCA, 0x3D, 0x1F, 0xCD, 0x2D,
+        0x1C, 0xE7, 0x47, 0x9F, 0x17, 0xEA, 0x79, 0x11, 0x9E, 0x9F, 0x43, 0x32, 0x11, 0xA8, 0xD4, 0xCE,
+        0xF8, 0xA1, 0xAF, 0x31, 0xBC, 0x89, 0xE5, 0x50, 0xF2, 0x10, 0x7B, 0xA2, 0x85, 0xFF, 0x61, 0x7E,
+        0x4E, 0x9F, 0x21, 0xB1, 0x9E, 0xA6, 0x8F, 0x06, 0x2B, 0x0E, 0xF9, 0x0A, 0x6C, 0xD1, 0xE3, 0xB4,
+        0x03, 0xC5, 0x37, 0xC9, 0xFB, 0x67, 0x4E, 0xC2, 0xCC, 0x47, 0x86, 0x35, 0x12, 0x46, 0x31, 0x03,
+        0x38, 0x0F, 0x77, 0xE6, 0x9B, 0x69, 0x62, 0xBA, 0x2F, 0x6A, 0xF5, 0x33, 0x0D, 0xFE, 0x07, 0xF1,
+        0xCF, 0xC9, 0x09,
+    };
+    uint8_t const GZIP[] = {
+        0x1F, 0x8B, 0x08, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x02, 0x00, 0x78, 0x79, 0x6C, 0x6F,
+        0x72, 0x65, 0x6D, 0x2E, 0x74, 0x78, 0x74, 0x00, 0x75, 0x55, 0x5B, 0x72, 0x83, 0x30, 0x0C, 0xBC,
+        0x8A, 0xAF, 0xE6, 0x12, 0x97, 0x6A, 0x06, 0x4C, 0x02, 0x36, 0xD3, 0xE3, 0xD7, 0x5E, 0x3D, 0x90,
+        0x49, 0xF3, 0xD1, 0x34, 0x38, 0x5A, 0x49, 0xBB, 0x5A, 0x99, 0xB8, 0xA6, 0x12, 0xA6, 0x2D, 0x1F,
+        0x69, 0x2A, 0xA9, 0xD4, 0x3D, 0xB4, 0xBF, 0x27, 0x1D, 0xE1, 0xA4, 0x33, 0xAE, 0xF5, 0x08, 0xDB,
+        0x3E, 0x51, 0x88, 0x0F, 0x6A, 0x67, 0x13, 0xE5, 0xD9, 0x7F, 0x3D, 0xD3, 0x12, 0xD2, 0xDC, 0xE0,
+        0x17, 0x24, 0xED, 0x7B, 0xC4, 0x39, 0x60, 0x6B, 0xFC, 0xA5, 0x9E, 0xC3, 0x02, 0x97, 0x6D, 0x4F,
+        0x6B, 0x38, 0xA8, 0x41, 0x28, 0x4F, 0xF4, 0xA8, 0xB9, 0xB4, 0xA0, 0x52, 0x1A, 0x98, 0x32, 0x63,
+        0xE8, 0x79, 0xD4, 0x35, 0xA4, 0x85, 0x34, 0x3A, 0x2E, 0xF4, 0xAA, 0x0D, 0x7B, 0x52, 0x89, 0x29,
+        0xC4, 0xD5, 0xD2, 0x08, 0xD0, 0x77, 0x70, 0x6B, 0xA4, 0x17, 0x42, 0xA6, 0xEF, 0x54, 0x67, 0x8A,
+        0xE5, 0x96, 0x0B, 0xF5, 0x7A, 0x8C, 0xEF, 0xD3, 0xF3, 0x73, 0x69, 0xB8, 0xE4, 0xAB, 0xC6, 0x55,
+        0xC0, 0x8A, 0xB1, 0xD4, 0xBD, 0xB1, 0xC7, 0xD6, 0xE2, 0x5A, 0xDE, 0x1C, 0xF7, 0x14, 0x72, 0xCD,
+        0xD3, 0xA0, 0xAC, 0x86, 0xA6, 0x42, 0x2D, 0xCD, 0x4D, 0x48, 0xCD, 0xD7, 0x74, 0x10, 0x16, 0xC0,
+        0x5F, 0x1A, 0x9B, 0x60, 0x5C, 0xDF, 0x37, 0x27, 0x62, 0x43, 0x0E, 0x5F, 0x50, 0x75, 0xBA, 0xD8,
+        0xE9, 0x54, 0x41, 0x44, 0x7E, 0xDE, 0xF6, 0x2F, 0x72, 0x93, 0xD1, 0xC4, 0xCC, 0xC5, 0x83, 0x38,
+        0xB2, 0xC7, 0x50, 0x9C, 0xEA, 0x42, 0x9C, 0x52, 0xA6, 0xB4, 0x42, 0x56, 0x0E, 0x64, 0x50, 0xEF,
+        0x52, 0x29, 0x2B, 0x40, 0x07, 0x30, 0x18, 0xCE, 0x98, 0x81, 0x07, 0xD7, 0x05, 0x79, 0xA1, 0x34,
+        0x54, 0x94, 0xEE, 0x06, 0x0B, 0x5C, 0x9A, 0xF1, 0xB1, 0xF5, 0x21, 0xC1, 0x0A, 0x86, 0x90, 0x99,
+        0xBE, 0x7E, 0x86, 0xFA, 0x26, 0xB1, 0x8D, 0x00, 0x16, 0xE4, 0xCF, 0x37, 0x63, 0x45, 0x19, 0x92,
+        0x32, 0xE1, 0x29, 0x59, 0xC1, 0x4E, 0xFA, 0x55, 0x3F, 0x31, 0x75, 0x83, 0xB5, 0x8C, 0x1D, 0x81,
+        0x9E, 0x58, 0x5E, 0x36, 0x87, 0xB6, 0xD2, 0xA9, 0x23, 0x9D, 0x78, 0x4A, 0x50, 0xA3, 0x8F, 0x55,
+        0x64, 0x89, 0x31, 0xD6, 0x59, 0x4F, 0x7C, 0x0F, 0x2C, 0xAF, 0x2A, 0x02, 0x1F, 0x30, 0x53, 0xF4,
+        0xD0, 0x30, 0xE8, 0x0E, 0x0F, 0x58, 0x1D, 0x7C, 0xE0, 0x8C, 0x91, 0x50, 0x4A, 0xF2, 0x9A, 0x06,
+        0x3D, 0x9A, 0xB7, 0x9E, 0xCF, 0x87, 0x1D, 0xBA, 0x79, 0xC7, 0x37, 0xA3, 0x6D, 0xF0, 0xAF, 0x83,
+        0x24, 0x7C, 0x64, 0xDE, 0x55, 0xE1, 0xDD, 0x68, 0xB0, 0xDD, 0xAE, 0x1B, 0x7B, 0x56, 0x3D, 0x2E,
+        0x5D, 0x26, 0x4B, 0xAE, 0x15, 0xB9, 0xE5, 0xC1, 0x4C, 0x60, 0x0A, 0x33, 0x2C, 0x50, 0xBD, 0x29,
+        0xE3, 0x7B, 0xFD, 0x67, 0x90, 0xFE, 0xC8, 0x4F, 0xCC, 0xCF, 0x19, 0x8B, 0x81, 0x4B, 0x06, 0x84,
+        0x9A, 0xC0, 0x1A, 0x79, 0xF9, 0xDE, 0x4D, 0xC1, 0xC1, 0xC5, 0xDC, 0x9F, 0x2E, 0x62, 0xD8, 0x42,
+        0x19, 0x0C, 0x0F, 0x7E, 0xA1, 0xA0, 0xCC, 0x40, 0x1A, 0x12, 0xE9, 0x09, 0x17, 0x55, 0xA1, 0xDE,
+        0x3B, 0x63, 0x4D, 0x24, 0xEF, 0xB0, 0x24, 0x83, 0xEF, 0xFD, 0xAD, 0x0C, 0x9A, 0xF6, 0x2A, 0xC0,
+        0x2C, 0x1B, 0x69, 0x5B, 0x41, 0x78, 0x0A, 0x1E, 0x47, 0x37, 0xC2, 0x55, 0x5C, 0x0F, 0xAC, 0xDD,
+        0x7B, 0xC8, 0xFA, 0x5E, 0x94, 0x6F, 0x6C, 0x68, 0xA3, 0x7E, 0xEB, 0x81, 0x0C, 0xD6, 0x7B, 0x88,
+        0x85, 0x70, 0x73, 0x90, 0xAB, 0x5B, 0x56, 0x03, 0xB4, 0x21, 0xDA, 0xC5, 0x95, 0xFD, 0xED, 0x14,
+        0xD6, 0xAA, 0xFA, 0x9F, 0x09, 0xDA, 0x2D, 0x3E, 0xBB, 0x4A, 0x9F, 0x5F, 0x90, 0xB7, 0x57, 0x12,
+        0x17, 0xD1, 0x7B, 0x4B, 0xA7, 0x90, 0xEF, 0x2D, 0x8B, 0x12, 0x98, 0x17, 0xA4, 0xD1, 0xAA, 0x1A,
+        0x27, 0x19, 0x74, 0x69, 0x2F, 0xD5, 0xFF, 0x00, 0x28, 0xE4, 0xA8, 0x31, 0xD0, 0x07, 0x00, 0x00,
+        0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6D, 0x55, 0x6D, 0x92, 0xEB, 0x20,
+        0x0C, 0xBB, 0x0A, 0x57, 0x63, 0x53, 0xB6, 0xCF, 0x33, 0xF9, 0xD8, 0x26, 0xD0, 0x79, 0xC7, 0x5F,
+        0x2C, 0xD9, 0xC4, 0xC9, 0xF6, 0x47, 0x1B, 0x08, 0x46, 0x96, 0x64, 0x43, 0xF6, 0x3D, 0x27, 0xC9,
+        0x53, 0x9B, 0xE5, 0x48, 0xCB, 0xB6, 0x7F, 0x49, 0x2A, 0x55, 0xF2, 0x92, 0xBE, 0x4B, 0x7B, 0x4A,
+        0xAE, 0x49, 0x7E, 0x8E, 0xB6, 0xA4, 0xB5, 0xAD, 0x93, 0x0D, 0xAB, 0xAC, 0x93, 0x3C, 0xDA, 0x5A,
+        0xD3, 0x63, 0x9B, 0xB7, 0x3D, 0xF5, 0x5F, 0x59, 0xD2, 0x21, 0x75, 0x6C, 0xA9, 0x6D, 0xFF, 0xE9,
+        0x68, 0xDB, 0x3E, 0x49, 0xCA, 0x0F, 0xE9, 0xE3, 0x49, 0xD6, 0x67, 0x7A, 0x97, 0x79, 0x84, 0x70,
+        0xD3, 0x5B, 0xDE, 0x79, 0x69, 0x87, 0x01, 0x29, 0xC4, 0xB6, 0xAF, 0x79, 0x2F, 0x8E, 0x90, 0x67,
+        0x79, 0xB5, 0x52, 0xD3, 0xAB, 0x05, 0x42, 0x4B, 0xAE, 0x55, 0xB9, 0xF2, 0xF1, 0x96, 0x9A, 0xCB,
+        0x0D, 0xC8, 0x96, 0x0C, 0x8B, 0xA2, 0x14, 0x1C, 0x22, 0xB8, 0xC1, 0xC1, 0x5E, 0xAD, 0x07, 0x52,
+        0xB0, 0xE5, 0x2C, 0xB3, 0xB8, 0x68, 0x59, 0x99, 0x79, 0x95, 0xAF, 0x7F, 0x16, 0xA4, 0x1A, 0x0C,
+        0xD7, 0x4D, 0x03, 0x44, 0x90, 0x09, 0xD9, 0x40, 0xC1, 0x08, 0x7F, 0xA7, 0x67, 0x2E, 0x70, 0xBC,
+        0x20, 0x9F, 0x9E, 0xCA, 0xC5, 0x4E, 0xDB, 0x7A, 0x94, 0xA9, 0x96, 0xCE, 0x07, 0xE9, 0xC0, 0xDA,
+        0xF9, 0x62, 0x12, 0x92, 0x61, 0x4E, 0x33, 0xA9, 0x93, 0x0E, 0x20, 0x3D, 0xB8, 0x2F, 0xF9, 0xBF,
+        0xA8, 0x33, 0xAA, 0x9F, 0xA9, 0xF2, 0x52, 0x4C, 0xB7, 0x05, 0xC0, 0xAC, 0x4E, 0x00, 0x9B, 0x00,
+        0x78, 0xB2, 0x43, 0x30, 0x16, 0x94, 0x0A, 0x36, 0xD0, 0x08, 0x67, 0x6B, 0xB3, 0x50, 0x65, 0x24,
+        0x21, 0xA5, 0xF0, 0x3A, 0xAA, 0x02, 0xA8, 0x13, 0x23, 0x61, 0xB3, 0x85, 0x68, 0x9D, 0xCB, 0x49,
+        0xB7, 0x97, 0xB6, 0xEC, 0xBD, 0x47, 0x35, 0xBF, 0xF5, 0xA7, 0xD2, 0x31, 0xDA, 0x7F, 0x8C, 0x05,
+        0x7F, 0x78, 0x4E, 0x60, 0x82, 0xD8, 0x22, 0xF9, 0x3F, 0x35, 0x3B, 0x90, 0x68, 0x00, 0x86, 0x9E,
+        0x06, 0xB5, 0x8E, 0xAD, 0x30, 0x3A, 0x15, 0xCB, 0x6C, 0x8C, 0xC1, 0xC9, 0xDA, 0xCE, 0x9F, 0xC7,
+        0x88, 0xBF, 0x14, 0xD1, 0x56, 0xC7, 0x89, 0x5A, 0x69, 0x7F, 0xEC, 0x01, 0x46, 0xC4, 0x82, 0x5C,
+        0xCA, 0x7E, 0x85, 0x83, 0x2D, 0xDE, 0x19, 0xEC, 0xC8, 0xC9, 0xC4, 0x5C, 0x7C, 0xB4, 0xDA, 0xA8,
+        0xDB, 0xD6, 0x65, 0xC6, 0x5E, 0xC7, 0xEE, 0xBF, 0x6B, 0x41, 0x98, 0x57, 0xD5, 0x5F, 0x02, 0x33,
+        0x26, 0x87, 0x79, 0x27, 0xF1, 0x43, 0xCE, 0x42, 0x5A, 0xC9, 0x15, 0x06, 0xC4, 0xE8, 0xAB, 0x9F,
+        0x12, 0x2B, 0x1A, 0x43, 0x61, 0xF2, 0x98, 0xB0, 0x62, 0xE0, 0x1D, 0x1A, 0x46, 0xA1, 0x2F, 0x9B,
+        0x55, 0x68, 0xB7, 0xCE, 0x6A, 0x43, 0x29, 0xF0, 0x51, 0x17, 0xDC, 0xC1, 0x53, 0x80, 0x9B, 0xE4,
+        0xF5, 0xD3, 0x39, 0xE4, 0x5C, 0x8E, 0x45, 0x3C, 0x34, 0xA0, 0x1E, 0xC5, 0xDE, 0x8E, 0xAE, 0x63,
+        0x77, 0x12, 0x1F, 0xCD, 0xB3, 0xC2, 0xC1, 0xA2, 0x08, 0xE3, 0xC1, 0xC6, 0xDC, 0xA7, 0x77, 0xAF,
+        0x61, 0x8A, 0xAA, 0x8E, 0x7B, 0xE3, 0xB8, 0xE7, 0xE5, 0xE9, 0x24, 0x8E, 0xDD, 0x75, 0xF1, 0x48,
+        0x10, 0x18, 0xA6, 0xA8, 0x53, 0x83, 0xB9, 0x1E, 0x6E, 0xDE, 0x71, 0xE3, 0x55, 0x04, 0xFE, 0xDB,
+        0x88, 0x1F, 0x1A, 0x1C, 0xF3, 0x33, 0xF2, 0x72, 0x81, 0xB2, 0x77, 0xF4, 0x8F, 0x65, 0xB1, 0xEB,
+        0xC7, 0xBB, 0x18, 0xCA, 0x58, 0x07, 0x5E, 0xA5, 0xBA, 0xEC, 0xF2, 0x43, 0xC9, 0xAF, 0x9D, 0x74,
+        0xF7, 0x58, 0xAF, 0x48, 0xB6, 0x32, 0x39, 0x79, 0x73, 0xA0, 0x4A, 0x7D, 0x71, 0x9C, 0x71, 0x39,
+        0x6E, 0xDF, 0x03, 0x6D, 0x83, 0xA8, 0x97, 0xF8, 0x17, 0xCF, 0xC6, 0x27, 0xC3, 0x0F, 0x92, 0xEE,
+        0xB9, 0x18, 0x78, 0x46, 0xF2, 0x19, 0xEF, 0x9B, 0xDB, 0x17, 0x73, 0x70, 0x31, 0xD4, 0xCF, 0xD7,
+        0xE0, 0x2F, 0xD7, 0xAD, 0xBD, 0xF6, 0x79, 0x07, 0x00, 0x00,
+    };
+    uint8_t const RUNS[] = {
+        0x4B, 0x4C, 0x1C, 0x05, 0xA3, 0x60, 0x14, 0x0C, 0x7B, 0x90, 0x34, 0x0A, 0x47, 0x21, 0xF5, 0x21,
+        0x03, 0x23, 0x13, 0x33, 0x0B, 0x2B, 0x1B, 0x3B, 0x07, 0x27, 0x17, 0x37, 0x0F, 0x2F, 0x1F, 0xBF,
+        0x80, 0xA0, 0x90, 0xB0, 0x88, 0xA8, 0x98, 0xB8, 0x84, 0xA4, 0x94, 0xB4, 0x8C, 0xAC, 0x9C, 0xBC,
+        0x82, 0xA2, 0x92, 0xB2, 0x8A, 0xAA, 0x9A, 0xBA, 0x86, 0xA6, 0x96, 0xB6, 0x8E, 0xAE, 0x9E, 0xBE,
+        0x81, 0xA1, 0x91, 0xB1, 0x89, 0xA9, 0x99, 0xB9, 0x85, 0xA5, 0x95, 0xB5, 0x8D, 0xAD, 0x9D, 0xBD,
+        0x83, 0xA3, 0x93, 0xB3, 0x8B, 0xAB, 0x9B, 0xBB, 0x87, 0xA7, 0x97, 0xB7, 0x8F, 0xAF, 0x9F, 0x7F,
+        0x40, 0x60, 0x50, 0x70, 0x48, 0x68, 0x58, 0x78, 0x44, 0x64, 0x54, 0x74, 0x4C, 0x6C, 0x5C, 0x7C,
+        0x42, 0x62, 0x52, 0x72, 0x4A, 0x6A, 0x5A, 0x7A, 0x46, 0x66, 0x56, 0x76, 0x4E, 0x6E, 0x5E, 0x7E,
+        0x41, 0x61, 0x51, 0x71, 0x49, 0x69, 0x59, 0x79, 0x45, 0x65, 0x55, 0x75, 0x4D, 0x6D, 0x5D, 0x7D,
+        0x43, 0x63, 0x53, 0x73, 0x4B, 0x6B, 0x5B, 0x7B, 0x47, 0x67, 0x57, 0x77, 0x4F, 0x6F, 0x5F, 0xFF,
+        0x84, 0x89, 0x93, 0x26, 0x4F, 0x99, 0x3A, 0x6D, 0xFA, 0x8C, 0x99, 0xB3, 0x66, 0xCF, 0x99, 0x3B,
+        0x6F, 0xFE, 0x82, 0x85, 0x8B, 0x16, 0x2F, 0x59, 0xBA, 0x6C, 0xF9, 0x8A, 0x95, 0xAB, 0x56, 0xAF,
+        0x59, 0xBB, 0x6E, 0xFD, 0x86, 0x8D, 0x9B, 0x36, 0x6F, 0xD9, 0xBA, 0x6D, 0xFB, 0x8E, 0x9D, 0xBB,
+        0x76, 0xEF, 0xD9, 0xBB, 0x6F, 0xFF, 0x81, 0x83, 0x87, 0x0E, 0x1F, 0x39, 0x7A, 0xEC, 0xF8, 0x89,
+        0x93, 0xA7, 0x4E, 0x9F, 0x39, 0x7B, 0xEE, 0xFC, 0x85, 0x8B, 0x97, 0x2E, 0x5F, 0xB9, 0x7A, 0xED,
+        0xFA, 0x8D, 0x9B, 0xB7, 0x6E, 0xDF, 0xB9, 0x7B, 0xEF, 0xFE, 0x83, 0x87, 0x8F, 0x1E, 0x3F, 0x79,
+        0xFA, 0xEC, 0xF9, 0x8B, 0x97, 0xAF, 0x5E, 0xBF, 0x79, 0xFB, 0xEE, 0xFD, 0x87, 0x8F, 0x9F, 0x3E,
+        0x7F, 0xF9, 0xFA, 0xED, 0xFB, 0x8F, 0x9F, 0xBF, 0x7E, 0xFF, 0xF9, 0xFB, 0xEF, 0xFF, 0x48, 0xF7,
+        0x3F, 0x00,
+    };
+
+    std::string as_string(std::vector<uint8_t> const& v) {
+        return std::string(v.begin(), v.end());
+    }
+
+    TEST_CASE("raw") {
+        auto const text = make_text();
+        REQUIRE(text.size() == 3913);
+
+        auto check = [](uint8_t const* in, size_t num, std::string const& expected){
+            std::vector<uint8_t> out;
+            size_t consumed;
+            CHECK(Inflate::inflate(in, num, out, &consumed) == InflateStatus::ok);
+            CHECK(consumed == num);
+            CHECK(as_string(out) == expected);
+        };
+
+        check(DYNAMIC, sizeof(DYNAMIC), text);
+        check(FIXED, sizeof(FIXED), text);
+        check(STORED, sizeof(STORED), text.substr(0, 300));
+        check(RUNS, sizeof(RUNS), make_runs());
+
+        // output is appended
+        std::vector<uint8_t> out = { 'x' };
+        CHECK(Inflate::inflate(FIXED, sizeof(FIXED), out) == InflateStatus::ok);
+        CHECK(as_string(out) == "x" + text);
+    }
+
+    TEST_CASE("zlib") {
+        std::vector<uint8_t> out;
+        size_t consumed;
+        CHECK(Inflate::zlib(ZLIB, sizeof(ZLIB), out, &consumed) == InflateStatus::ok);
+        CHECK(consumed == sizeof(ZLIB));
+        CHECK(as_string(out) == make_text());
+    }
+
+    TEST_CASE("gzip") {
+        // two members, the first of which has a file name and extra field
+        std::vector<uint8_t> out;
+        size_t consumed;
+        CHECK(Inflate::gzip(GZIP, sizeof(GZIP), out, &consumed) == InflateStatus::ok);
+        CHECK(consumed == sizeof(GZIP));
+        CHECK(as_string(out) == make_text());
+    }
+
+    TEST_CASE("errors") {
+        std::vector<uint8_t> out;
+
+        // truncated input
+        for(size_t num : { size_t(0), size_t(1), size_t(100), sizeof(DYNAMIC) - 1 }) {
+            out.clear();
+            CHECK(Inflate::inflate(DYNAMIC, num, out) == InflateStatus::truncated);
+        }
+        CHECK(Inflate::inflate(STORED, 100, out) == InflateStatus::truncated);
+        CHECK(Inflate::zlib(ZLIB, sizeof(ZLIB) - 2, out) == InflateStatus::truncated);
+        CHECK(Inflate::gzip(GZIP, 20, out) == InflateStatus::truncated);
+
+        // reserved block type
+        {
+            uint8_t const in[] = { 0b111, 0, 0 };
+            CHECK(Inflate::inflate(in, sizeof(in), out) == InflateStatus::invalid_block_type);
+        }
+
+        // stored block with mismatching length complement
+        {
+            uint8_t const in[] = { 0b001, 0x05, 0x00, 0xFA, 0xF0, 'h', 'e', 'l', 'l', 'o' };
+            CHECK(Inflate::inflate(in, sizeof(in), out) == InflateStatus::invalid_stored_length);
+        }
+
+        // a valid stored block
+        {
+            uint8_t const in[] = { 0b001, 0x05, 0x00, 0xFA, 0xFF, 'h', 'e', 'l', 'l', 'o' };
+            out.clear();
+            CHECK(Inflate::inflate(in, sizeof(in), out) == InflateStatus::ok);
+            CHECK(as_string(out) == "hello");
+        }
+
+        // fixed block referring to before the beginning of the output: length 3 (symbol 257, 0000001) with distance 1 (00000)
+        {
+            uint8_t const in[] = { 0b0'1000'0'11, 0b000'0000, 0 };
+            CHECK(Inflate::inflate(in, sizeof(in), out) == InflateStatus::invalid_distance);
+        }
+
+        // corrupted checksums
+        {
+            std::vector<uint8_t> zlib(ZLIB, ZLIB + sizeof(ZLIB));
+            zlib.back() ^= 1;
+            CHECK(Inflate::zlib(zlib.data(), zlib.size(), out) == InflateStatus::checksum_mismatch);
+
+            std::vector<uint8_t> gzip(GZIP, GZIP + sizeof(GZIP));
+            gzip.back() ^= 1;
+            CHECK(Inflate::gzip(gzip.data(), gzip.size(), out) == InflateStatus::checksum_mismatch);
+        }
+
+        // invalid headers
+        {
+            std::vector<uint8_t> zlib(ZLIB, ZLIB + sizeof(ZLIB));
+            zlib[1] ^= 1;
+            CHECK(Inflate::zlib(zlib.data(), zlib.size(), out) == InflateStatus::invalid_header);
+
+            std::vector<uint8_t> gzip(GZIP, GZIP + sizeof(GZIP));
+            gzip[0] = 0;
+            CHECK(Inflate::gzip(gzip.data(), gzip.size(), out) == InflateStatus::invalid_header);
+        }
+    }
+}
+
+}
@@ -0,0 +1,136 @@
+/**
+ * test_lz77.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/lz77.hpp>
+#include <iopp/util/bit_packer.hpp>
+#include <iopp/util/bit_unpacker.hpp>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::LZ77") {
+    std::string make_text(size_t const num_words) {
+        static char const* words[] = {
+            "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit", "vivamus", "aliquet", "in", "turpis", "vitae",
+            "mattis", "etiam", "nunc", "nibh", "ornare", "tincidunt", "quis", "iaculis", "eget", "orci", "morbi", "viverra", "maximus",
+            "quam", "vel", "feugiat"
+        };
+
+        std::string text;
+        uint64_t x = 1;
+        for(size_t i = 0; i < num_words; i++) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            if(i) text.push_back(' ');
+            text.append(words[(x >> 33) % 29]);
+        }
+        return text;
+    }
+
+    // compresses the input and returns the number of bits written after verifying the roundtrip
+    size_t roundtrip(std::string const& input, LZ77Options const& options = LZ77Options()) {
+        std::vector<uint64_t> buffer;
+        size_t bits;
+        {
+            auto sink = iopp::BitPacker(std::back_inserter(buffer));
+            LZ77::encode(sink, (uint8_t const*)input.data(), input.size(), options);
+            bits = sink.num_bits_written();
+        }
+
+        std::vector<uint8_t> decoded;
+        {
+            auto src = iopp::BitUnpacker(buffer.data());
+            LZ77::decode(src, decoded);
+        }
+        CHECK(std::string(decoded.begin(), decoded.end()) == input);
+        return bits;
+    }
+
+    TEST_CASE("roundtrip") {
+        auto const text = make_text(20'000);
+
+        std::string runs(1000, 'a');
+        for(size_t i = 0; i < 300; i++) runs.append("ab");
+
+        std::string random;
+        uint64_t x = 7;
+        for(size_t i = 0; i < 50'000; i++) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            random.push_back(char(x >> 56));
+        }
+
+        for(unsigned level = 1; level <= 9; level++) {
+            auto const options = LZ77Options::level(level);
+            roundtrip("", options);
+            roundtrip("x", options);
+            roundtrip("xyz", options);
+            roundtrip("abcabcabcabcabcabcabc", options);
+            roundtrip(runs, options);
+            roundtrip(random, options);
+
+            // repetitive text is compressed well
+            auto const bits = roundtrip(text, options);
+            CHECK(bits < text.size() * 8 / 3);
+        }
+    }
+
+    TEST_CASE("blocks") {
+        auto const text = make_text(5'000);
+
+        // small blocks require many Huffman trees, but still work
+        LZ77Options options;
+        options.block_size = 100;
+        auto const small = roundtrip(text, options);
+
+        options.block_size = 1;
+        roundtrip(text, options);
+
+        auto const large = roundtrip(text);
+        CHECK(large < small);
+    }
+
+    TEST_CASE("levels") {
+        auto const text = make_text(20'000);
+
+        LZ77Options options;
+        options.lazy = false;
+        roundtrip(text, options);
+
+        // higher levels spend more effort on finding matches and thus compress better
+        auto const fast = roundtrip(text, LZ77Options::level(1));
+        auto const best = roundtrip(text, LZ77Options::level(9));
+        CHECK(best < fast);
+    }
+}
+
+}
@@ -0,0 +1,174 @@
+/**
+ * test_mtf.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/huffman.hpp>
+#include <code/move_to_front.hpp>
+#include <code/zero_run_length.hpp>
+#include <iopp/util/bit_packer.hpp>
+#include <iopp/util/bit_unpacker.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace code::test {
+
+// a naive implementation of the move-to-front transform for reference
+std::vector<uint8_t> naive_mtf(std::vector<uint8_t> const& in) {
+    std::vector<uint8_t> list;
+    for(size_t i = 0; i < 256; i++) list.push_back(uint8_t(i));
+
+    std::vector<uint8_t> out;
+    for(auto const c : in) {
+        auto const it = std::find(list.begin(), list.end(), c);
+        out.push_back(uint8_t(it - list.begin()));
+        list.erase(it);
+        list.insert(list.begin(), c);
+    }
+    return out;
+}
+
+std::vector<uint8_t> make_input(size_t const num, size_t const sigma) {
+    std::vector<uint8_t> in;
+    uint64_t x = 1;
+    for(size_t i = 0; i < num; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        auto const r = (x >> 33) % 100;
+        in.push_back(r < 50 && !in.empty() ? in.back() : uint8_t(((x >> 40) % sigma) * 7)); // nb: many repetitions
+    }
+    return in;
+}
+
+TEST_SUITE("code::MoveToFront") {
+    TEST_CASE("example") {
+        std::vector<uint8_t> const in = { 'b', 'a', 'n', 'a', 'n', 'a', 'a', 'a' };
+        std::vector<uint8_t> out(in.size());
+
+        MoveToFront mtf;
+        mtf.encode(in.data(), in.size(), out.data());
+        CHECK(out == std::vector<uint8_t>{ 'b', 'b', 'n', 1, 1, 1, 0, 0 });
+    }
+
+    TEST_CASE("roundtrip") {
+        for(size_t sigma : { 1, 2, 10, 36, 37, 256 }) {
+            auto const in = make_input(20'000, sigma);
+            auto const expected = naive_mtf(in);
+
+            // transform at once
+            std::vector<uint8_t> out(in.size());
+            MoveToFront mtf;
+            mtf.encode(in.data(), in.size(), out.data());
+            CHECK(out == expected);
+
+            // transform in pieces
+            std::vector<uint8_t> pieces(in.size());
+            mtf.reset();
+            for(size_t i = 0; i < in.size(); i += 1000) {
+                mtf.encode(in.data() + i, std::min(size_t(1000), in.size() - i), pieces.data() + i);
+            }
+            CHECK(pieces == expected);
+
+            // inverse transform in place
+            mtf.reset();
+            mtf.decode(out.data(), out.size(), out.data());
+            CHECK(out == in);
+        }
+    }
+}
+
+TEST_SUITE("code::ZeroRunLength") {
+    auto encode(std::vector<uint8_t> const& in) {
+        std::vector<uint16_t> out;
+        ZeroRunLength::encode(in.data(), in.size(), std::back_inserter(out));
+        return out;
+    }
+
+    auto decode(std::vector<uint16_t> const& in) {
+        std::vector<uint8_t> out;
+        ZeroRunLength::decode(in.data(), in.size(), std::back_inserter(out));
+        return out;
+    }
+
+    TEST_CASE("encode") {
+        constexpr auto A = ZeroRunLength::RUNA;
+        constexpr auto B = ZeroRunLength::RUNB;
+
+        CHECK(encode({}) == std::vector<uint16_t>{});
+        CHECK(encode({ 0 }) == std::vector<uint16_t>{ A });
+        CHECK(encode({ 0, 0 }) == std::vector<uint16_t>{ B });
+        CHECK(encode({ 0, 0, 0 }) == std::vector<uint16_t>{ A, A });
+        CHECK(encode({ 0, 0, 0, 0 }) == std::vector<uint16_t>{ B, A });
+        CHECK(encode({ 0, 0, 0, 0, 0, 0, 0 }) == std::vector<uint16_t>{ A, A, A });
+        CHECK(encode({ 3, 0, 0, 0, 255, 0 }) == std::vector<uint16_t>{ 4, A, A, 256, A });
+        CHECK(encode({ 1, 2, 1 }) == std::vector<uint16_t>{ 2, 3, 2 });
+    }
+
+    TEST_CASE("roundtrip") {
+        for(size_t run = 0; run < 300; run++) {
+            std::vector<uint8_t> in(run, 0);
+            in.push_back(1);
+            in.insert(in.end(), run, 0);
+            CHECK(decode(encode(in)) == in);
+        }
+    }
+
+    TEST_CASE("pipeline") {
+        // MTF, zero run length encoding and Huffman coding
+        auto const in = make_input(50'000, 20);
+        std::vector<uint8_t> ranks(in.size());
+        MoveToFront().encode(in.data(), in.size(), ranks.data());
+        auto const symbols = encode(ranks);
+        CHECK(symbols.size() < in.size());
+
+        std::vector<uint64_t> buffer;
+        {
+            auto sink = iopp::BitPacker(std::back_inserter(buffer));
+            HuffmanTree<uint16_t> tree(symbols.begin(), symbols.end());
+            tree.encode(sink);
+
+            auto const table = tree.table();
+            for(auto const x : symbols) Huffman::encode(sink, x, table);
+        }
+
+        std::vector<uint16_t> decoded_symbols;
+        {
+            auto src = iopp::BitUnpacker(buffer.data());
+            HuffmanTree<uint16_t> tree(src);
+            for(size_t i = 0; i < symbols.size(); i++) decoded_symbols.push_back(uint16_t(Huffman::decode(src, tree.root())));
+        }
+
+        auto out = decode(decoded_symbols);
+        MoveToFront().decode(out.data(), out.size(), out.data());
+        CHECK(out == in);
+    }
+}
+
+}
@@ -0,0 +1,163 @@
+/**
+ * test_posting_list.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/posting_list.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace code::test {
+
+std::vector<uint32_t> random_list(size_t n, uint32_t universe, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::set<uint32_t> values;
+    while(values.size() < std::min(n, size_t(universe))) values.insert(gen() % universe);
+    return std::vector<uint32_t>(values.begin(), values.end());
+}
+
+constexpr PostingCodec CODECS[] = { PostingCodec::bit_packing, PostingCodec::rice, PostingCodec::vbyte };
+
+TEST_SUITE("code::PostingList") {
+    TEST_CASE("decode") {
+        for(auto const codec : CODECS) {
+            for(size_t n : {0, 1, 127, 128, 129, 5000}) {
+                auto values = random_list(n, 1'000'000, n);
+                if(n == 1) values = { PostingList::END - 1 };
+
+                PostingList list(values.begin(), values.end(), codec);
+                CHECK(list.size() == values.size());
+                CHECK(list.codec() == codec);
+
+                std::vector<uint32_t> decoded;
+                list.decode(std::back_inserter(decoded));
+                CHECK(decoded == values);
+
+                // iterate using a cursor
+                decoded.clear();
+                for(auto c = list.cursor(); !c.end(); c.next()) decoded.push_back(c.value());
+                CHECK(decoded == values);
+            }
+        }
+    }
+
+    TEST_CASE("next_geq") {
+        auto const values = random_list(10'000, 200'000, 147);
+        for(auto const codec : CODECS) {
+            PostingList list(values.begin(), values.end(), codec, 64);
+
+            std::mt19937 gen(147);
+            auto c = list.cursor();
+            uint32_t x = 0;
+            bool ok = true;
+            while(true) {
+                x += gen() % 200;
+                auto const it = std::lower_bound(values.begin(), values.end(), x);
+                auto const expected = it == values.end() ? PostingList::END : *it;
+                ok = ok && c.next_geq(x) == expected;
+                if(expected == PostingList::END) break;
+            }
+            CHECK(ok);
+            CHECK(c.end());
+        }
+    }
+
+    TEST_CASE("intersect") {
+        for(auto const codec : CODECS) {
+            for(auto const& [na, nb] : {std::pair{0, 100}, {1, 1}, {1000, 1000}, {20'000, 300}, {50, 20'000}, {20'000, 20'000}}) {
+                auto const va = random_list(na, 100'000, na + 1);
+                auto const vb = random_list(nb, 100'000, nb + 2);
+                PostingList a(va.begin(), va.end(), codec);
+                PostingList b(vb.begin(), vb.end(), codec, 32);
+
+                std::vector<uint32_t> expected;
+                std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+
+                std::vector<uint32_t> result;
+                CHECK(PostingList::intersect(a, b, std::back_inserter(result)) == expected.size());
+                CHECK(result == expected);
+
+                result.clear();
+                PostingList::intersect(b, a, std::back_inserter(result));
+                CHECK(result == expected);
+            }
+        }
+    }
+
+    TEST_CASE("intersect_clustered") {
+        // lists consisting of disjoint ranges, so most blocks are skipped
+        std::vector<uint32_t> va, vb;
+        for(uint32_t r = 0; r < 100; r++) {
+            for(uint32_t x = 0; x < 500; x++) (r % 2 ? va : vb).push_back(r * 1000 + x);
+            if(r % 10 == 0) for(uint32_t x = 600; x < 700; x += 3) { va.push_back(r * 1000 + x); vb.push_back(r * 1000 + x); }
+        }
+        std::sort(va.begin(), va.end());
+        std::sort(vb.begin(), vb.end());
+
+        std::vector<uint32_t> expected;
+        std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+
+        PostingList a(va.begin(), va.end());
+        PostingList b(vb.begin(), vb.end());
+        std::vector<uint32_t> result;
+        PostingList::intersect(a, b, std::back_inserter(result));
+        CHECK(result == expected);
+    }
+
+    TEST_CASE("unite") {
+        for(auto const codec : CODECS) {
+            for(auto const& [na, nb] : {std::pair{0, 0}, {0, 100}, {1000, 1000}, {20'000, 300}}) {
+                auto const va = random_list(na, 100'000, na + 1);
+                auto const vb = random_list(nb, 100'000, nb + 2);
+                PostingList a(va.begin(), va.end(), codec);
+                PostingList b(vb.begin(), vb.end(), codec);
+
+                std::vector<uint32_t> expected;
+                std::set_union(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+
+                std::vector<uint32_t> result;
+                CHECK(PostingList::unite(a, b, std::back_inserter(result)) == expected.size());
+                CHECK(result == expected);
+            }
+        }
+    }
+
+    TEST_CASE("compression") {
+        auto const values = random_list(100'000, 10'000'000, 147);
+        for(auto const codec : CODECS) {
+            PostingList list(values.begin(), values.end(), codec);
+            CHECK(list.size_in_bits() < 16 * values.size());
+        }
+    }
+}
+
+}
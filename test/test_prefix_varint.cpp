@@ -0,0 +1,101 @@
+/**
+ * test_prefix_varint.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/prefix_varint.hpp>
+
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::PrefixVarint") {
+    TEST_CASE("layout") {
+        auto codeword_of = [](uint64_t x){
+            uint8_t buf[PrefixVarint::MAX_LENGTH];
+            auto const end = PrefixVarint::encode(buf, x);
+            CHECK(size_t(end - buf) == PrefixVarint::length(x));
+            CHECK(PrefixVarint::length_of(buf[0]) == PrefixVarint::length(x));
+            return std::vector<uint8_t>(buf, end);
+        };
+
+        CHECK(codeword_of(0) == std::vector<uint8_t>{0x80});
+        CHECK(codeword_of(127) == std::vector<uint8_t>{0xFF});
+        CHECK(codeword_of(128) == std::vector<uint8_t>{0x40, 0x80});
+        CHECK(codeword_of(0x3FFF) == std::vector<uint8_t>{0x7F, 0xFF});
+        CHECK(codeword_of(0x4000) == std::vector<uint8_t>{0x20, 0x40, 0x00});
+        CHECK(codeword_of((uint64_t(1) << 56) - 1) == std::vector<uint8_t>{0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+        CHECK(codeword_of(uint64_t(1) << 56) == std::vector<uint8_t>{0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+        CHECK(codeword_of(UINT64_MAX) == std::vector<uint8_t>{0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+    }
+
+    TEST_CASE("roundtrip") {
+        std::vector<uint64_t> values;
+        for(uint64_t x = 0; x < 20'000; x++) values.push_back(x);
+        for(size_t k = 1; k <= 64; k++) {
+            auto const x = (k == 64) ? UINT64_MAX : (uint64_t(1) << k);
+            values.push_back(x - 1);
+            values.push_back(x);
+        }
+        std::mt19937_64 gen(147);
+        for(size_t i = 0; i < 10'000; i++) values.push_back(gen() >> (gen() % 64));
+
+        size_t total = 0;
+        for(auto const x : values) total += PrefixVarint::length(x);
+
+        // no padding, so out-of-bounds reads are detected by sanitizers
+        std::vector<uint8_t> buffer(total);
+        CHECK(PrefixVarint::encode_bulk(buffer.data(), values.begin(), values.end()) == buffer.data() + total);
+
+        // decode one by one without reading beyond the input
+        {
+            uint8_t const* in = buffer.data();
+            for(auto const x : values) CHECK(PrefixVarint::decode_safe(in) == x);
+            CHECK(in == buffer.data() + total);
+        }
+
+        // decode in bulk
+        {
+            std::vector<uint64_t> out;
+            auto const end = PrefixVarint::decode_bulk(buffer.data(), std::back_inserter(out), values.size(), buffer.size());
+            CHECK(end == buffer.data() + total);
+            CHECK(out == values);
+        }
+
+        // decode one by one using the fast decoder on a padded buffer
+        {
+            buffer.resize(total + PrefixVarint::PADDING);
+            uint8_t const* in = buffer.data();
+            for(auto const x : values) CHECK(PrefixVarint::decode(in) == x);
+            CHECK(in == buffer.data() + total);
+        }
+    }
+}
+
+}
@@ -29,8 +29,12 @@
 #include "doctest.h"
 
 #include <code/rice.hpp>
+#include <code/internal/bit_buffer.hpp>
 #include "helpers.hpp"
 
+#include <random>
+#include <vector>
+
 namespace code::test {
 
 TEST_SUITE("code::Rice") {
@@ -73,6 +77,53 @@ TEST_SUITE("code::Rice") {
         { SimpleUint64BitSource src(0b111111'0'01); CHECK(Rice::decode(src, 6) == 127); }
         // ...
     }
+
+    TEST_CASE("encode_bulk") {
+        std::vector<uint64_t> values;
+        for(uint64_t x = 0; x < 1'000; x++) values.push_back(x);
+
+        std::mt19937_64 gen(147);
+        for(size_t i = 0; i < 10'000; i++) values.push_back(gen() >> (gen() % 64));
+        for(size_t k = 1; k < 64; k++) values.push_back(uint64_t(1) << k);
+        values.push_back(UINT64_MAX); // nb: requires p > 0
+        std::vector<uint32_t> values32;
+        for(auto const x : values) values32.push_back(uint32_t(x));
+
+        for(uint8_t p : {1, 5, 17, 40, 63}) {
+            BitVectorSink expected, expected32;
+            for(auto const x : values) Rice::encode(expected, x, p);
+            for(auto const x : values32) Rice::encode(expected32, x, p);
+
+            BitVectorSink bulk, bulk32;
+            Rice::encode_bulk(bulk, values.data(), values.size(), p);
+            Rice::encode_bulk(bulk32, values32.data(), values32.size(), p);
+            CHECK(bulk.bits == expected.bits);
+            CHECK(bulk32.bits == expected32.bits);
+        }
+    }
+
+    TEST_CASE("optimal_exponent") {
+        auto size_of = [](std::vector<uint64_t> const& values, uint8_t p){
+            internal::BitCounter counter;
+            for(auto const x : values) Rice::encode(counter, x, p);
+            return counter.num_bits_written();
+        };
+
+        std::mt19937_64 gen(148);
+        for(double mean : {0.5, 3.0, 100.0, 1e6, 1e15}) {
+            std::geometric_distribution<uint64_t> dist(1.0 / (mean + 1));
+            std::vector<uint64_t> values;
+            for(size_t i = 0; i < 1'000; i++) values.push_back(dist(gen));
+
+            size_t best = SIZE_MAX;
+            for(uint8_t p = 0; p < 64; p++) best = std::min(best, size_of(values, p));
+            CHECK(size_of(values, Rice::optimal_exponent(values.data(), values.size())) == best);
+        }
+
+        std::vector<uint32_t> values32(100, UINT32_MAX);
+        CHECK(Rice::optimal_exponent(values32.data(), values32.size()) == 31); // nb: does not exceed the integer width
+        CHECK(Rice::optimal_exponent(values32.data(), 0) == 0);
+    }
 }
 
 }
@@ -0,0 +1,105 @@
+/**
+ * test_rrr_vector.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/rrr_vector.hpp>
+
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+template<size_t BlockSize, size_t SuperblockSize>
+void test_rrr(std::vector<bool> const& bits) {
+    RRRVector<BlockSize, SuperblockSize> rrr(bits.begin(), bits.end());
+    REQUIRE(rrr.size() == bits.size());
+
+    size_t ones = 0;
+    bool ok = true;
+    for(size_t i = 0; i < bits.size(); i++) {
+        ok = ok && rrr.rank1(i) == ones && rrr.rank0(i) == i - ones && rrr[i] == bits[i];
+        ones += bits[i];
+    }
+    ok = ok && rrr.rank1(bits.size()) == ones;
+    CHECK(ok);
+    CHECK(rrr.num_ones() == ones);
+
+    size_t k1 = 0, k0 = 0;
+    for(size_t i = 0; i < bits.size(); i++) {
+        if(bits[i]) ok = ok && rrr.select1(++k1) == i;
+        else ok = ok && rrr.select0(++k0) == i;
+    }
+    CHECK(ok);
+}
+
+std::vector<bool> random_bits(size_t n, double density, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::bernoulli_distribution dist(density);
+    std::vector<bool> bits(n);
+    for(size_t i = 0; i < n; i++) bits[i] = dist(gen);
+    return bits;
+}
+
+TEST_SUITE("code::RRRVector") {
+    TEST_CASE("queries") {
+        for(size_t n : {0, 1, 14, 15, 16, 480, 1000, 30'000}) {
+            for(double density : {0.0, 0.01, 0.5, 0.95, 1.0}) {
+                auto const bits = random_bits(n, density, n);
+                test_rrr<15, 32>(bits);
+                test_rrr<7, 3>(bits);
+                test_rrr<63, 8>(bits);
+            }
+        }
+    }
+
+    TEST_CASE("runs") {
+        // long runs of set and unset bits make all blocks but a few uniform
+        std::vector<bool> bits;
+        for(size_t run = 1; run < 300; run++) bits.insert(bits.end(), run * 37, run % 2);
+        test_rrr<15, 32>(bits);
+        test_rrr<31, 16>(bits);
+    }
+
+    TEST_CASE("empty") {
+        RRRVector<> rrr;
+        CHECK(rrr.size() == 0);
+        CHECK(rrr.rank1(0) == 0);
+    }
+
+    TEST_CASE("compression") {
+        auto const bits = random_bits(300'000, 0.01, 147);
+        RRRVector<> rrr(bits.begin(), bits.end());
+        CHECK(rrr.size_in_bits() < bits.size() / 2);
+
+        RRRVector<63, 8> rrr63(bits.begin(), bits.end());
+        CHECK(rrr63.size_in_bits() < rrr.size_in_bits());
+    }
+}
+
+}
@@ -0,0 +1,171 @@
+/**
+ * test_tunstall.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/tunstall.hpp>
+#include <iopp/util/bit_packer.hpp>
+#include <iopp/util/bit_unpacker.hpp>
+#include "helpers.hpp"
+
+namespace code::test {
+
+TEST_SUITE("code::Tunstall") {
+    TEST_CASE("TunstallDictionary") {
+        // a:3, b:1 -- with 2-bit codewords, "a" and then "aa" get expanded
+        std::string s = "aaab";
+        Counter<char> histogram(s.begin(), s.end());
+        TunstallDictionary<char> dict(histogram, 2);
+        CHECK(dict.size() == 4);
+        CHECK(dict.max_length() == 3);
+
+        auto str = [&](uint32_t code){ return std::string(dict.string(code), dict.length(code)); };
+        CHECK(str(0) == "aaa");
+        CHECK(str(1) == "aab");
+        CHECK(str(2) == "ab");
+        CHECK(str(3) == "b");
+
+        SUBCASE("Encoding") {
+            uint64_t out[8];
+            {
+                auto sink = iopp::BitPacker(out);
+                dict.encode(sink);
+            }
+            {
+                auto src = iopp::BitUnpacker(out);
+                TunstallDictionary<char> decoded_dict(src);
+                CHECK(decoded_dict.bits() == 2);
+                CHECK(decoded_dict.size() == 4);
+                for(uint32_t code = 0; code < 4; code++) {
+                    CHECK(std::string(decoded_dict.string(code), decoded_dict.length(code)) == str(code));
+                }
+            }
+        }
+    }
+
+    std::string lorem_ipsum = 
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Vivamus aliquet in turpis vitae mattis. "
+        "Etiam nunc nibh, ornare in tincidunt quis, iaculis eget orci. Morbi viverra maximus quam vel feugiat. "
+        "Nulla est augue, vehicula eu ante non, dapibus dignissim purus. Donec at viverra est. Sed a rhoncus lectus. "
+        "Maecenas a purus nisi. Donec aliquet dignissim tempor. Donec interdum pulvinar massa, sit amet finibus ante volutpat aliquet. "
+        "Aliquam eget purus sed ex ornare imperdiet vel in lorem. Cras accumsan egestas malesuada. "
+        "Phasellus mauris eros, congue non feugiat porttitor, commodo at quam. Vestibulum cursus enim ullamcorper tristique mattis.";
+
+    TEST_CASE("roundtrip") {
+        Counter<char> histogram(lorem_ipsum.begin(), lorem_ipsum.end());
+        for(size_t bits : { 6, 8, 12, 16 }) {
+            std::vector<uintmax_t> out(4096); // "large enough"
+            {
+                TunstallDictionary<char> dict(histogram, bits);
+                CHECK(dict.size() <= (size_t(1) << bits));
+
+                auto sink = iopp::BitPacker(out.data());
+                dict.encode(sink);
+                Tunstall::encode(sink, lorem_ipsum.begin(), lorem_ipsum.end(), dict);
+            }
+            {
+                auto src = iopp::BitUnpacker(out.data());
+                TunstallDictionary<char> dict(src);
+
+                std::string decoded(lorem_ipsum.length(), 0);
+                Tunstall::decode(src, decoded.data(), decoded.length(), dict);
+                CHECK(decoded == lorem_ipsum);
+            }
+        }
+    }
+
+    TEST_CASE("max_bits") {
+        // nb: bounding the string length keeps the parse tree small despite the codeword width
+        Counter<char> histogram(lorem_ipsum.begin(), lorem_ipsum.end());
+        auto const bits = TunstallDictionary<char>::MAX_BITS;
+
+        std::vector<uintmax_t> out(8192); // "large enough"
+        {
+            TunstallDictionary<char> dict(histogram, bits, 3);
+            CHECK(dict.bits() == bits);
+            CHECK(dict.max_length() == 3);
+            CHECK(dict.size() == dict.alphabet().size() * dict.alphabet().size() * dict.alphabet().size());
+
+            auto sink = iopp::BitPacker(out.data());
+            dict.encode(sink);
+            Tunstall::encode(sink, lorem_ipsum.begin(), lorem_ipsum.end(), dict);
+        }
+        {
+            auto src = iopp::BitUnpacker(out.data());
+            TunstallDictionary<char> dict(src);
+            CHECK(dict.bits() == bits);
+
+            std::string decoded(lorem_ipsum.length(), 0);
+            Tunstall::decode(src, decoded.data(), decoded.length(), dict);
+            CHECK(decoded == lorem_ipsum);
+        }
+    }
+
+    TEST_CASE("roundtrip_16bit") {
+        std::vector<uint16_t> input;
+        for(size_t i = 0; i < 5000; i++) input.push_back(1000 + (i % 7) * (i % 11));
+
+        Counter<uint16_t> histogram(input.begin(), input.end());
+        TunstallDictionary<uint16_t> dict(histogram, 12, 8);
+        CHECK(dict.max_length() <= 8);
+
+        std::vector<uintmax_t> out(input.size());
+        {
+            auto sink = iopp::BitPacker(out.data());
+            Tunstall::encode(sink, input.begin(), input.end(), dict);
+        }
+        {
+            auto src = iopp::BitUnpacker(out.data());
+            std::vector<uint16_t> decoded(input.size());
+            Tunstall::decode(src, decoded.data(), decoded.size(), dict);
+            CHECK(decoded == input);
+        }
+    }
+
+    TEST_CASE("single_character") {
+        std::string s(100, 'x');
+        Counter<char> histogram(s.begin(), s.end());
+        TunstallDictionary<char> dict(histogram, 4);
+        CHECK(dict.alphabet().size() == 2);
+        CHECK(dict.max_length() == 15); // nb: each expansion adds only one leaf
+
+        uintmax_t out[8];
+        {
+            auto sink = iopp::BitPacker(out);
+            Tunstall::encode(sink, s.begin(), s.end(), dict);
+        }
+        {
+            auto src = iopp::BitUnpacker(out);
+            std::string decoded(s.length(), 0);
+            Tunstall::decode(src, decoded.data(), decoded.length(), dict);
+            CHECK(decoded == s);
+        }
+    }
+}
+
+}
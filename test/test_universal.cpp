@@ -29,10 +29,13 @@
 #include "doctest.h"
 
 #include <code.hpp>
+#include <code/internal/bit_buffer.hpp>
 #include <iopp/util/bit_packer.hpp>
 #include <iopp/util/bit_unpacker.hpp>
 #include "helpers.hpp"
 
+#include <random>
+
 namespace code::test {
 
 TEST_SUITE("code::Universal") {
@@ -127,6 +130,61 @@ TEST_SUITE("code::Universal") {
             run_for(coder, coder);
         }
     }
+
+    #ifdef CODE_HAS_UINT128
+    TEST_CASE("128-bit integers") {
+        std::mt19937_64 gen(100);
+        std::vector<uint128_t> input;
+        for(size_t i = 0; i < 1'000; i++) {
+            auto const x = ((uint128_t(gen()) << 64) | gen()) >> (gen() % 128);
+            input.push_back(x ? x : 1);
+        }
+        input.push_back(~uint128_t(0));
+
+        auto const umax = BasicUniverse<uint128_t>::umax();
+
+        std::vector<uint64_t> words;
+        {
+            internal::BitBufferSink sink(words);
+            for(auto const x : input) {
+                Binary::encode(sink, x, umax);
+                EliasGamma::encode(sink, x);
+                EliasDelta::encode(sink, x);
+                Rice::encode(sink, x, 70);
+                Vbyte::encode(sink, x, 7);
+                Vbyte(100).encode(sink, x, umax);
+            }
+            EliasGamma::encode_bulk(sink, input.data(), input.size());
+        }
+
+        internal::BitBufferSource src(words.data());
+        for(auto const x : input) {
+            CHECK(Binary::decode(src, umax) == x);
+            CHECK(EliasGamma::decode<uint128_t>(src) == x);
+            CHECK(EliasDelta::decode<uint128_t>(src) == x);
+            CHECK(Rice::decode<uint128_t>(src, 70) == x);
+            CHECK(Vbyte::decode<uint128_t>(src, 7) == x);
+            CHECK(Vbyte(100).decode(src, umax) == x);
+        }
+        for(auto const x : input) CHECK(EliasGamma::decode<uint128_t>(src) == x);
+    }
+
+    TEST_CASE("128-bit compatibility") {
+        // the codewords of integers that fit into 64 bits are the same, and UINTMAX_MAX can be encoded using a 128-bit universe
+        auto const u = BasicUniverse<uint128_t>::of<uint64_t>();
+
+        std::vector<uint64_t> words;
+        {
+            internal::BitBufferSink sink(words);
+            EliasGamma::encode(sink, uint128_t(12345));
+            EliasDelta::encode(sink, UINT64_MAX, u);
+        }
+
+        internal::BitBufferSource src(words.data());
+        CHECK(EliasGamma::decode(src) == 12345);
+        CHECK(EliasDelta::decode(src, u) == UINT64_MAX);
+    }
+    #endif
 }
 
 }
@@ -66,6 +66,30 @@ TEST_SUITE("code::Universe") {
         CHECK(u.abs(1) == u.min() + 1);
         CHECK(u.abs(u.delta()) == u.max());
     }
+
+    #ifdef CODE_HAS_UINT128
+    TEST_CASE("128-bit") {
+        using Universe128 = BasicUniverse<uint128_t>;
+        CHECK(Universe128::umax().entropy() == 128);
+        CHECK(Universe128::of<uint64_t>().entropy() == 64);
+        CHECK(Universe128::with_entropy(100).max() == (uint128_t(1) << 100) - 1);
+
+        Universe128 const u(uint128_t(1) << 70, (uint128_t(1) << 70) + 1000);
+        CHECK(u.entropy() == 10);
+        CHECK(u.rel(u.max()) == 1000);
+
+        // narrower universes are converted implicitly
+        Universe128 const v = Universe(5, 17);
+        CHECK(v.min() == 5);
+        CHECK(v.max() == 17);
+        CHECK(v.entropy() == 4);
+
+        BasicRange<uint128_t> r;
+        r.contain(uint128_t(1) << 90);
+        r.contain(uint64_t(3));
+        CHECK(Universe128(r).entropy() == 90); // nb: the delta is 2^90 - 3
+    }
+    #endif
 }
 
 }
@@ -0,0 +1,133 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/webgraph.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+using Graph = std::vector<std::vector<uint64_t>>;
+
+void test_webgraph(Graph const& graph, WebGraphOptions const& options) {
+    WebGraph wg(graph.size(), [&](uint64_t x) -> std::vector<uint64_t> const& { return graph[x]; }, options);
+    REQUIRE(wg.num_nodes() == graph.size());
+
+    size_t num_edges = 0;
+    for(uint64_t x = 0; x < graph.size(); x++) {
+        CHECK(wg.outdegree(x) == graph[x].size());
+        CHECK(wg.successors(x) == graph[x]);
+        num_edges += graph[x].size();
+    }
+    CHECK(wg.num_edges() == num_edges);
+}
+
+// generates a graph with locality and similar successor lists of nearby nodes, like a web graph
+Graph clustered_graph(size_t n, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    Graph graph(n);
+    for(uint64_t x = 0; x < n; x++) {
+        auto& succ = graph[x];
+        if(x > 0 && gen() % 2) {
+            // copy most of a previous list
+            auto const& ref = graph[x - 1 - gen() % std::min(x, uint64_t(5))];
+            for(auto const y : ref) if(gen() % 8) succ.push_back(y);
+        }
+        if(gen() % 4 == 0) {
+            // add an interval
+            auto const left = (x + gen() % 100) % n;
+            auto const len = gen() % 20;
+            for(uint64_t y = left; y < std::min(left + len, uint64_t(n)); y++) succ.push_back(y);
+        }
+        auto const num_random = gen() % 8;
+        for(size_t i = 0; i < num_random; i++) {
+            // mostly local, sometimes far away
+            succ.push_back(gen() % 4 ? (x + n - 50 + gen() % 100) % n : gen() % n);
+        }
+        std::sort(succ.begin(), succ.end());
+        succ.erase(std::unique(succ.begin(), succ.end()), succ.end());
+    }
+    return graph;
+}
+
+TEST_SUITE("code::WebGraph") {
+    TEST_CASE("empty") {
+        test_webgraph(Graph(), WebGraphOptions());
+        test_webgraph(Graph(10), WebGraphOptions());
+    }
+
+    TEST_CASE("small") {
+        Graph graph = {
+            {1, 2, 3, 4, 5, 9},
+            {0, 2, 3, 4, 5, 9, 11},
+            {},
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11},
+            {3},
+            {0, 4, 5, 6, 7, 8, 11},
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11},
+            {2, 3, 4, 5, 9},
+            {1, 11},
+            {},
+            {0},
+            {10, 11},
+        };
+        test_webgraph(graph, WebGraphOptions());
+        test_webgraph(graph, WebGraphOptions{ .window = 0 });
+        test_webgraph(graph, WebGraphOptions{ .min_interval = 0 });
+        test_webgraph(graph, WebGraphOptions{ .window = 1, .max_ref_chain = 100, .min_interval = 2, .zeta_k = 1 });
+    }
+
+    TEST_CASE("clustered") {
+        auto const graph = clustered_graph(5'000, 92);
+        test_webgraph(graph, WebGraphOptions());
+        test_webgraph(graph, WebGraphOptions{ .window = 0, .min_interval = 0 });
+        test_webgraph(graph, WebGraphOptions{ .window = 3, .max_ref_chain = 1, .min_interval = 3, .zeta_k = 2 });
+        test_webgraph(graph, WebGraphOptions{ .window = 16, .max_ref_chain = 64 });
+    }
+
+    TEST_CASE("compression") {
+        auto const graph = clustered_graph(20'000, 93);
+        size_t num_edges = 0;
+        for(auto const& succ : graph) num_edges += succ.size();
+
+        auto size_with = [&](WebGraphOptions const& options){
+            return WebGraph(graph.size(), [&](uint64_t x) -> std::vector<uint64_t> const& { return graph[x]; }, options).size_in_bits();
+        };
+
+        auto const plain = size_with(WebGraphOptions{ .window = 0, .min_interval = 0 });
+        auto const full = size_with(WebGraphOptions());
+        CHECK(full < plain); // references and intervals pay off on similar lists
+        CHECK(full < 32 * num_edges);
+    }
+}
+
+}
@@ -0,0 +1,106 @@
+/**
+ * test_huffman.cpp
+ * part of pdinklag/code
+ * 
+ * MIT License
+ * 
+ * Copyright (c) Patrick Dinklage
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <code/elias_gamma.hpp>
+#include <code/zeta.hpp>
+#include <code/internal/bit_buffer.hpp>
+#include "helpers.hpp"
+
+#include <random>
+#include <vector>
+
+namespace code::test {
+
+TEST_SUITE("code::Zeta") {
+    TEST_CASE("encode") {
+        auto zeta_of = [](uint64_t v, uint8_t k){
+            SimpleUint64BitSink sink;
+            Zeta::encode(sink, v, k);
+            return sink.value;
+        };
+
+        CHECK(zeta_of(1, 1) == 0b0); // unary(0)
+        CHECK(zeta_of(2, 1) == 0b0'01); // unary(1) + 0
+        CHECK(zeta_of(3, 1) == 0b1'01); // unary(1) + 1
+        CHECK(zeta_of(4, 1) == 0b0'0'011); // unary(2) + 00
+        CHECK(zeta_of(1, 2) == 0b0'0); // unary(0) + minimal binary 0 of 3
+        CHECK(zeta_of(2, 2) == 0b0'1'0); // unary(0) + minimal binary 1 of 3
+        CHECK(zeta_of(3, 2) == 0b1'1'0); // unary(0) + minimal binary 2 of 3
+        CHECK(zeta_of(4, 2) == 0b000'01); // unary(1) + minimal binary 0 of 12
+        CHECK(zeta_of(7, 2) == 0b011'01); // unary(1) + minimal binary 3 of 12
+        CHECK(zeta_of(8, 2) == 0b0'100'01); // unary(1) + minimal binary 4 of 12
+    }
+
+    TEST_CASE("gamma_lengths") {
+        for(uint64_t x = 1; x < 10'000; x++) {
+            BitVectorSink zeta, gamma;
+            Zeta::encode(zeta, x, 1);
+            EliasGamma::encode(gamma, x);
+            CHECK(zeta.bits.size() == gamma.bits.size());
+        }
+    }
+
+    TEST_CASE("roundtrip") {
+        std::vector<uint64_t> values;
+        for(uint64_t x = 1; x < 1'000; x++) values.push_back(x);
+
+        std::mt19937_64 gen(92);
+        for(size_t i = 0; i < 10'000; i++) values.push_back(std::max(uint64_t(1), gen() >> (gen() % 64)));
+        for(size_t k = 0; k < 64; k++) values.push_back(uint64_t(1) << k);
+        values.push_back(UINT64_MAX);
+
+        for(uint8_t k = 1; k <= 64; k++) {
+            std::vector<uint64_t> buffer;
+            {
+                internal::BitBufferSink sink(buffer);
+                for(auto const x : values) Zeta::encode(sink, x, k);
+            }
+
+            internal::BitBufferSource src(buffer.data());
+            for(auto const x : values) CHECK(Zeta::decode(src, k) == x);
+        }
+    }
+
+    TEST_CASE("universe") {
+        auto const u = Universe(100, 1'000);
+        Zeta zeta(3);
+
+        std::vector<uint64_t> buffer;
+        {
+            internal::BitBufferSink sink(buffer);
+            for(uint64_t x = 100; x <= 1'000; x++) zeta.encode(sink, x, u);
+        }
+
+        internal::BitBufferSource src(buffer.data());
+        for(uint64_t x = 100; x <= 1'000; x++) CHECK(zeta.decode(src, u) == x);
+    }
+}
+
+}